@@ -20,6 +20,9 @@ DRV8825::DRV8825(PumpStepMode mode, bool sleeping, float frequency) : pca9685{Pc
     }
     pca9685.setPWMChannelAlwaysOn(Reset, 0);
 
+    if (auto initialized = ina.init(); not initialized) {
+        LOG_ERROR << "Pump current monitor failed to initialize";
+    }
 
 }
 
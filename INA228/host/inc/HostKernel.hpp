@@ -0,0 +1,162 @@
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <utility>
+
+/**
+ * The virtual time base of the host build, standing in for the FreeRTOS scheduler and the interrupt controller.
+ *
+ * @brief The host build runs a single task. The peripheral models schedule their interrupts as events at a virtual
+ * time, and the blocking FreeRTOS calls of the task process these events until the task is woken or the timeout
+ * expires. The time only advances in the blocking calls, so a run is deterministic, independent of the host speed,
+ * and the code between two blocking calls takes no virtual time.
+ *
+ * The kernel starts in the state before vTaskStartScheduler(): as on the Cortex-M7 port, where the first critical
+ * section leaves BASEPRI raised until the scheduler starts, a critical section entered before startScheduler() masks
+ * the interrupts, and the events stay pending until the scheduler is started. Blocking before the scheduler is
+ * started fails a configASSERT instead of hanging.
+ */
+class HostKernel {
+public:
+    /**
+     * The identifier of a scheduled event, used to cancel it.
+     */
+    using EventId = uint64_t;
+
+    /**
+     * The virtual time, in microseconds, used as a deadline that never expires.
+     */
+    static constexpr uint64_t Never = UINT64_MAX;
+
+    /**
+     * Function that returns the kernel of the host build.
+     */
+    static HostKernel &instance();
+
+    /**
+     * Function that starts the scheduler, unmasking the interrupts masked by the critical sections entered before.
+     */
+    void startScheduler() {
+        schedulerStarted = true;
+        interruptsMasked = false;
+    }
+
+    /**
+     * Function that returns true once the scheduler is started.
+     */
+    [[nodiscard]] bool isSchedulerStarted() const {
+        return schedulerStarted;
+    }
+
+    /**
+     * Function that masks the interrupts on the entry of a critical section.
+     */
+    void maskInterrupts() {
+        interruptsMasked = true;
+    }
+
+    /**
+     * Function that unmasks the interrupts on the exit of the outermost critical section. Before the scheduler is
+     * started, the interrupts stay masked.
+     */
+    void unmaskInterrupts() {
+        interruptsMasked = not schedulerStarted;
+    }
+
+    /**
+     * Function that returns the current virtual time.
+     * @return The time since the start of the run (in microseconds).
+     */
+    [[nodiscard]] uint64_t getTimeMicroSeconds() const {
+        return timeMicroSeconds;
+    }
+
+    /**
+     * Function that schedules an event, called in interrupt context when the virtual time reaches it.
+     * @param delayMicroSeconds The time from now to the event (in microseconds).
+     * @param handler The function called at the event.
+     * @return The identifier of the event.
+     */
+    EventId schedule(uint64_t delayMicroSeconds, std::function<void()> handler);
+
+    /**
+     * Function that cancels a scheduled event. Cancelling an event that already happened has no effect.
+     * @param eventId The identifier of the event.
+     */
+    void cancel(EventId eventId);
+
+    /**
+     * Function that advances the virtual time, processing all the events up to the new time, unless the interrupts
+     * are masked.
+     * @param microSeconds The time to advance (in microseconds).
+     */
+    void advance(uint64_t microSeconds);
+
+    /**
+     * Function that processes the events in order until the condition is met or the deadline is reached.
+     * @param condition The condition, checked before each event.
+     * @param deadlineMicroSeconds The virtual time of the deadline, or Never.
+     * @return True if the condition is met, false on the deadline or if no event is left to wake the task.
+     */
+    bool runUntil(const std::function<bool()> &condition, uint64_t deadlineMicroSeconds);
+
+    /**
+     * Function that converts a FreeRTOS timeout to the virtual time of its deadline.
+     * @param ticks The timeout (in ticks), or portMAX_DELAY.
+     * @return The deadline (in microseconds), or Never.
+     */
+    [[nodiscard]] uint64_t getDeadline(uint32_t ticks) const;
+
+    /**
+     * Function that returns the number of events processed since the start of the run.
+     */
+    [[nodiscard]] uint64_t getProcessedEvents() const {
+        return processedEvents;
+    }
+
+    /**
+     * The length of a tick (in microseconds), for configTICK_RATE_HZ = 1000.
+     */
+    static constexpr uint64_t TickMicroSeconds = 1000;
+
+private:
+    /**
+     * The events, ordered by time and then by scheduling order.
+     */
+    std::map<std::pair<uint64_t, EventId>, std::function<void()>> events;
+
+    /**
+     * The current virtual time (in microseconds).
+     */
+    uint64_t timeMicroSeconds = 0;
+
+    /**
+     * The identifier of the next scheduled event.
+     */
+    EventId nextEventId = 0;
+
+    /**
+     * The number of processed events.
+     */
+    uint64_t processedEvents = 0;
+
+    /**
+     * True once the scheduler is started.
+     */
+    bool schedulerStarted = false;
+
+    /**
+     * True while the interrupts are masked, so that the events stay pending.
+     */
+    bool interruptsMasked = false;
+
+    /**
+     * Function that processes the earliest event, if it is not later than the limit and the interrupts are not masked.
+     * An event that stayed pending while the interrupts were masked is processed at the current time.
+     * @param limitMicroSeconds The latest time of the event.
+     * @return True if an event was processed.
+     */
+    bool processNextEvent(uint64_t limitMicroSeconds);
+};
@@ -0,0 +1,70 @@
+#pragma once
+
+#include <cstdint>
+#include <map>
+#include "peripheral/pio/plib_pio.h"
+
+/**
+ * The PIO controller of the host build, backing the PIO peripheral library functions.
+ *
+ * @brief The device models drive the level of their output pins. As configured for the ALERT pins of the drivers,
+ * the pin interrupt is called on the falling edge, in the context of the event that drove the pin.
+ */
+class HostPIO {
+public:
+    /**
+     * Function that returns the PIO controller of the host build.
+     */
+    static HostPIO &instance();
+
+    /**
+     * Function that drives the level of a pin, calling its interrupt callback on a falling edge.
+     * @param pin The pin.
+     * @param level The new level.
+     */
+    void setLevel(PIO_PIN pin, bool level);
+
+    /**
+     * Function that returns the level of a pin, high if it was never driven (pull-up).
+     * @param pin The pin.
+     */
+    [[nodiscard]] bool getLevel(PIO_PIN pin) const;
+
+    /**
+     * Function that registers the interrupt callback of a pin.
+     */
+    void registerCallback(PIO_PIN pin, PIO_PIN_CALLBACK callback, uintptr_t context);
+
+    /**
+     * Function that enables or disables the interrupt of a pin.
+     */
+    void setInterruptEnabled(PIO_PIN pin, bool enabled);
+
+    /**
+     * Function that returns the number of pin interrupts called since the start of the run.
+     */
+    [[nodiscard]] uint32_t getInterruptsNumber() const {
+        return interruptsNumber;
+    }
+
+private:
+    /**
+     * The state of a pin.
+     */
+    struct Pin {
+        bool level = true;
+        bool interruptEnabled = false;
+        PIO_PIN_CALLBACK callback = nullptr;
+        uintptr_t context = 0;
+    };
+
+    /**
+     * The pins used during the run.
+     */
+    std::map<PIO_PIN, Pin> pins;
+
+    /**
+     * The number of called pin interrupts.
+     */
+    uint32_t interruptsNumber = 0;
+};
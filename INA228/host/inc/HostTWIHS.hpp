@@ -0,0 +1,202 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <optional>
+#include <span>
+#include <vector>
+#include "HostKernel.hpp"
+#include "plib_twihs0_master.h"
+
+/**
+ * An I2C target device attached to the bus of the host build.
+ */
+class HostI2CTarget {
+public:
+    virtual ~HostI2CTarget() = default;
+
+    /**
+     * Function called for the write phase of a transfer addressed to the device.
+     * @param data The written bytes.
+     * @return False if the device did not acknowledge the bytes.
+     */
+    virtual bool write(std::span<const uint8_t> data) = 0;
+
+    /**
+     * Function called for the read phase of a transfer addressed to the device.
+     * @param data The buffer of the read bytes.
+     * @return False if the device did not acknowledge its address.
+     */
+    virtual bool read(std::span<uint8_t> data) = 0;
+};
+
+/**
+ * The TWIHS0 peripheral of the host build, backing the TWIHS0 peripheral library functions.
+ *
+ * @brief As in the interrupt driven Harmony PLIB, a transfer is started by the Write, Read and WriteRead
+ * functions, and completes after its time on the bus, when the target device is accessed and the registered
+ * callback is called from the completion event. The bus time is computed from the number of bits of the transfer
+ * at the configured clock: 9 bits per byte, including the address bytes, plus the START, repeated START and
+ * STOP conditions. A transfer to an address with no attached device is not acknowledged.
+ */
+class HostTWIHS {
+public:
+    /**
+     * The statistics of the bus since the start of the run.
+     */
+    struct Statistics {
+        uint64_t transfers = 0;
+        uint64_t bytes = 0;
+        uint64_t nacks = 0;
+        uint64_t busyMicroSeconds = 0;
+    };
+
+    /**
+     * Function that returns the TWIHS0 peripheral of the host build.
+     */
+    static HostTWIHS &instance();
+
+    /**
+     * Function that attaches a device to the bus.
+     * @param address The 7-bit address of the device.
+     * @param target The device.
+     */
+    void attach(uint16_t address, HostI2CTarget &target);
+
+    /**
+     * Function that sets the SCL clock frequency.
+     * @param frequencyHz The frequency (in Hertz).
+     */
+    void setClockFrequency(uint32_t frequencyHz) {
+        clockFrequencyHz = frequencyHz;
+    }
+
+    /**
+     * Function that makes the next transfers never complete, as if the clock was stretched forever.
+     * @param transfersNumber The number of stalled transfers.
+     */
+    void stallTransfers(uint32_t transfersNumber) {
+        stalledTransfers = transfersNumber;
+    }
+
+    /**
+     * Function that computes the bus time of a transfer.
+     * @param writeSize The number of written bytes.
+     * @param readSize The number of read bytes.
+     * @return The time (in microseconds), rounded up.
+     */
+    [[nodiscard]] uint64_t getTransferMicroSeconds(size_t writeSize, size_t readSize) const;
+
+    /**
+     * Function that starts a transfer, with a write phase, a read phase or both (with a repeated START).
+     * @return False if a transfer is already in progress.
+     */
+    bool startTransfer(uint16_t address, const uint8_t *writeData, size_t writeSize, uint8_t *readData,
+                       size_t readSize);
+
+    /**
+     * Function that reinitializes the peripheral, aborting the transfer in progress without calling the callback.
+     */
+    void initialize();
+
+    /**
+     * Function that returns true while a transfer is in progress.
+     */
+    [[nodiscard]] bool isBusy() const {
+        return busy;
+    }
+
+    /**
+     * Function that returns the error of the last completed transfer.
+     */
+    [[nodiscard]] TWIHS_ERROR getError() const {
+        return error;
+    }
+
+    /**
+     * Function that registers the callback called on the completion of a transfer.
+     */
+    void registerCallback(TWIHS_CALLBACK callback, uintptr_t context) {
+        completionCallback = callback;
+        completionContext = context;
+    }
+
+    /**
+     * Function that returns the statistics of the bus since the start of the run.
+     */
+    [[nodiscard]] const Statistics &getStatistics() const {
+        return statistics;
+    }
+
+private:
+    /**
+     * The bits of a byte on the bus, including its acknowledge bit.
+     */
+    static constexpr uint64_t BitsPerByte = 9;
+
+    /**
+     * The bus time of a START, repeated START or STOP condition (in bits).
+     */
+    static constexpr uint64_t ConditionBits = 1;
+
+    /**
+     * The attached devices, by address.
+     */
+    std::map<uint16_t, HostI2CTarget *> targets;
+
+    /**
+     * The SCL clock frequency (in Hertz), 400 kHz as in fast mode.
+     */
+    uint32_t clockFrequencyHz = 400'000;
+
+    /**
+     * The number of next transfers that never complete.
+     */
+    uint32_t stalledTransfers = 0;
+
+    /**
+     * True while a transfer is in progress.
+     */
+    bool busy = false;
+
+    /**
+     * The error of the last completed transfer.
+     */
+    TWIHS_ERROR error = TWIHS_ERROR_NONE;
+
+    /**
+     * The callback called on the completion of a transfer.
+     */
+    TWIHS_CALLBACK completionCallback = nullptr;
+
+    /**
+     * The context passed to the completion callback.
+     */
+    uintptr_t completionContext = 0;
+
+    /**
+     * The completion event of the transfer in progress.
+     */
+    std::optional<HostKernel::EventId> completionEvent;
+
+    /**
+     * The written bytes of the transfer in progress, copied when it is started.
+     */
+    std::vector<uint8_t> writeBuffer;
+
+    /**
+     * The statistics of the bus since the start of the run.
+     */
+    Statistics statistics;
+
+    /**
+     * Function that converts a number of bits to their time on the bus (in microseconds), rounded up.
+     */
+    [[nodiscard]] uint64_t getBitsMicroSeconds(uint64_t bits) const;
+
+    /**
+     * Function that accesses the target device and calls the callback, at the end of the transfer.
+     */
+    void completeTransfer(uint16_t address, uint8_t *readData, size_t readSize);
+};
@@ -0,0 +1,312 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <optional>
+#include <random>
+#include <span>
+#include "HostKernel.hpp"
+#include "HostTWIHS.hpp"
+#include "peripheral/pio/plib_pio.h"
+
+/**
+ * Register level model of the INA228 device, attached to the bus of the host build.
+ *
+ * @brief The model implements the register map, the I2C register pointer protocol and the ADC of the device, as
+ * described in the datasheet: each conversion is scheduled at the conversion time set in ADC_CONFIG, multiplied by
+ * the averaging count, updates the result registers of the enabled channels from the configured inputs, accumulates
+ * ENERGY and CHARGE, compares the results against the limit registers and drives the ALERT pin. The CURRENT
+ * register is computed from VSHUNT and SHUNT_CAL as the device does, so a wrong SHUNT_CAL written by the driver
+ * shows up in the current readings. The shunt temperature compensation (SHUNT_TEMPCO), the slow alert filtering and
+ * the MATHOF flag are not modelled.
+ */
+class INA228Model : public HostI2CTarget {
+public:
+    /**
+     * Constructor of the model, in its power-on state: continuous conversion of all channels.
+     * @param alertPin The MCU pin connected to the ALERT pin, or PIO_PIN_NONE.
+     * @param seed The seed of the shunt voltage noise generator.
+     */
+    explicit INA228Model(PIO_PIN alertPin = PIO_PIN_NONE, uint32_t seed = 1);
+
+    ~INA228Model() override;
+
+    /**
+     * Function that sets the current through the shunt resistor.
+     * @param amperes The current (in Amperes), positive from IN+ to IN-.
+     */
+    void setShuntCurrent(double amperes) {
+        shuntCurrent = amperes;
+    }
+
+    /**
+     * Function that sets the resistance of the shunt resistor.
+     * @param ohms The resistance (in Ohms).
+     */
+    void setShuntResistance(double ohms) {
+        shuntResistance = ohms;
+    }
+
+    /**
+     * Function that sets the bus voltage.
+     * @param volts The voltage (in Volts).
+     */
+    void setBusVoltage(double volts) {
+        busVoltage = volts;
+    }
+
+    /**
+     * Function that sets the die temperature.
+     * @param celsius The temperature (in Celsius).
+     */
+    void setDieTemperature(double celsius) {
+        dieTemperature = celsius;
+    }
+
+    /**
+     * Function that sets the standard deviation of the shunt voltage noise of a single 50 μs conversion. The noise of
+     * a result decreases with the square root of its integration time, the conversion time times the averaging count.
+     * @param nanoVolts The standard deviation (in nanoVolts).
+     */
+    void setShuntNoise(double nanoVolts) {
+        shuntNoiseNanoVolts = nanoVolts;
+    }
+
+    /**
+     * Function that returns the value of a register, without the side effects of an I2C read.
+     * @param address The register address.
+     */
+    [[nodiscard]] uint64_t getRegister(uint8_t address) const {
+        return registers[address];
+    }
+
+    /**
+     * Function that sets a register to a raw value, without the side effects of an I2C write. In shutdown, a result
+     * register then reads back this value until the next conversion.
+     * @param address The register address.
+     * @param value The register value, right-aligned.
+     */
+    void setRegister(uint8_t address, uint64_t value) {
+        registers[address] = value;
+    }
+
+    /**
+     * Function that returns the time of one conversion of the enabled channels, with the current ADC_CONFIG.
+     * @return The time (in microseconds), 0 in shutdown.
+     */
+    [[nodiscard]] uint32_t getConversionPeriodMicroSeconds() const;
+
+    /**
+     * Function that returns the number of completed conversions since the power-on.
+     */
+    [[nodiscard]] uint64_t getConversionsNumber() const {
+        return conversionsNumber;
+    }
+
+    /**
+     * Function that returns true while the ALERT pin is asserted.
+     */
+    [[nodiscard]] bool isAlertAsserted() const {
+        return alertAsserted;
+    }
+
+    /**
+     * Function that resets all the registers to their power-on values and restarts the conversions.
+     */
+    void reset();
+
+    bool write(std::span<const uint8_t> data) override;
+
+    bool read(std::span<uint8_t> data) override;
+
+    /**
+     * The register addresses, as in the register map of the datasheet.
+     */
+    enum Register : uint8_t {
+        CONFIG = 0x00,
+        ADC_CONFIG = 0x01,
+        SHUNT_CAL = 0x02,
+        SHUNT_TEMPCO = 0x03,
+        VSHUNT = 0x04,
+        VBUS = 0x05,
+        DIETEMP = 0x06,
+        CURRENT = 0x07,
+        POWER = 0x08,
+        ENERGY = 0x09,
+        CHARGE = 0x0A,
+        DIAG_ALRT = 0x0B,
+        SOVL = 0x0C,
+        SUVL = 0x0D,
+        BOVL = 0x0E,
+        BUVL = 0x0F,
+        TEMP_LIMIT = 0x10,
+        PWR_LIMIT = 0x11,
+        MANUFACTURER_ID = 0x3E,
+        DEVICE_ID = 0x3F,
+    };
+
+private:
+    /**
+     * The number of addresses of the register map.
+     */
+    static constexpr size_t RegistersNumber = 0x40;
+
+    /**
+     * The bit masks of the CONFIG register.
+     */
+    static constexpr uint16_t ConfigResetMask = 1 << 15;
+    static constexpr uint16_t ConfigResetAccumulatorsMask = 1 << 14;
+    static constexpr uint16_t ConfigADCRangeMask = 1 << 4;
+
+    /**
+     * The bit masks of the DIAG_ALRT register.
+     */
+    static constexpr uint16_t AlertLatchMask = 1 << 15;
+    static constexpr uint16_t ConversionReadyAlertMask = 1 << 14;
+    static constexpr uint16_t AlertPolarityMask = 1 << 12;
+    static constexpr uint16_t EnergyOverflowMask = 1 << 11;
+    static constexpr uint16_t ChargeOverflowMask = 1 << 10;
+    static constexpr uint16_t TemperatureOverLimitMask = 1 << 7;
+    static constexpr uint16_t ShuntOverLimitMask = 1 << 6;
+    static constexpr uint16_t ShuntUnderLimitMask = 1 << 5;
+    static constexpr uint16_t BusOverLimitMask = 1 << 4;
+    static constexpr uint16_t BusUnderLimitMask = 1 << 3;
+    static constexpr uint16_t PowerOverLimitMask = 1 << 2;
+    static constexpr uint16_t ConversionReadyMask = 1 << 1;
+    static constexpr uint16_t MemoryStatusMask = 1 << 0;
+    static constexpr uint16_t LimitFlagsMask = TemperatureOverLimitMask | ShuntOverLimitMask | ShuntUnderLimitMask |
+                                               BusOverLimitMask | BusUnderLimitMask | PowerOverLimitMask;
+    static constexpr uint16_t AlertConfigurationMask = 0xF000;
+
+    /**
+     * The conversion times of the VBUSCT, VSHCT and VTCT field values (in microseconds).
+     */
+    static constexpr std::array<uint32_t, 8> ConversionTimesMicroSeconds = {50, 84, 150, 280, 540, 1052, 2074, 4120};
+
+    /**
+     * The averaging counts of the AVG field values.
+     */
+    static constexpr std::array<uint32_t, 8> AveragingCounts = {1, 4, 16, 64, 128, 256, 512, 1024};
+
+    /**
+     * The size of each register (in bytes), 0 for the reserved addresses.
+     */
+    static constexpr std::array<uint8_t, RegistersNumber> RegisterSizes = [] {
+        std::array<uint8_t, RegistersNumber> sizes{};
+        for (uint8_t address = CONFIG; address <= PWR_LIMIT; address++) {
+            sizes[address] = 2;
+        }
+        sizes[VSHUNT] = 3;
+        sizes[VBUS] = 3;
+        sizes[CURRENT] = 3;
+        sizes[POWER] = 3;
+        sizes[ENERGY] = 5;
+        sizes[CHARGE] = 5;
+        sizes[MANUFACTURER_ID] = 2;
+        sizes[DEVICE_ID] = 2;
+        return sizes;
+    }();
+
+    /**
+     * The register map.
+     */
+    std::array<uint64_t, RegistersNumber> registers{};
+
+    /**
+     * The register pointer, set by the first byte of a write transfer.
+     */
+    uint8_t registerPointer = CONFIG;
+
+    /**
+     * The MCU pin connected to the ALERT pin.
+     */
+    const PIO_PIN AlertPin;
+
+    /**
+     * The current through the shunt resistor (in Amperes).
+     */
+    double shuntCurrent = 0.0;
+
+    /**
+     * The resistance of the shunt resistor (in Ohms).
+     */
+    double shuntResistance = 0.05;
+
+    /**
+     * The bus voltage (in Volts).
+     */
+    double busVoltage = 0.0;
+
+    /**
+     * The die temperature (in Celsius).
+     */
+    double dieTemperature = 25.0;
+
+    /**
+     * The standard deviation of the shunt voltage noise of a single 50 μs conversion (in nanoVolts).
+     */
+    double shuntNoiseNanoVolts = 0.0;
+
+    /**
+     * The unrounded ENERGY and CHARGE accumulators, in register units.
+     */
+    double energyAccumulator = 0.0;
+    double chargeAccumulator = 0.0;
+
+    /**
+     * The next conversion event, if the ADC is converting.
+     */
+    std::optional<HostKernel::EventId> conversionEvent;
+
+    /**
+     * The number of completed conversions since the power-on.
+     */
+    uint64_t conversionsNumber = 0;
+
+    /**
+     * True while the ALERT pin is asserted.
+     */
+    bool alertAsserted = false;
+
+    /**
+     * The generator of the shunt voltage noise, seeded so that a run is reproducible.
+     */
+    std::mt19937 noiseGenerator;
+
+    /**
+     * The standard normal distribution of the shunt voltage noise.
+     */
+    std::normal_distribution<double> noiseDistribution{0.0, 1.0};
+
+    /**
+     * Function that writes a register, with the side effects of the CONFIG, ADC_CONFIG and DIAG_ALRT registers.
+     */
+    void writeRegister(uint8_t address, uint16_t value);
+
+    /**
+     * Function that cancels the conversion in progress and starts the conversions of the current ADC_CONFIG,
+     * after the initial delay of CONFIG.
+     */
+    void restartConversions();
+
+    /**
+     * Function that completes a conversion, updating the result registers, the flags and the ALERT pin.
+     */
+    void completeConversion();
+
+    /**
+     * Function that compares the results against the limit registers.
+     * @return The limit flags of the DIAG_ALRT register.
+     */
+    [[nodiscard]] uint16_t compareLimits() const;
+
+    /**
+     * Function that drives the ALERT pin, as configured in DIAG_ALRT, at the end of a conversion.
+     */
+    void updateAlert();
+
+    /**
+     * Function that asserts or releases the ALERT pin.
+     */
+    void setAlert(bool asserted);
+};
@@ -0,0 +1,40 @@
+#pragma once
+
+/**
+ * Host build replacement of the FreeRTOS kernel header, backed by the virtual time of HostKernel.
+ */
+
+#include <stdint.h>
+#include <stddef.h>
+
+typedef uint32_t TickType_t;
+typedef long BaseType_t;
+typedef unsigned long UBaseType_t;
+
+#define configTICK_RATE_HZ ((TickType_t) 1000)
+
+#define pdFALSE ((BaseType_t) 0)
+#define pdTRUE ((BaseType_t) 1)
+#define pdPASS pdTRUE
+#define pdFAIL pdFALSE
+
+#define portMAX_DELAY ((TickType_t) 0xFFFFFFFFU)
+#define portTICK_PERIOD_MS ((TickType_t) 1000 / configTICK_RATE_HZ)
+#define pdMS_TO_TICKS(xTimeInMs) ((TickType_t) (((TickType_t) (xTimeInMs) * configTICK_RATE_HZ) / (TickType_t) 1000U))
+
+#define portYIELD_FROM_ISR(xSwitchRequired) ((void) (xSwitchRequired))
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * Aborts the host build with the location of the failed configASSERT().
+ */
+void vHostAssertFailed(const char *file, int line);
+
+#ifdef __cplusplus
+}
+#endif
+
+#define configASSERT(x) if ((x) == 0) { vHostAssertFailed(__FILE__, __LINE__); }
@@ -0,0 +1,44 @@
+#pragma once
+
+#include <iostream>
+#include <type_traits>
+
+/**
+ * Host build replacement of the logger, printing each entry as a line on the standard error.
+ */
+class HostLogEntry {
+public:
+    explicit HostLogEntry(const char *level) {
+        if (Enabled) {
+            std::cerr << "[" << level << "] ";
+        }
+    }
+
+    ~HostLogEntry() {
+        if (Enabled) {
+            std::cerr << std::endl;
+        }
+    }
+
+    template<typename T>
+    HostLogEntry &operator<<(const T &value) {
+        if (Enabled) {
+            if constexpr (std::is_enum_v<T>) {
+                std::cerr << static_cast<std::underlying_type_t<T>>(value);
+            } else {
+                std::cerr << value;
+            }
+        }
+        return *this;
+    }
+
+    /**
+     * False to discard the log entries, e.g. while the expected errors of a fault injection are logged.
+     */
+    static inline bool Enabled = true;
+};
+
+#define LOG_DEBUG HostLogEntry("debug")
+#define LOG_INFO HostLogEntry("info")
+#define LOG_WARNING HostLogEntry("warning")
+#define LOG_ERROR HostLogEntry("error")
@@ -0,0 +1,13 @@
+#pragma once
+
+/**
+ * Host build peripheral definitions: all the drivers use TWIHS0, the only port simulated by HostTWIHS.
+ */
+
+#ifndef INA228_TWI_PORT
+#define INA228_TWI_PORT 0
+#endif
+
+#ifndef SHT3xDIS_TWI_PORT
+#define SHT3xDIS_TWI_PORT 0
+#endif
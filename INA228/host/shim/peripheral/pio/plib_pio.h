@@ -0,0 +1,32 @@
+#pragma once
+
+/**
+ * Host build replacement of the PIO peripheral library, backed by HostPIO.
+ */
+
+#include <stdint.h>
+#include <stdbool.h>
+
+typedef uint32_t PIO_PIN;
+
+#define PIO_PIN_NONE ((PIO_PIN) 0xFFFFFFFFU)
+
+typedef void (*PIO_PIN_CALLBACK)(PIO_PIN pin, uintptr_t context);
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+bool PIO_PinRead(PIO_PIN pin);
+
+void PIO_PinWrite(PIO_PIN pin, bool value);
+
+bool PIO_PinInterruptCallbackRegister(PIO_PIN pin, const PIO_PIN_CALLBACK callback, uintptr_t context);
+
+void PIO_PinInterruptEnable(PIO_PIN pin);
+
+void PIO_PinInterruptDisable(PIO_PIN pin);
+
+#ifdef __cplusplus
+}
+#endif
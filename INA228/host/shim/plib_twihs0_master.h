@@ -0,0 +1,29 @@
+#pragma once
+
+/**
+ * Host build replacement of the TWIHS0 peripheral library, backed by HostTWIHS.
+ */
+
+#include "plib_twihs_master_common.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+void TWIHS0_Initialize(void);
+
+bool TWIHS0_Read(uint16_t address, uint8_t *pdata, size_t length);
+
+bool TWIHS0_Write(uint16_t address, uint8_t *pdata, size_t length);
+
+bool TWIHS0_WriteRead(uint16_t address, uint8_t *wdata, size_t wlength, uint8_t *rdata, size_t rlength);
+
+bool TWIHS0_IsBusy(void);
+
+TWIHS_ERROR TWIHS0_ErrorGet(void);
+
+void TWIHS0_CallbackRegister(TWIHS_CALLBACK callback, uintptr_t contextHandle);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,12 @@
+#pragma once
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+
+typedef enum {
+    TWIHS_ERROR_NONE,
+    TWIHS_ERROR_NACK,
+} TWIHS_ERROR;
+
+typedef void (*TWIHS_CALLBACK)(uintptr_t contextHandle);
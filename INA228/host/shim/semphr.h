@@ -0,0 +1,30 @@
+#pragma once
+
+/**
+ * Host build replacement of the FreeRTOS semaphore API.
+ */
+
+#include "FreeRTOS.h"
+
+typedef struct StaticSemaphore {
+    UBaseType_t count;
+    UBaseType_t maximumCount;
+} StaticSemaphore_t;
+
+typedef StaticSemaphore_t *SemaphoreHandle_t;
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+SemaphoreHandle_t xSemaphoreCreateBinaryStatic(StaticSemaphore_t *pxSemaphoreBuffer);
+
+BaseType_t xSemaphoreTake(SemaphoreHandle_t xSemaphore, TickType_t xBlockTime);
+
+BaseType_t xSemaphoreGive(SemaphoreHandle_t xSemaphore);
+
+BaseType_t xSemaphoreGiveFromISR(SemaphoreHandle_t xSemaphore, BaseType_t *pxHigherPriorityTaskWoken);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,44 @@
+#pragma once
+
+/**
+ * Host build replacement of the FreeRTOS task API. The host build runs a single task, so the blocking calls process
+ * the peripheral events of HostKernel until the task is woken, instead of switching to another task.
+ */
+
+#include "FreeRTOS.h"
+
+typedef struct tskTaskControlBlock *TaskHandle_t;
+
+#define taskSCHEDULER_SUSPENDED ((BaseType_t) 0)
+#define taskSCHEDULER_NOT_STARTED ((BaseType_t) 1)
+#define taskSCHEDULER_RUNNING ((BaseType_t) 2)
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+TickType_t xTaskGetTickCount(void);
+
+TickType_t xTaskGetTickCountFromISR(void);
+
+void vTaskDelay(TickType_t xTicksToDelay);
+
+BaseType_t xTaskGetSchedulerState(void);
+
+TaskHandle_t xTaskGetCurrentTaskHandle(void);
+
+void vTaskNotifyGiveFromISR(TaskHandle_t xTaskToNotify, BaseType_t *pxHigherPriorityTaskWoken);
+
+uint32_t ulTaskNotifyTake(BaseType_t xClearCountOnExit, TickType_t xTicksToWait);
+
+void vTaskEnterCritical(void);
+
+void vTaskExitCritical(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#define taskENTER_CRITICAL() vTaskEnterCritical()
+#define taskEXIT_CRITICAL() vTaskExitCritical()
+#define taskYIELD()
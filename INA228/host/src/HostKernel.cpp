@@ -0,0 +1,201 @@
+#include "HostKernel.hpp"
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include "FreeRTOS.h"
+#include "task.h"
+#include "semphr.h"
+
+/**
+ * The task control block of the single task of the host build.
+ */
+struct tskTaskControlBlock {
+    uint32_t notificationValue = 0;
+};
+
+namespace {
+    tskTaskControlBlock hostTask;
+
+    uint32_t criticalNesting = 0;
+}
+
+HostKernel &HostKernel::instance() {
+    static HostKernel kernel;
+    return kernel;
+}
+
+HostKernel::EventId HostKernel::schedule(uint64_t delayMicroSeconds, std::function<void()> handler) {
+    const EventId Id = nextEventId++;
+    events.emplace(std::make_pair(timeMicroSeconds + delayMicroSeconds, Id), std::move(handler));
+    return Id;
+}
+
+void HostKernel::cancel(EventId eventId) {
+    for (auto event = events.begin(); event != events.end(); ++event) {
+        if (event->first.second == eventId) {
+            events.erase(event);
+            return;
+        }
+    }
+}
+
+void HostKernel::advance(uint64_t microSeconds) {
+    const uint64_t Target = timeMicroSeconds + microSeconds;
+
+    while (processNextEvent(Target)) {}
+
+    timeMicroSeconds = Target;
+}
+
+bool HostKernel::runUntil(const std::function<bool()> &condition, uint64_t deadlineMicroSeconds) {
+    while (not condition()) {
+        if (not processNextEvent(deadlineMicroSeconds)) {
+            if (deadlineMicroSeconds != Never) {
+                timeMicroSeconds = deadlineMicroSeconds;
+            }
+            return condition();
+        }
+    }
+
+    return true;
+}
+
+uint64_t HostKernel::getDeadline(uint32_t ticks) const {
+    if (ticks == portMAX_DELAY) {
+        return Never;
+    }
+
+    // As in FreeRTOS, a timeout of n ticks expires on the n-th tick interrupt from now
+    return (timeMicroSeconds / TickMicroSeconds + ticks) * TickMicroSeconds;
+}
+
+bool HostKernel::processNextEvent(uint64_t limitMicroSeconds) {
+    if (interruptsMasked or events.empty() or (events.begin()->first.first > limitMicroSeconds)) {
+        return false;
+    }
+
+    auto event = events.extract(events.begin());
+    timeMicroSeconds = std::max(timeMicroSeconds, event.key().first);
+    processedEvents++;
+    event.mapped()();
+
+    return true;
+}
+
+extern "C" {
+
+void vHostAssertFailed(const char *file, int line) {
+    std::fprintf(stderr, "configASSERT failed at %s:%d\n", file, line);
+    std::abort();
+}
+
+TickType_t xTaskGetTickCount(void) {
+    return static_cast<TickType_t>(HostKernel::instance().getTimeMicroSeconds() / HostKernel::TickMicroSeconds);
+}
+
+TickType_t xTaskGetTickCountFromISR(void) {
+    return xTaskGetTickCount();
+}
+
+void vTaskDelay(TickType_t xTicksToDelay) {
+    HostKernel &kernel = HostKernel::instance();
+    configASSERT(kernel.isSchedulerStarted());
+    kernel.advance(kernel.getDeadline(xTicksToDelay) - kernel.getTimeMicroSeconds());
+}
+
+BaseType_t xTaskGetSchedulerState(void) {
+    return HostKernel::instance().isSchedulerStarted() ? taskSCHEDULER_RUNNING : taskSCHEDULER_NOT_STARTED;
+}
+
+TaskHandle_t xTaskGetCurrentTaskHandle(void) {
+    return &hostTask;
+}
+
+void vTaskNotifyGiveFromISR(TaskHandle_t xTaskToNotify, BaseType_t *pxHigherPriorityTaskWoken) {
+    xTaskToNotify->notificationValue++;
+
+    if (pxHigherPriorityTaskWoken != nullptr) {
+        *pxHigherPriorityTaskWoken = pdTRUE;
+    }
+}
+
+uint32_t ulTaskNotifyTake(BaseType_t xClearCountOnExit, TickType_t xTicksToWait) {
+    HostKernel &kernel = HostKernel::instance();
+
+    if (xTicksToWait != 0) {
+        configASSERT(kernel.isSchedulerStarted());
+        kernel.runUntil([] { return hostTask.notificationValue != 0; }, kernel.getDeadline(xTicksToWait));
+    }
+
+    const uint32_t Value = hostTask.notificationValue;
+
+    if (Value != 0) {
+        hostTask.notificationValue = (xClearCountOnExit != pdFALSE) ? 0 : Value - 1;
+    }
+
+    return Value;
+}
+
+void vTaskEnterCritical(void) {
+    HostKernel::instance().maskInterrupts();
+    criticalNesting++;
+}
+
+void vTaskExitCritical(void) {
+    configASSERT(criticalNesting != 0);
+    criticalNesting--;
+
+    if (criticalNesting == 0) {
+        HostKernel::instance().unmaskInterrupts();
+    }
+}
+
+SemaphoreHandle_t xSemaphoreCreateBinaryStatic(StaticSemaphore_t *pxSemaphoreBuffer) {
+    configASSERT(pxSemaphoreBuffer != nullptr);
+
+    // As xQueueGenericReset(), the creation enters a critical section
+    taskENTER_CRITICAL();
+    pxSemaphoreBuffer->count = 0;
+    pxSemaphoreBuffer->maximumCount = 1;
+    taskEXIT_CRITICAL();
+
+    return pxSemaphoreBuffer;
+}
+
+BaseType_t xSemaphoreTake(SemaphoreHandle_t xSemaphore, TickType_t xBlockTime) {
+    HostKernel &kernel = HostKernel::instance();
+
+    if ((xSemaphore->count == 0) and (xBlockTime != 0)) {
+        // The semaphore can only be given by an event, so the task blocks only outside of a critical section
+        configASSERT(kernel.isSchedulerStarted() and (criticalNesting == 0));
+        kernel.runUntil([xSemaphore] { return xSemaphore->count != 0; }, kernel.getDeadline(xBlockTime));
+    }
+
+    if (xSemaphore->count == 0) {
+        return pdFALSE;
+    }
+
+    xSemaphore->count--;
+    return pdTRUE;
+}
+
+BaseType_t xSemaphoreGive(SemaphoreHandle_t xSemaphore) {
+    if (xSemaphore->count == xSemaphore->maximumCount) {
+        return pdFALSE;
+    }
+
+    xSemaphore->count++;
+    return pdTRUE;
+}
+
+BaseType_t xSemaphoreGiveFromISR(SemaphoreHandle_t xSemaphore, BaseType_t *pxHigherPriorityTaskWoken) {
+    const BaseType_t Given = xSemaphoreGive(xSemaphore);
+
+    if ((Given == pdTRUE) and (pxHigherPriorityTaskWoken != nullptr)) {
+        *pxHigherPriorityTaskWoken = pdTRUE;
+    }
+
+    return Given;
+}
+
+}
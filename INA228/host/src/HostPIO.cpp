@@ -0,0 +1,62 @@
+#include "HostPIO.hpp"
+
+HostPIO &HostPIO::instance() {
+    static HostPIO pio;
+    return pio;
+}
+
+void HostPIO::setLevel(PIO_PIN pin, bool level) {
+    Pin &state = pins[pin];
+    const bool FallingEdge = state.level and not level;
+
+    state.level = level;
+
+    if (FallingEdge and state.interruptEnabled and (state.callback != nullptr)) {
+        interruptsNumber++;
+        state.callback(pin, state.context);
+    }
+}
+
+bool HostPIO::getLevel(PIO_PIN pin) const {
+    const auto State = pins.find(pin);
+    return (State == pins.end()) or State->second.level;
+}
+
+void HostPIO::registerCallback(PIO_PIN pin, PIO_PIN_CALLBACK callback, uintptr_t context) {
+    Pin &state = pins[pin];
+    state.callback = callback;
+    state.context = context;
+}
+
+void HostPIO::setInterruptEnabled(PIO_PIN pin, bool enabled) {
+    pins[pin].interruptEnabled = enabled;
+}
+
+extern "C" {
+
+bool PIO_PinRead(PIO_PIN pin) {
+    return HostPIO::instance().getLevel(pin);
+}
+
+void PIO_PinWrite(PIO_PIN pin, bool value) {
+    HostPIO::instance().setLevel(pin, value);
+}
+
+bool PIO_PinInterruptCallbackRegister(PIO_PIN pin, const PIO_PIN_CALLBACK callback, uintptr_t context) {
+    if (pin == PIO_PIN_NONE) {
+        return false;
+    }
+
+    HostPIO::instance().registerCallback(pin, callback, context);
+    return true;
+}
+
+void PIO_PinInterruptEnable(PIO_PIN pin) {
+    HostPIO::instance().setInterruptEnabled(pin, true);
+}
+
+void PIO_PinInterruptDisable(PIO_PIN pin) {
+    HostPIO::instance().setInterruptEnabled(pin, false);
+}
+
+}
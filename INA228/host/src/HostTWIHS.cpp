@@ -0,0 +1,132 @@
+#include "HostTWIHS.hpp"
+
+HostTWIHS &HostTWIHS::instance() {
+    static HostTWIHS twihs;
+    return twihs;
+}
+
+void HostTWIHS::attach(uint16_t address, HostI2CTarget &target) {
+    targets[address] = &target;
+}
+
+uint64_t HostTWIHS::getTransferMicroSeconds(size_t writeSize, size_t readSize) const {
+    uint64_t bits = ConditionBits * 2;
+
+    if (writeSize != 0) {
+        bits += BitsPerByte * (writeSize + 1);
+    }
+
+    if (readSize != 0) {
+        bits += BitsPerByte * (readSize + 1);
+
+        if (writeSize != 0) {
+            bits += ConditionBits;
+        }
+    }
+
+    return getBitsMicroSeconds(bits);
+}
+
+uint64_t HostTWIHS::getBitsMicroSeconds(uint64_t bits) const {
+    return (bits * 1'000'000 + clockFrequencyHz - 1) / clockFrequencyHz;
+}
+
+bool HostTWIHS::startTransfer(uint16_t address, const uint8_t *writeData, size_t writeSize, uint8_t *readData,
+                              size_t readSize) {
+    if (busy) {
+        return false;
+    }
+
+    busy = true;
+    error = TWIHS_ERROR_NONE;
+    writeBuffer.assign(writeData, writeData + writeSize);
+    statistics.transfers++;
+
+    if (stalledTransfers != 0) {
+        stalledTransfers--;
+        return true;
+    }
+
+    // An absent device does not acknowledge its address, which ends the transfer after the first byte
+    const bool Present = targets.contains(address);
+    const uint64_t Duration = Present ? getTransferMicroSeconds(writeSize, readSize)
+                                      : getBitsMicroSeconds(BitsPerByte + ConditionBits * 2);
+
+    statistics.busyMicroSeconds += Duration;
+
+    completionEvent = HostKernel::instance().schedule(Duration, [this, address, readData, readSize] {
+        completeTransfer(address, readData, readSize);
+    });
+
+    return true;
+}
+
+void HostTWIHS::completeTransfer(uint16_t address, uint8_t *readData, size_t readSize) {
+    completionEvent.reset();
+
+    const auto Target = targets.find(address);
+    bool acknowledged = Target != targets.end();
+
+    if (acknowledged and not writeBuffer.empty()) {
+        acknowledged = Target->second->write(writeBuffer);
+        statistics.bytes += writeBuffer.size();
+    }
+
+    if (acknowledged and (readSize != 0)) {
+        acknowledged = Target->second->read(std::span<uint8_t>(readData, readSize));
+        statistics.bytes += readSize;
+    }
+
+    if (not acknowledged) {
+        error = TWIHS_ERROR_NACK;
+        statistics.nacks++;
+    }
+
+    busy = false;
+
+    if (completionCallback != nullptr) {
+        completionCallback(completionContext);
+    }
+}
+
+void HostTWIHS::initialize() {
+    if (completionEvent) {
+        HostKernel::instance().cancel(completionEvent.value());
+        completionEvent.reset();
+    }
+
+    busy = false;
+    error = TWIHS_ERROR_NONE;
+}
+
+extern "C" {
+
+void TWIHS0_Initialize(void) {
+    HostTWIHS::instance().initialize();
+}
+
+bool TWIHS0_Read(uint16_t address, uint8_t *pdata, size_t length) {
+    return HostTWIHS::instance().startTransfer(address, nullptr, 0, pdata, length);
+}
+
+bool TWIHS0_Write(uint16_t address, uint8_t *pdata, size_t length) {
+    return HostTWIHS::instance().startTransfer(address, pdata, length, nullptr, 0);
+}
+
+bool TWIHS0_WriteRead(uint16_t address, uint8_t *wdata, size_t wlength, uint8_t *rdata, size_t rlength) {
+    return HostTWIHS::instance().startTransfer(address, wdata, wlength, rdata, rlength);
+}
+
+bool TWIHS0_IsBusy(void) {
+    return HostTWIHS::instance().isBusy();
+}
+
+TWIHS_ERROR TWIHS0_ErrorGet(void) {
+    return HostTWIHS::instance().getError();
+}
+
+void TWIHS0_CallbackRegister(TWIHS_CALLBACK callback, uintptr_t contextHandle) {
+    HostTWIHS::instance().registerCallback(callback, contextHandle);
+}
+
+}
@@ -0,0 +1,779 @@
+#include <array>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <random>
+#if defined(__x86_64__)
+#include <x86intrin.h>
+#endif
+#include "HostKernel.hpp"
+#include "HostPIO.hpp"
+#include "HostTWIHS.hpp"
+#include "INA228Model.hpp"
+#include "INA228.hpp"
+#include "INA228Accumulator.hpp"
+#include "INA228Configuration.hpp"
+#include "INA228Poller.hpp"
+
+/**
+ * The host build runner of the INA228 driver: the driver and its Accumulator and Poller run unmodified against
+ * INA228Model devices on HostTWIHS, first through functional checks of every decoded value against the model inputs,
+ * then, with --benchmark, through throughput measurements of the blocking, readAll() and asynchronous read paths,
+ * and through the host cycles of the floating-point and fixed-point conversions.
+ *
+ * The bus figures are in virtual time, so they are what the target achieves at the simulated SCL clock, excluding
+ * the CPU time of the driver. The CPU figures are the host wall-clock time per operation, to compare the cost of
+ * the paths, not an estimate of the Cortex-M7 time. The process exits with a non-zero status if a check fails.
+ */
+
+namespace {
+    /**
+     * The MCU pin connected to the ALERT pin of the main device.
+     */
+    constexpr PIO_PIN AlertPin = 42;
+
+    /**
+     * The 7-bit addresses of the simulated devices, and one with no device.
+     */
+    constexpr auto MainAddress = INA228::I2CAddress::Address_1000000;
+    constexpr auto SecondAddress = INA228::I2CAddress::Address_1000001;
+    constexpr auto AbsentAddress = INA228::I2CAddress::Address_1001111;
+
+    /**
+     * The time of a conversion of all measurements of the default ADC configuration, 3 x 1052 μs.
+     */
+    constexpr TickType_t DefaultConversionTicks = pdMS_TO_TICKS(4);
+
+    /**
+     * The conversion times and averaging counts of the ADC_CONFIG field values, as in the datasheet.
+     */
+    constexpr std::array<uint32_t, 8> ConversionTimesMicroSeconds = {50, 84, 150, 280, 540, 1052, 2074, 4120};
+    constexpr std::array<uint32_t, 8> AveragingCounts = {1, 4, 16, 64, 128, 256, 512, 1024};
+
+    uint32_t checksNumber = 0;
+
+    uint32_t failedChecksNumber = 0;
+
+    void check(bool condition, const char *description) {
+        checksNumber++;
+
+        if (not condition) {
+            failedChecksNumber++;
+        }
+
+        std::printf("[%s] %s\n", condition ? "PASS" : "FAIL", description);
+    }
+
+    template<typename T>
+    bool isNear(const etl::expected<T, INA228::Error> &value, double expected, double tolerance) {
+        return value.has_value() and (std::fabs(static_cast<double>(value.value()) - expected) <= tolerance);
+    }
+
+    uint16_t toAddress(INA228::I2CAddress address) {
+        return static_cast<uint16_t>(address);
+    }
+
+    /**
+     * Checks the decoding of every measurement, in floating-point and in integer arithmetic, for one operating point.
+     */
+    void checkMeasurements(INA228Model &model, const INA228 &ina228, double current, double busVoltage,
+                           double dieTemperature) {
+        model.setShuntCurrent(current);
+        model.setBusVoltage(busVoltage);
+        model.setDieTemperature(dieTemperature);
+        vTaskDelay(2 * DefaultConversionTicks);
+
+        char description[160];
+        auto describe = [&](const char *measurement) {
+            std::snprintf(description, sizeof(description), "%s at %.3f A, %.3f V, %.3f C", measurement, current,
+                          busVoltage, dieTemperature);
+            return description;
+        };
+
+        // One VSHUNT LSB (312.5 nV) through 50 mΩ is 6.25 μA
+        constexpr double CurrentTolerance = 7e-6;
+        const double Power = std::fabs(current) * busVoltage;
+
+        check(isNear(ina228.getCurrent(), current, CurrentTolerance), describe("getCurrent"));
+        check(isNear(ina228.getCurrentMicroAmperes(), current * 1e6, CurrentTolerance * 1e6 + 1),
+              describe("getCurrentMicroAmperes"));
+        check(isNear(ina228.getShuntVoltage(), current * 0.05 * 1e3, 313e-9 * 1e3), describe("getShuntVoltage"));
+        check(isNear(ina228.getShuntVoltageNanoVolts(), current * 0.05 * 1e9, 313),
+              describe("getShuntVoltageNanoVolts"));
+        check(isNear(ina228.getVoltage(), busVoltage, 196e-6), describe("getVoltage"));
+        check(isNear(ina228.getVoltageMicroVolts(), busVoltage * 1e6, 196), describe("getVoltageMicroVolts"));
+        check(isNear(ina228.getDieTemperature(), dieTemperature, 7.9e-3), describe("getDieTemperature"));
+        check(isNear(ina228.getDieTemperatureMilliCelsius(), dieTemperature * 1e3, 7.9),
+              describe("getDieTemperatureMilliCelsius"));
+        check(isNear(ina228.getPower(), Power, Power * 1e-4 + 1e-4), describe("getPower"));
+        check(isNear(ina228.getPowerMicroWatts(), Power * 1e6, Power * 1e2 + 1e2), describe("getPowerMicroWatts"));
+    }
+
+    /**
+     * The layout of a result register in the model: the value is a Bits-wide code, left-shifted by Shift.
+     */
+    struct RegisterCoding {
+        uint8_t address;
+        uint32_t bits;
+        uint32_t shift;
+
+        [[nodiscard]] uint64_t encode(int64_t code) const {
+            return (static_cast<uint64_t>(code) & ((uint64_t{1} << bits) - 1)) << shift;
+        }
+    };
+
+    /**
+     * The exact value of one LSB of a register, in the unit of its fixed-point getter, and the scale from the unit of
+     * its floating-point getter to that unit.
+     */
+    struct Resolution {
+        __int128 numerator;
+        __int128 denominator;
+        long double fixedUnitsPerFloatUnit;
+    };
+
+    /**
+     * Checks the decoding of register codes from First to Last, every Stride codes and Last, with the device in
+     * shutdown and the code set directly in the model. The fixed-point getter shall return the exact value of the
+     * code truncated toward zero, bit for bit, and the floating-point getter the exact value within its float
+     * rounding.
+     */
+    template<typename FIXED_GETTER, typename FLOAT_GETTER>
+    void checkCodeDecoding(INA228Model &model, const char *name, RegisterCoding coding, Resolution resolution,
+                           int64_t first, int64_t last, int64_t stride, FIXED_GETTER fixedGetter,
+                           FLOAT_GETTER floatGetter) {
+        // Two float roundings, of the resolution and of the product
+        constexpr long double FloatTolerance = 1.0L / (1 << 21);
+
+        uint32_t codes = 0;
+        uint32_t fixedMismatches = 0;
+        uint32_t floatMismatches = 0;
+
+        auto checkCode = [&](int64_t code) {
+            model.setRegister(coding.address, coding.encode(code));
+
+            const __int128 Exact = code * resolution.numerator;
+            const __int128 Truncated = Exact / resolution.denominator;
+            const long double ExactValue = static_cast<long double>(Exact) /
+                                           static_cast<long double>(resolution.denominator);
+            const auto Fixed = fixedGetter();
+            const auto Float = floatGetter();
+
+            codes++;
+            if (not Fixed.has_value() or (static_cast<__int128>(Fixed.value()) != Truncated)) {
+                fixedMismatches++;
+            }
+            if (not Float.has_value() or
+                (std::fabs(static_cast<long double>(Float.value()) * resolution.fixedUnitsPerFloatUnit - ExactValue) >
+                 std::fabs(ExactValue) * FloatTolerance)) {
+                floatMismatches++;
+            }
+        };
+
+        for (int64_t code = first; code < last; code += stride) {
+            checkCode(code);
+        }
+        checkCode(last);
+
+        char description[160];
+        std::snprintf(description, sizeof(description), "%s fixed-point getter exact for %u codes", name, codes);
+        check(fixedMismatches == 0, description);
+        std::snprintf(description, sizeof(description), "%s floating-point getter within float rounding for %u codes",
+                      name, codes);
+        check(floatMismatches == 0, description);
+    }
+
+    /**
+     * Checks the fixed-point getters bit for bit against the exact decoding of the register codes, and against the
+     * floating-point getters: every DIETEMP code, and evenly spread codes of the wider registers with both ends of
+     * their ranges.
+     */
+    void checkFixedPointDecoding(INA228Model &model, INA228 &ina228) {
+        constexpr __int128 MaximumCurrentMicroAmperes = INA228DefaultConfiguration::MaximumExpectedCurrentMicroAmperes;
+        constexpr __int128 CurrentDenominator = __int128{1} << 19;
+        constexpr int64_t Signed20BitMinimum = -(int64_t{1} << 19);
+        constexpr int64_t Signed20BitMaximum = (int64_t{1} << 19) - 1;
+
+        ina228.configureADC(INA228::ADCMode::Shutdown, INA228::ConversionTime::Time1052us,
+                            INA228::ConversionTime::Time1052us, INA228::ConversionTime::Time1052us,
+                            INA228::AveragingCount::Samples1);
+
+        checkCodeDecoding(model, "VSHUNT", {INA228Model::VSHUNT, 20, 4}, {625, 2, 1e6L}, Signed20BitMinimum,
+                          Signed20BitMaximum, 5, [&] { return ina228.getShuntVoltageNanoVolts(); },
+                          [&] { return ina228.getShuntVoltage(); });
+        // The bus voltage is always positive, the floating-point path does not sign-extend it
+        checkCodeDecoding(model, "VBUS", {INA228Model::VBUS, 20, 4}, {3125, 16, 1e6L}, 0, Signed20BitMaximum, 5,
+                          [&] { return ina228.getVoltageMicroVolts(); }, [&] { return ina228.getVoltage(); });
+        checkCodeDecoding(model, "DIETEMP", {INA228Model::DIETEMP, 16, 0}, {125, 16, 1e3L}, INT16_MIN, INT16_MAX, 1,
+                          [&] { return ina228.getDieTemperatureMilliCelsius(); },
+                          [&] { return ina228.getDieTemperature(); });
+        checkCodeDecoding(model, "CURRENT", {INA228Model::CURRENT, 20, 4},
+                          {MaximumCurrentMicroAmperes, CurrentDenominator, 1e6L}, Signed20BitMinimum,
+                          Signed20BitMaximum, 5, [&] { return ina228.getCurrentMicroAmperes(); },
+                          [&] { return ina228.getCurrent(); });
+        checkCodeDecoding(model, "POWER", {INA228Model::POWER, 24, 0},
+                          {MaximumCurrentMicroAmperes * 16, 5 * CurrentDenominator, 1e6L}, 0, (int64_t{1} << 24) - 1,
+                          97, [&] { return ina228.getPowerMicroWatts(); }, [&] { return ina228.getPower(); });
+        checkCodeDecoding(model, "ENERGY", {INA228Model::ENERGY, 40, 0},
+                          {MaximumCurrentMicroAmperes * 256, 5 * CurrentDenominator, 1e6L}, 0, (int64_t{1} << 40) - 1,
+                          16'777'259, [&] { return ina228.getEnergyMicroJoules(); },
+                          [&] { return ina228.getEnergy(); });
+
+        ina228.configureADC(INA228::ADCMode::ContinuousAll, INA228::ConversionTime::Time1052us,
+                            INA228::ConversionTime::Time1052us, INA228::ConversionTime::Time1052us,
+                            INA228::AveragingCount::Samples1);
+        check(ina228.resetAccumulators().has_value(), "accumulators reset after the decoding checks");
+        vTaskDelay(2 * DefaultConversionTicks);
+    }
+
+    void checkSchedulerStart() {
+        HostKernel &kernel = HostKernel::instance();
+        StaticSemaphore_t semaphoreBuffer;
+
+        check(xTaskGetSchedulerState() == taskSCHEDULER_NOT_STARTED, "scheduler not started");
+
+        // As on the Cortex-M7 port, the critical section of the semaphore creation leaves the interrupts masked
+        const SemaphoreHandle_t Semaphore = xSemaphoreCreateBinaryStatic(&semaphoreBuffer);
+        kernel.schedule(0, [Semaphore] { xSemaphoreGiveFromISR(Semaphore, nullptr); });
+        kernel.advance(1000);
+
+        check(xSemaphoreTake(Semaphore, 0) == pdFALSE, "interrupts masked before the scheduler starts");
+
+        kernel.startScheduler();
+
+        check(xTaskGetSchedulerState() == taskSCHEDULER_RUNNING, "scheduler running");
+        check(xSemaphoreTake(Semaphore, 1) == pdTRUE, "pending interrupt taken once the scheduler starts");
+    }
+
+    void checkInitialization(const INA228 &ina228, const INA228 &second) {
+        // The instances are constructed before the scheduler starts, as global instances are on the target
+        check(HostTWIHS::instance().getStatistics().transfers == 0, "construction does not access the bus");
+
+        const auto Early = ina228.init();
+        check(not Early and (Early.error() == INA228::Error::SchedulerNotStarted),
+              "init before the scheduler starts refused");
+        check(not ina228.isTransferPending() and (HostTWIHS::instance().getStatistics().transfers == 0),
+              "init before the scheduler starts does not access the bus");
+
+        checkSchedulerStart();
+
+        check(ina228.init().has_value(), "init after the scheduler starts");
+        check(second.init().has_value(), "init of the second monitor");
+    }
+
+    void checkConfiguration(const INA228Model &model) {
+        check(model.getRegister(INA228Model::CONFIG) == 0x0000, "CONFIG written with ADCRANGE = 0");
+        check(model.getRegister(INA228Model::ADC_CONFIG) == 0xFB68, "ADC_CONFIG written with continuous conversions");
+        check(model.getRegister(INA228Model::SHUNT_CAL) == 1250, "SHUNT_CAL written for 1 A and 50 mOhm");
+    }
+
+    void checkReadAll(INA228Model &model, const INA228 &ina228) {
+        model.setShuntCurrent(0.25);
+        model.setBusVoltage(3.3);
+        model.setDieTemperature(40.0);
+        vTaskDelay(2 * DefaultConversionTicks);
+
+        const TickType_t Before = xTaskGetTickCount();
+        const auto Snapshot = ina228.readAll();
+
+        check(Snapshot.has_value(), "readAll succeeds");
+        if (not Snapshot) {
+            return;
+        }
+
+        check(std::fabs(Snapshot->current - 0.25) < 7e-6, "readAll current");
+        check(std::fabs(Snapshot->shuntVoltage - 12.5) < 313e-6, "readAll shunt voltage");
+        check(std::fabs(Snapshot->busVoltage - 3.3) < 196e-6, "readAll bus voltage");
+        check(std::fabs(Snapshot->dieTemperature - 40.0) < 7.9e-3, "readAll die temperature");
+        check(std::fabs(Snapshot->power - 0.825) < 1e-4, "readAll power");
+        check(Snapshot->timestamp == Before, "readAll timestamp taken before the reads");
+    }
+
+    void checkAccumulators(INA228Model &model, const INA228 &ina228) {
+        model.setShuntCurrent(0.5);
+        model.setBusVoltage(10.0);
+        vTaskDelay(2 * DefaultConversionTicks);
+
+        check(ina228.resetAccumulators().has_value(), "resetAccumulators succeeds");
+        check(model.getRegister(INA228Model::ENERGY) == 0, "RSTACC clears ENERGY");
+        check(model.getRegister(INA228Model::CHARGE) == 0, "RSTACC clears CHARGE");
+
+        const uint64_t ConversionsBefore = model.getConversionsNumber();
+
+        INA228Accumulator accumulator(ina228);
+        check(accumulator.update().has_value(), "INA228Accumulator first update");
+
+        vTaskDelay(pdMS_TO_TICKS(1000));
+
+        // The accumulators integrate over the conversions, which are not aligned to the ticks
+        const double ConversionSeconds = model.getConversionPeriodMicroSeconds() * 1e-6;
+        const double Seconds = static_cast<double>(model.getConversionsNumber() - ConversionsBefore) *
+                               ConversionSeconds;
+
+        check(isNear(ina228.getEnergy(), 5.0 * Seconds, 5.0 * Seconds * 1e-4), "getEnergy after 1 s at 5 W");
+        check(isNear(ina228.getEnergyMicroJoules(), 5e6 * Seconds, 5e6 * Seconds * 1e-4),
+              "getEnergyMicroJoules after 1 s at 5 W");
+        check(isNear(ina228.getCharge(), 0.5 * Seconds, 0.5 * Seconds * 1e-4), "getCharge after 1 s at 0.5 A");
+
+        // The first update of the accumulator may follow a conversion after the reset
+        check(accumulator.update().has_value(), "INA228Accumulator update");
+        check(std::fabs(static_cast<double>(accumulator.getEnergyMicroJoules()) - 5e6 * Seconds) <=
+              5e6 * ConversionSeconds + 5e6 * Seconds * 1e-4, "INA228Accumulator energy total");
+        check(std::fabs(static_cast<double>(accumulator.getChargeMicroCoulombs()) - 5e5 * Seconds) <=
+              5e5 * ConversionSeconds + 5e5 * Seconds * 1e-4, "INA228Accumulator charge total");
+    }
+
+    struct AsyncResult {
+        uint32_t calls = 0;
+        bool succeeded = false;
+    };
+
+    void asyncCallback(etl::expected<void, INA228::Error> result, uintptr_t context) {
+        auto *asyncResult = reinterpret_cast<AsyncResult *>(context);
+        asyncResult->calls++;
+        asyncResult->succeeded = result.has_value();
+    }
+
+    void checkAsyncRead(INA228Model &model, const INA228 &ina228) {
+        model.setShuntCurrent(-0.125);
+        vTaskDelay(2 * DefaultConversionTicks);
+
+        etl::array<uint8_t, 3> data{};
+        AsyncResult result;
+
+        const auto Started = ina228.readRegisterAsync(INA228::RegisterAddress::CURRENT, data, asyncCallback,
+                                                      reinterpret_cast<uintptr_t>(&result));
+
+        check(Started.has_value(), "readRegisterAsync starts");
+        check(ina228.isTransferPending() and (result.calls == 0), "readRegisterAsync returns before the completion");
+
+        const auto Second = ina228.readRegisterAsync(INA228::RegisterAddress::VBUS, data);
+        check(not Second and (Second.error() == INA228::Error::TransferPending), "second read while pending refused");
+
+        check(ina228.waitForTransfer().has_value(), "waitForTransfer succeeds");
+        check((result.calls == 1) and result.succeeded, "completion callback called once");
+
+        const auto Current = INA228FixedPoint::decodeSigned20Bit(INA228FixedPoint::decodeBigEndian<3, uint32_t>(data));
+        check(Current == -(int32_t{1} << 16), "asynchronously read CURRENT register");
+    }
+
+    void checkContinuousSampling(INA228Model &model, INA228 &ina228) {
+        constexpr uint8_t SamplesNumber = 20;
+
+        model.setShuntCurrent(0.3);
+        model.setBusVoltage(28.0);
+
+        check(ina228.startContinuousSampling(AlertPin, xTaskGetCurrentTaskHandle()).has_value(),
+              "startContinuousSampling succeeds");
+
+        bool serviced = true;
+        for (uint8_t i = 0; i < SamplesNumber; i++) {
+            serviced = serviced and ina228.serviceConversionReady(pdMS_TO_TICKS(20)).has_value();
+        }
+        check(serviced, "serviceConversionReady on every conversion");
+
+        uint8_t samples = 0;
+        bool accurate = true;
+        while (const auto Sample = ina228.getSample()) {
+            samples++;
+            accurate = accurate and (std::fabs(Sample->current - 0.3) < 7e-6) and
+                       (std::fabs(Sample->busVoltage - 28.0) < 196e-6);
+        }
+        check(samples == SamplesNumber, "one sample per conversion");
+        check(accurate, "continuous sampling values");
+        check(ina228.getMissedConversions() == 0, "no missed conversion at the default ADC configuration");
+
+        check(ina228.stopContinuousSampling().has_value(), "stopContinuousSampling succeeds");
+        check((model.getRegister(INA228Model::DIAG_ALRT) & 0xC000) == 0, "conversion ready alert disabled");
+
+        // With 150 us conversions, a readout of 880 us at 400 kHz lets most conversions complete while the latched
+        // ALERT pin is asserted, which makes no edge
+        constexpr uint64_t LateSamplesNumber = 50;
+        constexpr uint64_t TwoTicksConversions = 2 * HostKernel::TickMicroSeconds / 150;
+
+        check(ina228.configureADC(INA228::ADCMode::ContinuousAll, INA228::ConversionTime::Time50us,
+                                  INA228::ConversionTime::Time50us, INA228::ConversionTime::Time50us,
+                                  INA228::AveragingCount::Samples1).has_value(), "fast ADC configuration");
+        check(ina228.startContinuousSampling(AlertPin, xTaskGetCurrentTaskHandle()).has_value(),
+              "startContinuousSampling with a late sampling task");
+
+        const uint64_t ConversionsBefore = model.getConversionsNumber();
+        serviced = true;
+        for (uint64_t i = 0; i < LateSamplesNumber; i++) {
+            serviced = serviced and ina228.serviceConversionReady(pdMS_TO_TICKS(20)).has_value();
+        }
+        const uint64_t Conversions = model.getConversionsNumber() - ConversionsBefore;
+
+        uint64_t lateSamples = 0;
+        while (ina228.getSample()) {
+            lateSamples++;
+        }
+        const uint64_t Counted = lateSamples + ina228.getMissedConversions();
+
+        check(serviced, "serviceConversionReady with a late sampling task");
+        check((Counted <= Conversions) and (Conversions - Counted <= TwoTicksConversions),
+              "unsignalled conversions counted as missed");
+
+        check(ina228.stopContinuousSampling().has_value(), "stopContinuousSampling with a late sampling task");
+        check(ina228.configureADC(INA228::ADCMode::ContinuousAll, INA228::ConversionTime::Time1052us,
+                                  INA228::ConversionTime::Time1052us, INA228::ConversionTime::Time1052us,
+                                  INA228::AveragingCount::Samples1).has_value(), "default ADC configuration restored");
+    }
+
+    void limitAlertCallback(uintptr_t context) {
+        (*reinterpret_cast<uint32_t *>(context))++;
+    }
+
+    void checkLimitAlert(INA228Model &model, INA228 &ina228) {
+        uint32_t alerts = 0;
+
+        model.setShuntCurrent(0.5);
+        check(ina228.setOvercurrentLimit(800'000).has_value(), "setOvercurrentLimit succeeds");
+        check(model.getRegister(INA228Model::SOVL) == 8000, "SOVL for 800 mA through 50 mOhm");
+        check(ina228.enableAlert(AlertPin, limitAlertCallback, reinterpret_cast<uintptr_t>(&alerts)).has_value(),
+              "enableAlert succeeds");
+
+        vTaskDelay(2 * DefaultConversionTicks);
+        check(alerts == 0, "no alert below the limit");
+
+        model.setShuntCurrent(0.9);
+        vTaskDelay(2 * DefaultConversionTicks);
+        check(alerts == 1, "latched alert called once above the limit");
+
+        const auto Flags = ina228.readDiagnosticFlags();
+        check(Flags.has_value() and ((Flags.value() & static_cast<INA228::DiagnosticAlert_t>(
+                INA228::DiagnosticAlert::SHNTOL)) != 0), "SHNTOL flag read");
+        check(not model.isAlertAsserted(), "reading DIAG_ALRT releases the latched ALERT pin");
+
+        model.setShuntCurrent(0.5);
+        vTaskDelay(2 * DefaultConversionTicks);
+        check(ina228.disableAlert().has_value(), "disableAlert succeeds");
+        check(ina228.setShuntVoltageLimits(INT16_MAX * 5000, INT16_MIN * 5000).has_value(), "limits restored");
+        check(alerts == 1, "no alert after the current returns below the limit");
+    }
+
+    void checkBusErrors(INA228Model &model, const INA228 &ina228) {
+        model.setShuntCurrent(0.1);
+        HostLogEntry::Enabled = false;
+
+        const INA228 absent(AbsentAddress);
+        const auto NotAcknowledged = absent.getCurrent();
+
+        HostTWIHS::instance().stallTransfers(1);
+        const uint64_t Start = HostKernel::instance().getTimeMicroSeconds();
+        const auto TimedOut = ina228.getCurrent();
+        const uint64_t Waited = HostKernel::instance().getTimeMicroSeconds() - Start;
+
+        HostLogEntry::Enabled = true;
+
+        check(not NotAcknowledged and (NotAcknowledged.error() == INA228::Error::NACK), "absent device NACK");
+        check(not TimedOut and (TimedOut.error() == INA228::Error::Timeout), "stalled transfer timeout");
+        check((Waited >= 9000) and (Waited <= 11000), "timeout after TransferTimeout");
+        check(not HostTWIHS::instance().isBusy(), "TWIHS reinitialized after the timeout");
+        check(isNear(ina228.getCurrent(), 0.1, 7e-6), "transfer after the timeout succeeds");
+    }
+
+    void checkAutoTune(INA228Model &model, INA228 &ina228) {
+        // 10 μV at 50 μs needs an integration time of 50 μs * (10 μV / 1 μV)^2 = 5 ms for a 1 μV noise
+        constexpr uint32_t TargetNoiseNanoVolts = 1000;
+
+        model.setShuntCurrent(0.5);
+        model.setShuntNoise(10'000.0);
+
+        const auto Tuning = ina228.autoTuneADC(50'000, TargetNoiseNanoVolts);
+
+        model.setShuntNoise(0.0);
+
+        check(Tuning.has_value(), "autoTuneADC succeeds");
+        if (not Tuning) {
+            return;
+        }
+
+        const uint32_t IntegrationMicroSeconds = AveragingCounts[static_cast<uint8_t>(Tuning->averagingCount)] *
+                                                 ConversionTimesMicroSeconds[static_cast<uint8_t>(
+                                                         Tuning->conversionTime)];
+
+        check(Tuning->meetsNoiseTarget and (Tuning->shuntNoiseNanoVolts <= TargetNoiseNanoVolts),
+              "autoTuneADC meets the noise target");
+        check(Tuning->conversionPeriodMicroSeconds <= 50'000, "autoTuneADC fits in the sample period");
+        check(model.getConversionPeriodMicroSeconds() == Tuning->conversionPeriodMicroSeconds,
+              "autoTuneADC writes the selected configuration");
+        check(IntegrationMicroSeconds >= 2'500, "autoTuneADC integration time within the noise model");
+
+        check(ina228.configureADC(INA228::ADCMode::ContinuousAll, INA228::ConversionTime::Time1052us,
+                                  INA228::ConversionTime::Time1052us, INA228::ConversionTime::Time1052us,
+                                  INA228::AveragingCount::Samples1).has_value(), "default ADC configuration restored");
+    }
+
+    void checkPoller(INA228Model &model, INA228Model &secondModel, const INA228 &ina228, const INA228 &second) {
+        model.setShuntCurrent(0.2);
+        secondModel.setShuntCurrent(-0.4);
+        vTaskDelay(2 * DefaultConversionTicks);
+
+        INA228Poller poller;
+        const auto MainIndex = poller.registerMonitor(ina228, pdMS_TO_TICKS(10));
+        const auto SecondIndex = poller.registerMonitor(second, pdMS_TO_TICKS(25));
+
+        check(MainIndex.has_value() and SecondIndex.has_value(), "INA228Poller registers two monitors");
+
+        const TickType_t End = xTaskGetTickCount() + pdMS_TO_TICKS(100);
+        while (static_cast<int32_t>(End - xTaskGetTickCount()) > 0) {
+            vTaskDelay(poller.poll());
+        }
+
+        const auto Main = poller.getLatest(MainIndex.value());
+        const auto Second = poller.getLatest(SecondIndex.value());
+
+        check(Main.has_value() and (std::fabs(Main->snapshot.current - 0.2) < 7e-6) and (Main->readErrors == 0),
+              "INA228Poller latest value of the first monitor");
+        check(Second.has_value() and (std::fabs(Second->snapshot.current + 0.4) < 7e-6) and
+              (Second->readErrors == 0), "INA228Poller latest value of the second monitor");
+    }
+
+    /**
+     * Measures an operation repeated in the task, in virtual and in host time.
+     */
+    template<typename OPERATION>
+    void benchmark(const char *name, uint32_t iterations, OPERATION operation) {
+        HostKernel &kernel = HostKernel::instance();
+        const uint64_t BusTransfersBefore = HostTWIHS::instance().getStatistics().transfers;
+        const uint64_t VirtualStart = kernel.getTimeMicroSeconds();
+        const auto HostStart = std::chrono::steady_clock::now();
+
+        uint32_t failures = 0;
+        for (uint32_t i = 0; i < iterations; i++) {
+            if (not operation()) {
+                failures++;
+            }
+        }
+
+        const auto HostNanoSeconds = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                std::chrono::steady_clock::now() - HostStart).count();
+        const auto VirtualMicroSeconds = static_cast<double>(kernel.getTimeMicroSeconds() - VirtualStart);
+        const uint64_t Transfers = HostTWIHS::instance().getStatistics().transfers - BusTransfersBefore;
+
+        std::printf("  %-44s %9.1f us %10.0f /s %9.1f transfers %8.0f ns host %s\n", name,
+                    VirtualMicroSeconds / iterations, iterations * 1e6 / VirtualMicroSeconds,
+                    static_cast<double>(Transfers) / iterations, static_cast<double>(HostNanoSeconds) / iterations,
+                    (failures == 0) ? "" : "(failures)");
+    }
+
+    /**
+     * Function that reads the host cycle counter: the time stamp counter on x86-64, the steady clock in nanoseconds
+     * elsewhere.
+     */
+    uint64_t readHostCycles() {
+#if defined(__x86_64__)
+        return __rdtsc();
+#else
+        return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                std::chrono::steady_clock::now().time_since_epoch()).count());
+#endif
+    }
+
+    /**
+     * Measures the host cycles of an operation, the lowest mean of several batches, to leave out the interruptions of
+     * the host.
+     */
+    template<typename OPERATION>
+    double measureHostCycles(uint32_t iterations, OPERATION operation) {
+        constexpr uint32_t Batches = 25;
+        double lowest = 0;
+
+        for (uint32_t batch = 0; batch < Batches; batch++) {
+            const uint64_t Start = readHostCycles();
+
+            for (uint32_t i = 0; i < iterations; i++) {
+                static_cast<void>(operation());
+            }
+
+            const double Mean = static_cast<double>(readHostCycles() - Start) / iterations;
+            lowest = ((batch == 0) or (Mean < lowest)) ? Mean : lowest;
+        }
+
+        return lowest;
+    }
+
+    /**
+     * Measures the host cycles per conversion of the floating-point and fixed-point conversions of each result
+     * register, over a buffer of random register values.
+     */
+    void benchmarkConversions(const INA228 &ina228) {
+        constexpr uint32_t Iterations = 20;
+        constexpr size_t ValuesNumber = 4096;
+
+        std::array<uint64_t, ValuesNumber> values{};
+        std::mt19937_64 generator(1);
+        for (auto &value: values) {
+            value = generator();
+        }
+
+        // The results are summed into a volatile so that the conversions are not optimized out
+        volatile double sink = 0;
+        auto measure = [&](auto conversion) {
+            return measureHostCycles(Iterations, [&] {
+                double sum = 0;
+                for (const uint64_t Value: values) {
+                    sum += static_cast<double>(conversion(Value));
+                }
+                sink = sink + sum;
+                return true;
+            }) / ValuesNumber;
+        };
+
+        constexpr uint64_t Mask16Bit = 0xFFFF;
+        constexpr uint64_t Mask24Bit = 0xFF'FFFF;
+        constexpr uint64_t Mask40Bit = 0xFF'FFFF'FFFF;
+
+#if defined(__x86_64__)
+        constexpr const char *Unit = "TSC cycles";
+#else
+        constexpr const char *Unit = "nanoseconds";
+#endif
+        std::printf("\nConversions of register values, host %s per conversion\n", Unit);
+        std::printf("  %-10s %14s %14s\n", "register", "floating-point", "fixed-point");
+
+        auto print = [](const char *name, double floatCycles, double fixedCycles) {
+            std::printf("  %-10s %14.2f %14.2f\n", name, floatCycles, fixedCycles);
+        };
+
+        print("VSHUNT",
+              measure([&](uint64_t value) { return ina228.convertShuntVoltage(value & Mask24Bit); }),
+              measure([&](uint64_t value) { return ina228.convertShuntVoltageNanoVolts(value & Mask24Bit); }));
+        print("VBUS",
+              measure([&](uint64_t value) { return ina228.convertVoltage(value & Mask24Bit); }),
+              measure([&](uint64_t value) { return ina228.convertVoltageMicroVolts(value & Mask24Bit); }));
+        print("DIETEMP",
+              measure([&](uint64_t value) { return ina228.convertDieTemperature(value & Mask16Bit); }),
+              measure([&](uint64_t value) { return ina228.convertDieTemperatureMilliCelsius(value & Mask16Bit); }));
+        print("CURRENT",
+              measure([&](uint64_t value) { return ina228.convertCurrent(value & Mask24Bit); }),
+              measure([&](uint64_t value) { return ina228.convertCurrentMicroAmperes(value & Mask24Bit); }));
+        print("POWER",
+              measure([&](uint64_t value) { return ina228.convertPower(value & Mask24Bit); }),
+              measure([&](uint64_t value) { return ina228.convertPowerMicroWatts(value & Mask24Bit); }));
+        print("ENERGY",
+              measure([&](uint64_t value) { return ina228.convertEnergy(value & Mask40Bit); }),
+              measure([&](uint64_t value) { return ina228.convertEnergyMicroJoules(value & Mask40Bit); }));
+    }
+
+    void runBenchmarks(INA228Model &model, INA228 &ina228) {
+        constexpr uint32_t Iterations = 2000;
+
+        // The computation of the task between two reads, overlapped with the transfer by the asynchronous path
+        constexpr uint64_t TaskWorkMicroSeconds = 150;
+
+        HostKernel &kernel = HostKernel::instance();
+        model.setShuntCurrent(0.6);
+        model.setBusVoltage(12.0);
+
+        for (const uint32_t ClockHz: {100'000U, 400'000U, 1'000'000U}) {
+            HostTWIHS::instance().setClockFrequency(ClockHz);
+
+            std::printf("\nSCL %u kHz %35s per operation, operations per second of bus time\n", ClockHz / 1000, "");
+
+            benchmark("getCurrent", Iterations, [&] { return ina228.getCurrent().has_value(); });
+            benchmark("getCurrentMicroAmperes", Iterations, [&] {
+                return ina228.getCurrentMicroAmperes().has_value();
+            });
+            benchmark("readAll", Iterations, [&] { return ina228.readAll().has_value(); });
+            benchmark("getEnergy", Iterations, [&] { return ina228.getEnergy().has_value(); });
+
+            etl::array<uint8_t, 3> data{};
+            benchmark("readRegisterAsync + waitForTransfer", Iterations, [&] {
+                return ina228.readRegisterAsync(INA228::RegisterAddress::CURRENT, data).has_value() and
+                       ina228.waitForTransfer().has_value();
+            });
+
+            benchmark("getCurrent, then 150 us of task work", Iterations, [&] {
+                const bool Read = ina228.getCurrent().has_value();
+                kernel.advance(TaskWorkMicroSeconds);
+                return Read;
+            });
+            benchmark("readRegisterAsync, 150 us of task work, wait", Iterations, [&] {
+                const bool Started = ina228.readRegisterAsync(INA228::RegisterAddress::CURRENT, data).has_value();
+                kernel.advance(TaskWorkMicroSeconds);
+                return Started and ina228.waitForTransfer().has_value();
+            });
+        }
+
+        HostTWIHS::instance().setClockFrequency(400'000);
+
+        benchmarkConversions(ina228);
+
+        std::printf("\nContinuous sampling at SCL 400 kHz, 1 s of conversions\n");
+
+        for (const auto ConversionTime: {INA228::ConversionTime::Time1052us, INA228::ConversionTime::Time280us,
+                                         INA228::ConversionTime::Time150us, INA228::ConversionTime::Time50us}) {
+            ina228.configureADC(INA228::ADCMode::ContinuousAll, ConversionTime, ConversionTime, ConversionTime,
+                                INA228::AveragingCount::Samples1);
+            // A conversion of the previous configuration can complete once the ALERT pin is attached, before the
+            // ADC_CONFIG write restarts the conversions, and is sampled
+            const uint64_t ConversionsBefore = model.getConversionsNumber();
+            ina228.startContinuousSampling(AlertPin, xTaskGetCurrentTaskHandle());
+
+            const uint64_t End = kernel.getTimeMicroSeconds() + 1'000'000;
+            uint32_t samples = 0;
+
+            while (kernel.getTimeMicroSeconds() < End) {
+                ina228.serviceConversionReady(pdMS_TO_TICKS(20));
+                while (ina228.getSample()) {
+                    samples++;
+                }
+            }
+
+            // The missed conversions that completed while the latched ALERT pin was asserted are counted from the
+            // elapsed ticks, so the count lags the device by up to two ticks of conversions
+            const uint64_t Conversions = model.getConversionsNumber() - ConversionsBefore;
+            const uint64_t Uncounted = Conversions - samples - ina228.getMissedConversions();
+            std::printf("  conversion period %5u us: %6llu conversions, %6u samples, %6u missed, %6llu uncounted\n",
+                        model.getConversionPeriodMicroSeconds(), static_cast<unsigned long long>(Conversions), samples,
+                        ina228.getMissedConversions(), static_cast<unsigned long long>(Uncounted));
+
+            ina228.stopContinuousSampling();
+        }
+
+        ina228.configureADC(INA228::ADCMode::ContinuousAll, INA228::ConversionTime::Time1052us,
+                            INA228::ConversionTime::Time1052us, INA228::ConversionTime::Time1052us,
+                            INA228::AveragingCount::Samples1);
+    }
+}
+
+int main(int argc, char **argv) {
+    const bool Benchmark = (argc > 1) and (std::strcmp(argv[1], "--benchmark") == 0);
+
+    INA228Model model(AlertPin);
+    INA228Model secondModel(PIO_PIN_NONE, 2);
+    HostTWIHS::instance().attach(toAddress(MainAddress), model);
+    HostTWIHS::instance().attach(toAddress(SecondAddress), secondModel);
+
+    INA228 ina228(MainAddress, INA228DefaultConfiguration{});
+    const INA228 second(SecondAddress, INA228DefaultConfiguration{});
+
+    checkInitialization(ina228, second);
+
+    checkConfiguration(model);
+    checkMeasurements(model, ina228, 0.75, 12.0, 31.25);
+    checkMeasurements(model, ina228, -0.5, 5.0, -12.5);
+    checkMeasurements(model, ina228, 0.0, 0.0, 25.0);
+    checkMeasurements(model, ina228, 0.999, 85.0, 125.0);
+    checkMeasurements(model, ina228, -1.0, 0.5, -40.0);
+    checkFixedPointDecoding(model, ina228);
+    checkReadAll(model, ina228);
+    checkAccumulators(model, ina228);
+    checkAsyncRead(model, ina228);
+    checkContinuousSampling(model, ina228);
+    checkLimitAlert(model, ina228);
+    checkBusErrors(model, ina228);
+    checkAutoTune(model, ina228);
+    checkPoller(model, secondModel, ina228, second);
+
+    std::printf("\n%u checks, %u failed\n", checksNumber, failedChecksNumber);
+
+    if (Benchmark) {
+        runBenchmarks(model, ina228);
+    }
+
+    return (failedChecksNumber == 0) ? 0 : 1;
+}
@@ -0,0 +1,351 @@
+#include "INA228Model.hpp"
+#include <algorithm>
+#include <cmath>
+#include "HostPIO.hpp"
+
+namespace {
+    /**
+     * The LSB of the VSHUNT register, for ADCRANGE = 0 and ADCRANGE = 1 (in nanoVolts).
+     */
+    constexpr double ShuntVoltageLSBNanoVolts = 312.5;
+    constexpr double ShuntVoltageLSBNanoVoltsRange1 = 78.125;
+
+    /**
+     * The LSB of the VBUS register (in Volts).
+     */
+    constexpr double BusVoltageLSB = 195.3125e-6;
+
+    /**
+     * The LSB of the DIETEMP register (in Celsius).
+     */
+    constexpr double DieTemperatureLSB = 7.8125e-3;
+
+    /**
+     * The ratio of a SOVL, SUVL, BOVL or BUVL LSB to a VSHUNT or VBUS LSB.
+     */
+    constexpr int64_t VoltageLimitLSBs = 16;
+
+    /**
+     * The ratio of a PWR_LIMIT LSB to a POWER LSB.
+     */
+    constexpr uint32_t PowerLimitShift = 8;
+
+    /**
+     * The step of the initial conversion delay of the CONVDLY field (in microseconds).
+     */
+    constexpr uint64_t ConversionDelayStepMicroSeconds = 2000;
+
+    constexpr int64_t Maximum20Bit = (int64_t{1} << 19) - 1;
+    constexpr int64_t Minimum20Bit = -(int64_t{1} << 19);
+    constexpr uint64_t Mask20Bit = (uint64_t{1} << 20) - 1;
+    constexpr double Range40Bit = 1099511627776.0;
+    constexpr uint64_t Mask40Bit = (uint64_t{1} << 40) - 1;
+
+    int64_t roundToRange(double value, int64_t minimum, int64_t maximum) {
+        return std::clamp(static_cast<int64_t>(std::llround(value)), minimum, maximum);
+    }
+
+    int64_t signExtend20(uint64_t value) {
+        const auto Value = static_cast<int64_t>(value & Mask20Bit);
+        return ((Value & (int64_t{1} << 19)) != 0) ? Value - (int64_t{1} << 20) : Value;
+    }
+}
+
+INA228Model::INA228Model(PIO_PIN alertPin, uint32_t seed) : AlertPin(alertPin), noiseGenerator(seed) {
+    reset();
+}
+
+INA228Model::~INA228Model() {
+    if (conversionEvent) {
+        HostKernel::instance().cancel(conversionEvent.value());
+    }
+}
+
+void INA228Model::reset() {
+    registers.fill(0);
+    registers[ADC_CONFIG] = 0xFB68;
+    registers[SHUNT_CAL] = 0x1000;
+    registers[DIAG_ALRT] = MemoryStatusMask;
+    registers[SOVL] = 0x7FFF;
+    registers[SUVL] = 0x8000;
+    registers[BOVL] = 0x7FFF;
+    registers[TEMP_LIMIT] = 0x7FFF;
+    registers[PWR_LIMIT] = 0xFFFF;
+    registers[MANUFACTURER_ID] = 0x5449;
+    registers[DEVICE_ID] = 0x2281;
+
+    registerPointer = CONFIG;
+    energyAccumulator = 0.0;
+    chargeAccumulator = 0.0;
+
+    setAlert(false);
+    restartConversions();
+}
+
+uint32_t INA228Model::getConversionPeriodMicroSeconds() const {
+    const auto Value = static_cast<uint16_t>(registers[ADC_CONFIG]);
+    const uint16_t Mode = Value >> 12;
+    uint32_t period = 0;
+
+    if ((Mode & 0x1) != 0) {
+        period += ConversionTimesMicroSeconds[(Value >> 9) & 0x7];
+    }
+    if ((Mode & 0x2) != 0) {
+        period += ConversionTimesMicroSeconds[(Value >> 6) & 0x7];
+    }
+    if ((Mode & 0x4) != 0) {
+        period += ConversionTimesMicroSeconds[(Value >> 3) & 0x7];
+    }
+
+    return period * AveragingCounts[Value & 0x7];
+}
+
+bool INA228Model::write(std::span<const uint8_t> data) {
+    if (data.empty()) {
+        return true;
+    }
+
+    if (data[0] >= RegistersNumber) {
+        return false;
+    }
+
+    registerPointer = data[0];
+
+    if (data.size() >= 3) {
+        writeRegister(registerPointer, static_cast<uint16_t>((data[1] << 8) | data[2]));
+    }
+
+    return true;
+}
+
+bool INA228Model::read(std::span<uint8_t> data) {
+    const uint8_t Size = RegisterSizes[registerPointer];
+    const uint64_t Value = registers[registerPointer];
+
+    for (size_t i = 0; i < data.size(); i++) {
+        data[i] = (i < Size) ? static_cast<uint8_t>(Value >> (8 * (Size - 1 - i))) : 0;
+    }
+
+    if (registerPointer == DIAG_ALRT) {
+        uint64_t &diagnosticAlert = registers[DIAG_ALRT];
+        diagnosticAlert &= ~static_cast<uint64_t>(ConversionReadyMask);
+
+        if ((diagnosticAlert & AlertLatchMask) != 0) {
+            diagnosticAlert &= ~static_cast<uint64_t>(LimitFlagsMask);
+            setAlert(false);
+        }
+    } else if (registerPointer == ENERGY) {
+        registers[DIAG_ALRT] &= ~static_cast<uint64_t>(EnergyOverflowMask);
+    } else if (registerPointer == CHARGE) {
+        registers[DIAG_ALRT] &= ~static_cast<uint64_t>(ChargeOverflowMask);
+    }
+
+    return true;
+}
+
+void INA228Model::writeRegister(uint8_t address, uint16_t value) {
+    switch (address) {
+        case CONFIG:
+            if ((value & ConfigResetMask) != 0) {
+                reset();
+                return;
+            }
+
+            if ((value & ConfigResetAccumulatorsMask) != 0) {
+                energyAccumulator = 0.0;
+                chargeAccumulator = 0.0;
+                registers[ENERGY] = 0;
+                registers[CHARGE] = 0;
+                registers[DIAG_ALRT] &= ~static_cast<uint64_t>(EnergyOverflowMask | ChargeOverflowMask);
+            }
+
+            // RST and RSTACC read back as 0
+            registers[CONFIG] = value & ~(ConfigResetMask | ConfigResetAccumulatorsMask);
+            break;
+        case ADC_CONFIG:
+            registers[ADC_CONFIG] = value;
+            restartConversions();
+            break;
+        case SHUNT_CAL:
+            registers[SHUNT_CAL] = value & 0x7FFF;
+            break;
+        case SHUNT_TEMPCO:
+            registers[SHUNT_TEMPCO] = value & 0x3FFF;
+            break;
+        case DIAG_ALRT:
+            registers[DIAG_ALRT] = (registers[DIAG_ALRT] & ~static_cast<uint64_t>(AlertConfigurationMask)) |
+                                   (value & AlertConfigurationMask);
+
+            // A transparent ALERT pin follows the limit flags, and a polarity change applies immediately
+            if ((value & AlertLatchMask) == 0) {
+                setAlert((registers[DIAG_ALRT] & LimitFlagsMask) != 0);
+            } else {
+                setAlert(alertAsserted);
+            }
+            break;
+        case SOVL:
+        case SUVL:
+        case BOVL:
+        case BUVL:
+        case TEMP_LIMIT:
+        case PWR_LIMIT:
+            registers[address] = value;
+            break;
+        default:
+            // The result and identification registers are read-only
+            break;
+    }
+}
+
+void INA228Model::restartConversions() {
+    HostKernel &kernel = HostKernel::instance();
+
+    if (conversionEvent) {
+        kernel.cancel(conversionEvent.value());
+        conversionEvent.reset();
+    }
+
+    const uint32_t Period = getConversionPeriodMicroSeconds();
+
+    if (Period == 0) {
+        return;
+    }
+
+    const uint64_t Delay = ((registers[CONFIG] >> 6) & 0xFF) * ConversionDelayStepMicroSeconds;
+
+    conversionEvent = kernel.schedule(Delay + Period, [this] { completeConversion(); });
+}
+
+void INA228Model::completeConversion() {
+    conversionEvent.reset();
+
+    const auto Value = static_cast<uint16_t>(registers[ADC_CONFIG]);
+    const uint16_t Mode = Value >> 12;
+    const uint32_t Period = getConversionPeriodMicroSeconds();
+    const uint32_t AveragingCount = AveragingCounts[Value & 0x7];
+
+    if ((Mode & 0x2) != 0) {
+        const bool ADCRange1 = (registers[CONFIG] & ConfigADCRangeMask) != 0;
+        const double LSB = ADCRange1 ? ShuntVoltageLSBNanoVoltsRange1 : ShuntVoltageLSBNanoVolts;
+        const double IntegrationMicroSeconds = AveragingCount * ConversionTimesMicroSeconds[(Value >> 6) & 0x7];
+        const double Noise = shuntNoiseNanoVolts / std::sqrt(IntegrationMicroSeconds / 50.0) *
+                             noiseDistribution(noiseGenerator);
+        const double ShuntVoltageNanoVolts = shuntCurrent * shuntResistance * 1e9 + Noise;
+
+        const int64_t ShuntVoltage = roundToRange(ShuntVoltageNanoVolts / LSB, Minimum20Bit, Maximum20Bit);
+        registers[VSHUNT] = (static_cast<uint64_t>(ShuntVoltage) & Mask20Bit) << 4;
+
+        // With SHUNT_CAL = 13107.2e6 * CURRENT_LSB * Rshunt (x4 for ADCRANGE = 1), CURRENT = VSHUNT * 4096 / SHUNT_CAL
+        const auto ShuntCal = static_cast<int64_t>(registers[SHUNT_CAL]);
+        const int64_t Current = (ShuntCal == 0) ? 0 : std::clamp(ShuntVoltage * 4096 / ShuntCal, Minimum20Bit,
+                                                                 Maximum20Bit);
+        registers[CURRENT] = (static_cast<uint64_t>(Current) & Mask20Bit) << 4;
+    }
+
+    if ((Mode & 0x1) != 0) {
+        const int64_t BusVoltage = roundToRange(busVoltage / BusVoltageLSB, 0, Maximum20Bit);
+        registers[VBUS] = static_cast<uint64_t>(BusVoltage) << 4;
+    }
+
+    if ((Mode & 0x4) != 0) {
+        const int64_t Temperature = roundToRange(dieTemperature / DieTemperatureLSB, INT16_MIN, INT16_MAX);
+        registers[DIETEMP] = static_cast<uint64_t>(Temperature) & 0xFFFF;
+    }
+
+    // POWER = 3.2 * CURRENT_LSB units, from the latest CURRENT and VBUS results
+    const int64_t Current = signExtend20(registers[CURRENT] >> 4);
+    const auto BusVoltage = static_cast<int64_t>(registers[VBUS] >> 4);
+    registers[POWER] = static_cast<uint64_t>(std::min<int64_t>(std::abs(Current) * BusVoltage / 16384, 0xFFFFFF));
+
+    uint64_t &diagnosticAlert = registers[DIAG_ALRT];
+    const double PeriodSeconds = Period * 1e-6;
+
+    energyAccumulator += static_cast<double>(registers[POWER]) * PeriodSeconds / 16.0;
+    if (energyAccumulator >= Range40Bit) {
+        energyAccumulator -= Range40Bit;
+        diagnosticAlert |= EnergyOverflowMask;
+    }
+    registers[ENERGY] = static_cast<uint64_t>(energyAccumulator) & Mask40Bit;
+
+    chargeAccumulator += static_cast<double>(Current) * PeriodSeconds;
+    if (std::abs(chargeAccumulator) >= Range40Bit / 2) {
+        chargeAccumulator -= std::copysign(Range40Bit, chargeAccumulator);
+        diagnosticAlert |= ChargeOverflowMask;
+    }
+    registers[CHARGE] = static_cast<uint64_t>(static_cast<int64_t>(chargeAccumulator)) & Mask40Bit;
+
+    // Latched limit flags are kept until DIAG_ALRT is read, transparent ones follow each conversion
+    const uint16_t LimitFlags = compareLimits();
+    if ((diagnosticAlert & AlertLatchMask) == 0) {
+        diagnosticAlert &= ~static_cast<uint64_t>(LimitFlagsMask);
+    }
+    diagnosticAlert |= LimitFlags | ConversionReadyMask;
+
+    conversionsNumber++;
+    updateAlert();
+
+    if ((Mode & 0x8) != 0) {
+        conversionEvent = HostKernel::instance().schedule(Period, [this] { completeConversion(); });
+    }
+}
+
+uint16_t INA228Model::compareLimits() const {
+    uint16_t flags = 0;
+
+    const int64_t ShuntVoltage = signExtend20(registers[VSHUNT] >> 4);
+    if (ShuntVoltage > static_cast<int16_t>(registers[SOVL]) * VoltageLimitLSBs) {
+        flags |= ShuntOverLimitMask;
+    }
+    if (ShuntVoltage < static_cast<int16_t>(registers[SUVL]) * VoltageLimitLSBs) {
+        flags |= ShuntUnderLimitMask;
+    }
+
+    const auto BusVoltage = static_cast<int64_t>(registers[VBUS] >> 4);
+    if (BusVoltage > static_cast<int64_t>(registers[BOVL] & 0x7FFF) * VoltageLimitLSBs) {
+        flags |= BusOverLimitMask;
+    }
+    if (BusVoltage < static_cast<int64_t>(registers[BUVL] & 0x7FFF) * VoltageLimitLSBs) {
+        flags |= BusUnderLimitMask;
+    }
+
+    if (static_cast<int16_t>(registers[DIETEMP]) > static_cast<int16_t>(registers[TEMP_LIMIT])) {
+        flags |= TemperatureOverLimitMask;
+    }
+
+    if ((registers[POWER] >> PowerLimitShift) > registers[PWR_LIMIT]) {
+        flags |= PowerOverLimitMask;
+    }
+
+    return flags;
+}
+
+void INA228Model::updateAlert() {
+    const uint64_t DiagnosticAlert = registers[DIAG_ALRT];
+    const bool LimitViolated = (DiagnosticAlert & LimitFlagsMask) != 0;
+    const bool ConversionReadyAlert = (DiagnosticAlert & ConversionReadyAlertMask) != 0;
+
+    if ((DiagnosticAlert & AlertLatchMask) != 0) {
+        if (LimitViolated or ConversionReadyAlert) {
+            setAlert(true);
+        }
+        return;
+    }
+
+    // A transparent conversion ready alert is a pulse
+    if (ConversionReadyAlert) {
+        setAlert(true);
+    }
+    setAlert(LimitViolated);
+}
+
+void INA228Model::setAlert(bool asserted) {
+    alertAsserted = asserted;
+
+    if (AlertPin == PIO_PIN_NONE) {
+        return;
+    }
+
+    // The ALERT pin is active low, unless APOL is set
+    const bool ActiveHigh = (registers[DIAG_ALRT] & AlertPolarityMask) != 0;
+    HostPIO::instance().setLevel(AlertPin, asserted == ActiveHigh);
+}
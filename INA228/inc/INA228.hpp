@@ -1,14 +1,18 @@
 #pragma once
 
+#include <cmath>
 #include <cstdint>
 #include <type_traits>
 #include <etl/utility.h>
 #include <etl/array.h>
 #include <etl/expected.h>
 #include <etl/span.h>
+#include <etl/optional.h>
+#include <etl/circular_buffer.h>
 #include "FreeRTOS.h"
 #include "Logger.hpp"
 #include "task.h"
+#include "semphr.h"
 #include "peripheral/pio/plib_pio.h"
 #include "Peripheral_Definitions.hpp"
 
@@ -25,6 +29,7 @@
 #define INA228_TWIHS_Read TWIHS0_Read
 #define INA228_TWIHS_Initialize TWIHS0_Initialize
 #define INA228_TWIHS_IsBusy TWIHS0_IsBusy
+#define INA228_TWIHS_CallbackRegister TWIHS0_CallbackRegister
 
 #elif INA228_TWI_PORT == 1
 
@@ -35,6 +40,7 @@
 #define INA228_TWIHS_Read TWIHS1_Read
 #define INA228_TWIHS_Initialize TWIHS1_Initialize
 #define INA228_TWIHS_IsBusy TWIHS1_IsBusy
+#define INA228_TWIHS_CallbackRegister TWIHS1_CallbackRegister
 
 #elif INA228_TWI_PORT == 2
 
@@ -46,8 +52,169 @@
 #define INA228_TWIHS_Read TWIHS2_Read
 #define INA228_TWIHS_Initialize TWIHS2_Initialize
 #define INA228_TWIHS_IsBusy TWIHS2_IsBusy
+#define INA228_TWIHS_CallbackRegister TWIHS2_CallbackRegister
 #endif
 
+/**
+ * Integer helpers of the INA228 register decoding and fixed-point conversions.
+ *
+ * @brief The helpers are pure and constexpr, so the decoding of the register values is checked at compile time,
+ * without the device.
+ */
+namespace INA228FixedPoint {
+/**
+ * Function that assembles the big-endian bytes of a register into a binary number.
+ *
+ * @tparam NUMBER_OF_BYTES The number of bytes of the register.
+ * @tparam T The type of the returned numeric value.
+ * @param bytes The bytes of the register, most significant first.
+ * @return The register value.
+ */
+template<size_t NUMBER_OF_BYTES, typename T = uint64_t>
+constexpr T decodeBigEndian(const etl::array<uint8_t, NUMBER_OF_BYTES> &bytes) {
+    static_assert(std::is_integral<T>::value, "Invalid template argument");
+    static_assert(NUMBER_OF_BYTES <= sizeof(T), "The register does not fit in the returned type");
+
+    T value = 0;
+
+    for (size_t i = 0; i < NUMBER_OF_BYTES; i++) {
+        value = static_cast<T>((value << 8) | bytes[i]);
+    }
+
+    return value;
+}
+
+static_assert(decodeBigEndian<2, uint16_t>(etl::array<uint8_t, 2>{0x12, 0x34}) == 0x1234);
+static_assert(decodeBigEndian<3, uint32_t>(etl::array<uint8_t, 3>{0x12, 0x34, 0x56}) == 0x123456);
+static_assert(decodeBigEndian<5>(etl::array<uint8_t, 5>{0x01, 0x02, 0x03, 0x04, 0x05}) == 0x01'0203'0405);
+
+/**
+ * Function that sign-extends the 16-bit value of the DIETEMP, SOVL, SUVL and TEMP_LIMIT registers.
+ *
+ * @param value The 16-bit register value.
+ * @return The signed 16-bit value.
+ */
+constexpr int32_t decodeSigned16Bit(uint16_t value) {
+    return ((value & 0x8000) != 0) ? static_cast<int32_t>(value) - 0x10000 : static_cast<int32_t>(value);
+}
+
+static_assert(decodeSigned16Bit(0x7FFF) == 0x7FFF);
+static_assert(decodeSigned16Bit(0x8000) == -0x8000);
+static_assert(decodeSigned16Bit(0xFFFF) == -1);
+/**
+ * @struct ScaleFactor
+ *
+ * An exact rational scale factor of the fixed-point conversions, reduced to its lowest terms.
+ */
+struct ScaleFactor {
+    int64_t numerator;
+    int64_t denominator;
+
+    /**
+     * Function that scales a register value by the factor, truncating toward zero.
+     */
+    [[nodiscard]] constexpr int64_t apply(int64_t value) const {
+        return value * numerator / denominator;
+    }
+};
+
+/**
+ * Function that reduces a scale factor to its lowest terms.
+ */
+constexpr ScaleFactor reduce(int64_t numerator, int64_t denominator) {
+    int64_t a = numerator;
+    int64_t b = denominator;
+
+    while (b != 0) {
+        const int64_t Remainder = a % b;
+        a = b;
+        b = Remainder;
+    }
+
+    return ScaleFactor{numerator / a, denominator / a};
+}
+
+/**
+ * The VSHUNT resolution for ADCRANGE = 0, 312.5 nV/LSB.
+ */
+inline constexpr ScaleFactor ShuntVoltageNanoVoltsRange0 = reduce(3125, 10);
+
+/**
+ * The VSHUNT resolution for ADCRANGE = 1, 78.125 nV/LSB.
+ */
+inline constexpr ScaleFactor ShuntVoltageNanoVoltsRange1 = reduce(78125, 1000);
+
+/**
+ * The VBUS resolution, 195.3125 μV/LSB.
+ */
+inline constexpr ScaleFactor BusVoltageMicroVolts = reduce(1953125, 10000);
+
+/**
+ * The DIETEMP resolution, 7.8125 m°C/LSB.
+ */
+inline constexpr ScaleFactor DieTemperatureMilliCelsius = reduce(78125, 10000);
+
+static_assert(ShuntVoltageNanoVoltsRange0.numerator == 625 and ShuntVoltageNanoVoltsRange0.denominator == 2);
+static_assert(ShuntVoltageNanoVoltsRange1.numerator == 625 and ShuntVoltageNanoVoltsRange1.denominator == 8);
+static_assert(BusVoltageMicroVolts.numerator == 3125 and BusVoltageMicroVolts.denominator == 16);
+static_assert(DieTemperatureMilliCelsius.numerator == 125 and DieTemperatureMilliCelsius.denominator == 16);
+
+/**
+ * The power LSB is 3.2 * CurrentLSB, i.e. MaximumExpectedCurrent * 16 / (5 * 2^19).
+ */
+inline constexpr ScaleFactor PowerLSBPerCurrentUnit = reduce(16, 5 * (int64_t{1} << 19));
+
+/**
+ * The energy LSB is 16 * 3.2 * CurrentLSB, i.e. MaximumExpectedCurrent * 256 / (5 * 2^19).
+ */
+inline constexpr ScaleFactor EnergyLSBPerCurrentUnit = reduce(256, 5 * (int64_t{1} << 19));
+
+/**
+ * Function that sign-extends the 20-bit value of the VSHUNT, VBUS and CURRENT registers.
+ *
+ * @param value The 24-bit register value.
+ * @return The signed 20-bit value.
+ */
+constexpr int32_t decodeSigned20Bit(uint32_t value) {
+    const auto Value = static_cast<int32_t>((value >> 4) & 0xFFFFF);
+
+    return ((Value & 0x80000) != 0) ? Value - 0x100000 : Value;
+}
+
+static_assert(decodeSigned20Bit(0x7FFFF0) == 0x7FFFF);
+static_assert(decodeSigned20Bit(0x800000) == -0x80000);
+static_assert(decodeSigned20Bit(0xFFFFF0) == -1);
+static_assert(decodeSigned20Bit(0x00001F) == 1);
+
+// Register values decoded to the driver units, from the resolutions of the datasheet
+static_assert(ShuntVoltageNanoVoltsRange0.apply(decodeSigned20Bit(0x7FFFF0)) == 163'839'687);
+static_assert(ShuntVoltageNanoVoltsRange1.apply(decodeSigned20Bit(0x800000)) == -40'960'000);
+static_assert(BusVoltageMicroVolts.apply(decodeSigned20Bit(0x500000)) == 64'000'000);
+static_assert(DieTemperatureMilliCelsius.apply(decodeSigned16Bit(0x0C80)) == 25'000);
+static_assert(DieTemperatureMilliCelsius.apply(decodeSigned16Bit(0xFF80)) == -1'000);
+
+/**
+ * The mask of the 40-bit ENERGY and CHARGE accumulator registers.
+ */
+inline constexpr uint64_t AccumulatorMask = (uint64_t{1} << 40) - 1;
+
+/**
+ * Function that sign-extends the 40-bit value of the CHARGE register.
+ *
+ * @param value The 40-bit register value.
+ * @return The signed 40-bit value.
+ */
+constexpr int64_t decodeSigned40Bit(uint64_t value) {
+    const auto Value = static_cast<int64_t>(value & AccumulatorMask);
+
+    return ((Value & (int64_t{1} << 39)) != 0) ? Value - (int64_t{1} << 40) : Value;
+}
+
+static_assert(decodeSigned40Bit(0x7F'FFFF'FFFF) == 0x7F'FFFF'FFFF);
+static_assert(decodeSigned40Bit(0x80'0000'0000) == -0x80'0000'0000);
+static_assert(decodeSigned40Bit(0xFF'FFFF'FFFF) == -1);
+} // namespace INA228FixedPoint
+
 /**
  * Class for interfacing with the INA228 Current Monitor.
  *
@@ -57,139 +224,796 @@
 class INA228 {
 public:
     /**
-     * @enum I2CAddress
+     * @enum I2CAddress
+     *
+     * Contains all the possible I2C addresses, that can be configured by the two address pins, A0 and A1.
+     */
+    enum class I2CAddress : uint16_t {
+        Address_1000000 = 0b100'0000, // A0 -> GND,  A1 -> GND
+        Address_1000001 = 0b100'0001, // A0 -> Vs,   A1 -> GND
+        Address_1000010 = 0b100'0010, // A0 -> SDA,  A1 -> GND
+        Address_1000011 = 0b100'0011, // A0 -> SCL,  A1 -> GND
+
+        Address_1000100 = 0b100'0100, // A0 -> GND,  A1 -> Vs
+        Address_1000101 = 0b100'0101, // A0 -> Vs,   A1 -> Vs
+        Address_1000110 = 0b100'0110, // A0 -> SDA,  A1 -> Vs
+        Address_1000111 = 0b100'0111, // A0 -> SCL,  A1 -> Vs
+
+        Address_1001000 = 0b100'1000, // A0 -> GND,  A1 -> SDA
+        Address_1001001 = 0b100'1001, // A0 -> Vs,   A1 -> SDA
+        Address_1001010 = 0b100'1010, // A0 -> SDA,  A1 -> SDA
+        Address_1001011 = 0b100'1011, // A0 -> SCL,  A1 -> SDA
+
+        Address_1001100 = 0b100'1100, // A0 -> GND,  A1 -> SCL
+        Address_1001101 = 0b100'1101, // A0 -> Vs,   A1 -> SCL
+        Address_1001110 = 0b100'1110, // A0 -> SDA,  A1 -> SCL
+        Address_1001111 = 0b100'1111, // A0 -> SCL,  A1 -> SCL
+    };
+
+    /**
+     * Underlying type of the RegisterAddress enum.
+     */
+    using RegisterAddress_t = uint8_t;
+
+    /**
+    * @enum RegisterAddress
+    *
+    * Contains the addresses of all the INA228 registers.
+    */
+    enum class RegisterAddress : RegisterAddress_t {
+        CONFIG = 0x00,
+        ADC_CONFIG = 0x01,
+        SHUNT_CAL = 0x02,
+        SHUNT_TEMPCO = 0x03,
+        VSHUNT = 0x04,
+        VBUS = 0x05,
+        DIETEMP = 0x06,
+        CURRENT = 0x07,
+        POWER = 0x08,
+        ENERGY = 0x09,
+        CHARGE = 0x0A,
+        DIAG_ALRT = 0x0B,
+        SOVL = 0x0C,
+        SUVL = 0x0D,
+        BOVL = 0x0E,
+        BUVL = 0x0F,
+        TEMP_LIMIT = 0x10,
+        PWR_LIMIT = 0x11,
+        MANUFACTURER_ID = 0x3E,
+        DEVICE_ID = 0x3F,
+    };
+
+    /**
+     * Underlying type of the DiagnosticAlert enum.
+     */
+    using DiagnosticAlert_t = uint16_t;
+
+    /**
+     * @enum DiagnosticAlert
+     *
+     * Contains the bit masks of the DIAG_ALRT register.
+     */
+    enum class DiagnosticAlert : DiagnosticAlert_t {
+        ALATCH = 1 << 15,
+        CNVR = 1 << 14,
+        SLOWALERT = 1 << 13,
+        APOL = 1 << 12,
+        ENERGYOF = 1 << 11,
+        CHARGEOF = 1 << 10,
+        MATHOF = 1 << 9,
+        TMPOL = 1 << 7,
+        SHNTOL = 1 << 6,
+        SHNTUL = 1 << 5,
+        BUSOL = 1 << 4,
+        BUSUL = 1 << 3,
+        POL = 1 << 2,
+        CNVRF = 1 << 1,
+        MEMSTAT = 1 << 0,
+    };
+
+    /**
+     * @enum Error
+     *
+     * Contains the errors of an I2C transaction with the INA228 device.
+     */
+    enum class Error : uint8_t {
+        BusBusy,             /// The TWIHS peripheral is busy with another transfer
+        TransferPending,     /// A transfer of this device has not completed yet
+        NACK,                /// The device did not acknowledge
+        Timeout,             /// The transfer did not complete in time
+        OutOfRange,          /// The value does not fit in the register
+        SchedulerNotStarted, /// The scheduler has not started, so the transfer interrupt is masked
+    };
+
+    /**
+     * Callback called from the TWIHS interrupt when an asynchronous transfer completes.
+     */
+    using TransferCallback = void (*)(etl::expected<void, Error> result, uintptr_t context);
+
+    /**
+     * Callback called from the ALERT pin interrupt.
+     */
+    using AlertCallback = void (*)(uintptr_t context);
+
+    /**
+     * The maximum time to wait for a blocking I2C transaction to complete (in ticks).
+     */
+    static constexpr TickType_t TransferTimeout = pdMS_TO_TICKS(10);
+
+    /**
+     * @enum Configuration
+     *
+     * Contains the various configurations of the INA228 device after power up.
+     */
+    enum class Configuration : uint16_t {
+        Configuration1 = 0x00,    /// Default configuration (ADCRANGE = 0)
+        Configuration2 = 0x10,    /// ADCRANGE = 1
+    };
+
+    /**
+     * @enum ADCConfiguration
+     *
+     * Contains the various ADC configurations of the INA228 device after power up.
+     */
+    enum class ADCConfiguration : uint16_t {
+        Configuration1 = 0b1111'1011'0110'1000,    /// Default configuration, Continuous measurements
+        Configuration2 = 0b0111'1011'0110'1000,    /// Single-shot measurements of voltages and temperature
+    };
+
+    /**
+     * @enum ADCMode
+     *
+     * Contains the conversion modes of the ADC (MODE field of ADC_CONFIG register).
+     */
+    enum class ADCMode : uint8_t {
+        Shutdown = 0x0,
+        TriggeredBusVoltage = 0x1,
+        TriggeredShuntVoltage = 0x2,
+        TriggeredShuntBusVoltage = 0x3,
+        TriggeredTemperature = 0x4,
+        TriggeredTemperatureBusVoltage = 0x5,
+        TriggeredTemperatureShuntVoltage = 0x6,
+        TriggeredAll = 0x7,
+        ContinuousBusVoltage = 0x9,
+        ContinuousShuntVoltage = 0xA,
+        ContinuousShuntBusVoltage = 0xB,
+        ContinuousTemperature = 0xC,
+        ContinuousTemperatureBusVoltage = 0xD,
+        ContinuousTemperatureShuntVoltage = 0xE,
+        ContinuousAll = 0xF,
+    };
+
+    /**
+     * @enum ConversionTime
+     *
+     * Contains the conversion times of the bus voltage, shunt voltage and temperature measurements
+     * (VBUSCT, VSHCT and VTCT fields of ADC_CONFIG register).
+     */
+    enum class ConversionTime : uint8_t {
+        Time50us = 0x0,
+        Time84us = 0x1,
+        Time150us = 0x2,
+        Time280us = 0x3,
+        Time540us = 0x4,
+        Time1052us = 0x5,
+        Time2074us = 0x6,
+        Time4120us = 0x7,
+    };
+
+    /**
+     * @enum AveragingCount
+     *
+     * Contains the number of ADC samples averaged for each result (AVG field of ADC_CONFIG register).
+     */
+    enum class AveragingCount : uint8_t {
+        Samples1 = 0x0,
+        Samples4 = 0x1,
+        Samples16 = 0x2,
+        Samples64 = 0x3,
+        Samples128 = 0x4,
+        Samples256 = 0x5,
+        Samples512 = 0x6,
+        Samples1024 = 0x7,
+    };
+
+    /**
+     * @struct ADCTuning
+     *
+     * The ADC configuration selected by autoTuneADC().
+     */
+    struct ADCTuning {
+        /**
+         * The selected number of averaged samples.
+         */
+        AveragingCount averagingCount = AveragingCount::Samples1;
+
+        /**
+         * The selected bus and shunt voltage conversion time.
+         */
+        ConversionTime conversionTime = ConversionTime::Time50us;
+
+        /**
+         * The time of one conversion of all measurements (in microseconds).
+         */
+        uint32_t conversionPeriodMicroSeconds = 0;
+
+        /**
+         * The measured standard deviation of the shunt voltage (in nanoVolts).
+         */
+        uint32_t shuntNoiseNanoVolts = 0;
+
+        /**
+         * True if the measured noise is within the target.
+         */
+        bool meetsNoiseTarget = false;
+    };
+
+    /**
+     * The number of samples kept by the continuous sampling ring buffer.
+     */
+    static constexpr uint8_t SampleBufferSize = 32;
+
+    /**
+     * @struct Snapshot
+     *
+     * Contains all the measurement results of the INA228 device, read together with readAll().
+     */
+    struct Snapshot {
+        /**
+         * The tick count when the measurement registers were read.
+         */
+        TickType_t timestamp = 0;
+
+        /**
+         * The shunt voltage (in milliVolts).
+         */
+        float shuntVoltage = 0.0f;
+
+        /**
+         * The bus voltage (in Volts).
+         */
+        float busVoltage = 0.0f;
+
+        /**
+         * The internal die temperature (in Celsius).
+         */
+        float dieTemperature = 0.0f;
+
+        /**
+         * The current (in Amperes).
+         */
+        float current = 0.0f;
+
+        /**
+         * The power (in Watts).
+         */
+        float power = 0.0f;
+
+        /**
+         * The energy (in Joules).
+         */
+        double energy = 0.0;
+    };
+
+    /**
+     * Constructor for the INA228 class.
+     *
+     * @param i2cAddress The hardware configured I2C chip address.
+     * @param configuration The configuration.
+     * @param adcConfiguration The ADC configuration.
+     * @param shuntResistor The hardware configured Rshunt.
+     */
+    INA228(I2CAddress i2cAddress, Configuration configuration, ADCConfiguration adcConfiguration, float shuntResistor)
+            : I2CChipAddress(i2cAddress), ConfigurationSelected(configuration),
+              ADCConfigurationSelected(adcConfiguration),
+              ShuntResistor(shuntResistor) {}
+
+    /**
+     * Constructor for the INA228 class.
+     *
+     * @param i2cAddress The hardware configured I2C chip address.
+     */
+    [[maybe_unused]] explicit INA228(I2CAddress i2cAddress) : I2CChipAddress(i2cAddress) {}
+
+    /**
+     * Constructor for the INA228 class.
+     *
+     * @param i2cAddress The hardware configured I2C chip address.
+     * @param shuntResistor The hardware configured Rshunt.
+     */
+    [[maybe_unused]] INA228(I2CAddress i2cAddress, float shuntResistor) : I2CChipAddress(i2cAddress),
+                                                                          ShuntResistor(shuntResistor) {}
+
+    /**
+     * Constructor for the INA228 class, with a configuration computed at compile time.
+     *
+     * @tparam CONFIGURATION An INA228Configuration instantiation (see INA228Configuration.hpp).
+     * @param i2cAddress The hardware configured I2C chip address.
+     */
+    template<typename CONFIGURATION>
+    INA228(I2CAddress i2cAddress, CONFIGURATION)
+            : I2CChipAddress(i2cAddress), ConfigurationSelected(CONFIGURATION::ConfigurationValue),
+              ADCConfigurationSelected(static_cast<ADCConfiguration>(CONFIGURATION::ADCConfigurationValue)),
+              MaximumExpectedCurrent(CONFIGURATION::MaximumExpectedCurrent),
+              CurrentLSB(CONFIGURATION::CurrentLSB),
+              MaximumExpectedCurrentMicroAmperes(CONFIGURATION::MaximumExpectedCurrentMicroAmperes),
+              ShuntResistor(CONFIGURATION::ShuntResistor),
+              ShuntCalValue(CONFIGURATION::ShuntCalValue) {}
+
+    /**
+     * Constructor for the INA228 class.
+     */
+    INA228() = default;
+
+    /**
+     * Function that sets up the device's registers CONFIG, ADC_CONFIG, and SHUNT_CAL on power-up.
+     *
+     * @brief The SHUNT_CAL register provides the device with a conversion constant value that represents shunt
+     * resistance used to calculate current value (in Amperes). The constructors do not access the bus, so that an
+     * instance can be constructed before the scheduler starts; this function shall be called from a task, before the
+     * measurements are read.
+     *
+     * @return An error if a register could not be written, SchedulerNotStarted before the scheduler starts.
+     */
+    [[nodiscard]] etl::expected<void, Error> init() const;
+
+    /**
+     * Function that reads the current measurements from the INA228 device.
+     *
+     * @return The current measurement (in Amperes).
+    */
+    [[nodiscard]] etl::expected<float, Error> getCurrent() const;
+
+    /**
+     * Function that reads the power measurements from the INA228 device.
+     *
+     * @return The power measurement (in Watts).
+     */
+    [[nodiscard]] etl::expected<float, Error> getPower() const;
+
+    /**
+     * Function that reads the bus voltage measurements from the INA228 device.
+     *
+     * @brief Resolution size 195.3125 μV/LSB.
+     *
+     * @return The bus voltage measurement (in Volts).
+     */
+    [[nodiscard]] etl::expected<float, Error> getVoltage() const;
+
+    /**
+     * Function that reads the internal die temperature from the INA228 device.
+     *
+     * @brief The temperature is calculated using a conversion factor 7.8125 m°C/LSB.
+     *
+     * @return The die temperature (in Celsius).
+     */
+    [[nodiscard]] etl::expected<float, Error> getDieTemperature() const;
+
+    /**
+     * Function that reads the energy measurements from the INA228 device.
+     *
+     * @return The energy measurement (in Joules).
+     */
+    [[nodiscard]] etl::expected<double, Error> getEnergy() const;
+
+    /**
+     * Function that reads the shunt voltage measurements from the INA228 device.
+     *
+     * @return The shunt voltage measurement (in milliVolts).
+     */
+    [[nodiscard]] etl::expected<float, Error> getShuntVoltage() const;
+
+    /**
+     * Function that reads the current measurements from the INA228 device, using integer arithmetic only.
+     *
+     * @return The current measurement (in microAmperes).
+     */
+    [[nodiscard]] etl::expected<int32_t, Error> getCurrentMicroAmperes() const;
+
+    /**
+     * Function that reads the power measurements from the INA228 device, using integer arithmetic only.
+     *
+     * @return The power measurement (in microWatts).
+     */
+    [[nodiscard]] etl::expected<uint32_t, Error> getPowerMicroWatts() const;
+
+    /**
+     * Function that reads the bus voltage measurements from the INA228 device, using integer arithmetic only.
+     *
+     * @return The bus voltage measurement (in microVolts).
+     */
+    [[nodiscard]] etl::expected<int32_t, Error> getVoltageMicroVolts() const;
+
+    /**
+     * Function that reads the internal die temperature from the INA228 device, using integer arithmetic only.
+     *
+     * @return The die temperature (in milliCelsius).
+     */
+    [[nodiscard]] etl::expected<int32_t, Error> getDieTemperatureMilliCelsius() const;
+
+    /**
+     * Function that reads the energy measurements from the INA228 device, using integer arithmetic only.
+     *
+     * @return The energy measurement (in microJoules).
+     */
+    [[nodiscard]] etl::expected<uint64_t, Error> getEnergyMicroJoules() const;
+
+    /**
+     * Function that reads the shunt voltage measurements from the INA228 device, using integer arithmetic only.
+     *
+     * @return The shunt voltage measurement (in nanoVolts).
+     */
+    [[nodiscard]] etl::expected<int32_t, Error> getShuntVoltageNanoVolts() const;
+
+    /**
+     * Function that reads the accumulated charge from the INA228 device.
+     *
+     * @return The charge measurement (in Coulombs).
+     */
+    [[nodiscard]] etl::expected<double, Error> getCharge() const;
+
+    /**
+     * Function that reads the raw 40-bit ENERGY register, in units of 16 * 3.2 * CurrentLSB.
+     *
+     * @return The register value.
+     */
+    [[nodiscard]] etl::expected<uint64_t, Error> readEnergyRegister() const;
+
+    /**
+     * Function that reads the raw 40-bit CHARGE register, in units of CurrentLSB.
+     *
+     * @return The sign-extended register value.
+     */
+    [[nodiscard]] etl::expected<int64_t, Error> readChargeRegister() const;
+
+    /**
+     * Function that resets the ENERGY and CHARGE accumulator registers to zero (RSTACC bit of CONFIG register).
+     *
+     * @return An error if the I2C transaction failed.
+     */
+    etl::expected<void, Error> resetAccumulators() const;
+
+    /**
+     * Function that converts an ENERGY register value, or a sum of them, to microJoules.
+     *
+     * @param energy The energy in register units.
+     * @return The energy (in microJoules).
+     */
+    [[nodiscard]] uint64_t convertEnergyMicroJoules(uint64_t energy) const;
+
+    /**
+     * Function that converts a CHARGE register value, or a sum of them, to microCoulombs.
+     *
+     * @param charge The charge in register units.
+     * @return The charge (in microCoulombs).
+     */
+    [[nodiscard]] int64_t convertChargeMicroCoulombs(int64_t charge) const;
+
+    /**
+     * Function that converts a VSHUNT register value to the shunt voltage.
+     *
+     * @brief The register values are right-aligned, as decoded with decodeBigEndian() from the bytes of a register
+     * read, e.g. by readRegisterAsync().
+     *
+     * @param shuntVoltage The 24-bit register value.
+     * @return The shunt voltage (in milliVolts).
+     */
+    [[nodiscard]] float convertShuntVoltage(uint32_t shuntVoltage) const;
+
+    /**
+     * Function that converts a VBUS register value to the bus voltage.
+     *
+     * @param busVoltage The 24-bit register value.
+     * @return The bus voltage (in Volts).
+     */
+    [[nodiscard]] float convertVoltage(uint32_t busVoltage) const;
+
+    /**
+     * Function that converts a DIETEMP register value to the die temperature.
+     *
+     * @param dieTemperature The 16-bit register value.
+     * @return The die temperature (in Celsius).
+     */
+    [[nodiscard]] float convertDieTemperature(uint16_t dieTemperature) const;
+
+    /**
+     * Function that converts a CURRENT register value to the current.
+     *
+     * @param current The 24-bit register value.
+     * @return The current (in Amperes).
+     */
+    [[nodiscard]] float convertCurrent(uint32_t current) const;
+
+    /**
+     * Function that converts a POWER register value to the power.
+     *
+     * @param power The 24-bit register value.
+     * @return The power (in Watts).
+     */
+    [[nodiscard]] float convertPower(uint32_t power) const;
+
+    /**
+     * Function that converts an ENERGY register value to the energy.
+     *
+     * @param energy The 40-bit register value.
+     * @return The energy (in Joules).
+     */
+    [[nodiscard]] double convertEnergy(uint64_t energy) const;
+
+    /**
+     * Function that converts a VSHUNT register value to the shunt voltage, using integer arithmetic only.
+     *
+     * @param shuntVoltage The 24-bit register value.
+     * @return The shunt voltage (in nanoVolts).
+     */
+    [[nodiscard]] int32_t convertShuntVoltageNanoVolts(uint32_t shuntVoltage) const;
+
+    /**
+     * Function that converts a VBUS register value to the bus voltage, using integer arithmetic only.
+     *
+     * @param busVoltage The 24-bit register value.
+     * @return The bus voltage (in microVolts).
+     */
+    [[nodiscard]] int32_t convertVoltageMicroVolts(uint32_t busVoltage) const;
+
+    /**
+     * Function that converts a DIETEMP register value to the die temperature, using integer arithmetic only.
+     *
+     * @param dieTemperature The 16-bit register value.
+     * @return The die temperature (in milliCelsius).
+     */
+    [[nodiscard]] int32_t convertDieTemperatureMilliCelsius(uint16_t dieTemperature) const;
+
+    /**
+     * Function that converts a CURRENT register value to the current, using integer arithmetic only.
+     *
+     * @param current The 24-bit register value.
+     * @return The current (in microAmperes).
+     */
+    [[nodiscard]] int32_t convertCurrentMicroAmperes(uint32_t current) const;
+
+    /**
+     * Function that converts a POWER register value to the power, using integer arithmetic only.
+     *
+     * @param power The 24-bit register value.
+     * @return The power (in microWatts).
+     */
+    [[nodiscard]] uint32_t convertPowerMicroWatts(uint32_t power) const;
+
+    /**
+     * Function that reads all the measurement registers (VSHUNT to ENERGY) from the INA228 device.
+     *
+     * @brief The registers are read back-to-back, with no conversion or logging in between, and decoded afterwards.
+     * The device has no register auto-increment, so each register still needs its own transaction.
+     *
+     * @return The measurements, with the tick count of the read, or the error of the first failed read.
+     */
+    [[nodiscard]] etl::expected<Snapshot, Error> readAll() const;
+
+    /**
+     * Function that starts an asynchronous read of a register of the INA228 device.
+     *
+     * @brief The function returns as soon as the transfer is started. Its completion is signalled by the callback,
+     * called from the TWIHS interrupt, and can be awaited by waitForTransfer(). The data buffer shall remain valid
+     * until the transfer completes or times out.
+     *
+     * @param registerAddress The address of the register.
+     * @param data The buffer of the read bytes, sized as the register.
+     * @param callback The completion callback, or nullptr.
+     * @param context The context passed to the callback.
+     * @return An error if the transfer could not be started.
+     */
+    etl::expected<void, Error> readRegisterAsync(RegisterAddress registerAddress, etl::span<uint8_t> data,
+                                                 TransferCallback callback = nullptr, uintptr_t context = 0) const;
+
+    /**
+     * Function that blocks the calling task until the pending asynchronous transfer completes.
+     *
+     * @brief On timeout the TWIHS peripheral is reinitialized, so that the abandoned transfer can no longer
+     * write to its buffer.
+     *
+     * @param timeout The maximum time to wait (in ticks).
+     * @return The result of the transfer.
+     */
+    etl::expected<void, Error> waitForTransfer(TickType_t timeout = TransferTimeout) const;
+
+    /**
+     * Function that checks whether an asynchronous transfer of this device is in progress.
      *
-     * Contains all the possible I2C addresses, that can be configured by the two address pins, A0 and A1.
+     * @return True if a transfer is in progress.
      */
-    enum class I2CAddress : uint16_t {
-        Address_1000000 = 0b100'0000, // A0 -> GND,  A1 -> GND
-        Address_1000001 = 0b100'0001, // A0 -> Vs,   A1 -> GND
-        Address_1000010 = 0b100'0010, // A0 -> SDA,  A1 -> GND
-        Address_1000011 = 0b100'0011, // A0 -> SCL,  A1 -> GND
+    [[nodiscard]] bool isTransferPending() const {
+        return transferPending;
+    }
 
-        Address_1000100 = 0b100'0100, // A0 -> GND,  A1 -> Vs
-        Address_1000101 = 0b100'0101, // A0 -> Vs,   A1 -> Vs
-        Address_1000110 = 0b100'0110, // A0 -> SDA,  A1 -> Vs
-        Address_1000111 = 0b100'0111, // A0 -> SCL,  A1 -> Vs
+    /**
+     * Function that composes an ADC_CONFIG register value.
+     *
+     * @param mode The conversion mode.
+     * @param busVoltageConversionTime The bus voltage conversion time.
+     * @param shuntVoltageConversionTime The shunt voltage conversion time.
+     * @param temperatureConversionTime The temperature conversion time.
+     * @param averagingCount The number of averaged samples.
+     * @return The ADC_CONFIG register value.
+     */
+    static constexpr uint16_t makeADCConfiguration(ADCMode mode, ConversionTime busVoltageConversionTime,
+                                                   ConversionTime shuntVoltageConversionTime,
+                                                   ConversionTime temperatureConversionTime,
+                                                   AveragingCount averagingCount) {
+        return static_cast<uint16_t>((static_cast<uint16_t>(mode) << 12) |
+                                     (static_cast<uint16_t>(busVoltageConversionTime) << 9) |
+                                     (static_cast<uint16_t>(shuntVoltageConversionTime) << 6) |
+                                     (static_cast<uint16_t>(temperatureConversionTime) << 3) |
+                                     static_cast<uint16_t>(averagingCount));
+    }
 
-        Address_1001000 = 0b100'1000, // A0 -> GND,  A1 -> SDA
-        Address_1001001 = 0b100'1001, // A0 -> Vs,   A1 -> SDA
-        Address_1001010 = 0b100'1010, // A0 -> SDA,  A1 -> SDA
-        Address_1001011 = 0b100'1011, // A0 -> SCL,  A1 -> SDA
+    /**
+     * Function that writes the ADC_CONFIG register of the INA228 device.
+     *
+     * @param mode The conversion mode.
+     * @param busVoltageConversionTime The bus voltage conversion time.
+     * @param shuntVoltageConversionTime The shunt voltage conversion time.
+     * @param temperatureConversionTime The temperature conversion time.
+     * @param averagingCount The number of averaged samples.
+     * @return An error if the I2C transaction failed.
+     */
+    etl::expected<void, Error> configureADC(ADCMode mode, ConversionTime busVoltageConversionTime, ConversionTime shuntVoltageConversionTime,
+                      ConversionTime temperatureConversionTime, AveragingCount averagingCount);
 
-        Address_1001100 = 0b100'1100, // A0 -> GND,  A1 -> SCL
-        Address_1001101 = 0b100'1101, // A0 -> Vs,   A1 -> SCL
-        Address_1001110 = 0b100'1110, // A0 -> SDA,  A1 -> SCL
-        Address_1001111 = 0b100'1111, // A0 -> SCL,  A1 -> SCL
-    };
+    /**
+     * Function that selects the on-chip averaging and conversion time from noise measurements.
+     *
+     * @brief The pairs of averaging count and conversion time whose conversion of all measurements fits in the
+     * sample period are ordered by integration time, and the shortest one whose shunt voltage noise is within the
+     * target is found by a binary search, measuring the noise over a calibration window for each tested pair. If no
+     * pair meets the target, the longest one is selected. The selected configuration is written to ADC_CONFIG with
+     * the current mode, the temperature using the shortest conversion time. The calling task is blocked during the
+     * calibration, which shall be done with a steady load.
+     *
+     * @param maximumSamplePeriodMicroSeconds The maximum time of one conversion of all measurements (in microseconds).
+     * @param maximumShuntNoiseNanoVolts The target standard deviation of the shunt voltage (in nanoVolts).
+     * @param calibrationSamples The number of samples of each calibration window, in the range [2, 255].
+     * @return The selected configuration, Error::OutOfRange if no configuration fits in the sample period.
+     */
+    etl::expected<ADCTuning, Error> autoTuneADC(uint32_t maximumSamplePeriodMicroSeconds,
+                                                uint32_t maximumShuntNoiseNanoVolts, uint8_t calibrationSamples = 32);
 
     /**
-     * @enum Configuration
+     * Function that starts the continuous conversion of all measurements, with the conversion ready flag
+     * signalled on the ALERT pin.
      *
-     * Contains the various configurations of the INA228 device after power up.
+     * @brief Each ALERT pin interrupt notifies the sampling task, which shall call serviceConversionReady() in its
+     * loop to read the conversion results into the sample ring buffer. The conversion times and averaging of the
+     * current ADC configuration are kept. The ALERT pin interrupt shall be enabled on the falling edge in the
+     * PIO configuration.
+     *
+     * @param alertPin The MCU pin connected to the ALERT pin of the device.
+     * @param samplingTask The handle of the task that calls serviceConversionReady().
+     * @return An error if the device could not be configured.
      */
-    enum class Configuration : uint16_t {
-        Configuration1 = 0x00,    /// Default configuration (ADCRANGE = 0)
-        Configuration2 = 0x10,    /// ADCRANGE = 1
-    };
+    etl::expected<void, Error> startContinuousSampling(PIO_PIN alertPin, TaskHandle_t samplingTask);
 
     /**
-     * @enum ADCConfiguration
+     * Function that stops the continuous sampling and restores the selected ADC configuration mode.
      *
-     * Contains the various ADC configurations of the INA228 device after power up.
+     * @return An error if the device could not be configured.
      */
-    enum class ADCConfiguration : uint16_t {
-        Configuration1 = 0b1111'1011'0110'1000,    /// Default configuration, Continuous measurements
-        Configuration2 = 0b0111'1011'0110'1000,    /// Single-shot measurements of voltages and temperature
-    };
+    etl::expected<void, Error> stopContinuousSampling();
 
     /**
-     * Constructor for the INA228 class.
+     * Function that waits for a conversion ready notification and reads the results into the sample ring buffer.
      *
-     * @param i2cAddress The hardware configured I2C chip address.
-     * @param configuration The configuration.
-     * @param adcConfiguration The ADC configuration.
-     * @param shuntResistor The hardware configured Rshunt.
+     * @brief To be called in a loop by the sampling task given to startContinuousSampling(). If the ring buffer is
+     * full, the oldest sample is overwritten.
+     *
+     * @param timeout The maximum time to wait for a conversion (in ticks).
+     * @return An error if no conversion was signalled in time or the results could not be read.
      */
-    INA228(I2CAddress i2cAddress, Configuration configuration, ADCConfiguration adcConfiguration, float shuntResistor)
-            : I2CChipAddress(i2cAddress), ConfigurationSelected(configuration),
-              ADCConfigurationSelected(adcConfiguration),
-              ShuntResistor(shuntResistor) {
-        setupConfigurationRegisters();
-    }
+    etl::expected<void, Error> serviceConversionReady(TickType_t timeout);
 
     /**
-     * Constructor for the INA228 class.
+     * Function that removes the oldest sample from the sample ring buffer.
      *
-     * @param i2cAddress The hardware configured I2C chip address.
+     * @return The oldest sample, or nothing if the buffer is empty.
      */
-    [[maybe_unused]] explicit INA228(I2CAddress i2cAddress) : I2CChipAddress(i2cAddress) {
-        setupConfigurationRegisters();
-    }
+    etl::optional<Snapshot> getSample();
 
     /**
-     * Constructor for the INA228 class.
+     * Function that sets the shunt overvoltage and undervoltage limits (SOVL and SUVL registers).
      *
-     * @param i2cAddress The hardware configured I2C chip address.
-     * @param shuntResistor The hardware configured Rshunt.
+     * @brief The resolution is 5 μV for ADCRANGE = 0 and 1.25 μV for ADCRANGE = 1.
+     *
+     * @param overVoltageNanoVolts The shunt overvoltage limit (in nanoVolts).
+     * @param underVoltageNanoVolts The shunt undervoltage limit (in nanoVolts).
+     * @return An error if a limit is out of range or the I2C transaction failed.
      */
-    [[maybe_unused]] INA228(I2CAddress i2cAddress, float shuntResistor) : I2CChipAddress(i2cAddress),
-                                                                          ShuntResistor(shuntResistor) {
-        setupConfigurationRegisters();
-    }
+    etl::expected<void, Error> setShuntVoltageLimits(int32_t overVoltageNanoVolts, int32_t underVoltageNanoVolts) const;
 
     /**
-     * Constructor for the INA228 class.
+     * Function that sets the overcurrent limit, as the equivalent shunt overvoltage limit (SOVL register).
+     *
+     * @param overCurrentMicroAmperes The overcurrent limit (in microAmperes).
+     * @return An error if the limit is out of range or the I2C transaction failed.
      */
-    INA228() {
-        setupConfigurationRegisters();
-    }
+    etl::expected<void, Error> setOvercurrentLimit(int32_t overCurrentMicroAmperes) const;
 
     /**
-     * Function that reads the current measurements from the INA228 device.
+     * Function that sets the bus overvoltage and undervoltage limits (BOVL and BUVL registers).
      *
-     * @return The current measurement (in Amperes).
-    */
-    [[nodiscard]] float getCurrent() const;
+     * @brief The resolution is 3.125 mV.
+     *
+     * @param overVoltageMicroVolts The bus overvoltage limit (in microVolts).
+     * @param underVoltageMicroVolts The bus undervoltage limit (in microVolts).
+     * @return An error if a limit is out of range or the I2C transaction failed.
+     */
+    etl::expected<void, Error> setBusVoltageLimits(uint32_t overVoltageMicroVolts, uint32_t underVoltageMicroVolts) const;
 
     /**
-     * Function that reads the power measurements from the INA228 device.
+     * Function that sets the die over-temperature limit (TEMP_LIMIT register).
      *
-     * @return The power measurement (in Watts).
+     * @brief The resolution is 7.8125 m°C.
+     *
+     * @param overTemperatureMilliCelsius The over-temperature limit (in milliCelsius).
+     * @return An error if the limit is out of range or the I2C transaction failed.
      */
-    [[nodiscard]] float getPower() const;
+    etl::expected<void, Error> setTemperatureLimit(int32_t overTemperatureMilliCelsius) const;
 
     /**
-     * Function that reads the bus voltage measurements from the INA228 device.
+     * Function that sets the power over-limit (PWR_LIMIT register).
      *
-     * @brief Resolution size 195.3125 μV/LSB.
+     * @brief The resolution is 256 times the power LSB.
      *
-     * @return The bus voltage measurement (in Volts).
+     * @param overPowerMicroWatts The power over-limit (in microWatts).
+     * @return An error if the limit is out of range or the I2C transaction failed.
      */
-    [[nodiscard]] float getVoltage() const;
+    etl::expected<void, Error> setPowerLimit(uint32_t overPowerMicroWatts) const;
 
     /**
-     * Function that reads the internal die temperature from the INA228 device.
+     * Function that enables the ALERT pin interrupt for the limit alerts.
      *
-     * @brief The temperature is calculated using a conversion factor 7.8125 m°C/LSB.
+     * @brief The device compares every conversion against the limits and asserts the ALERT pin on a violation, which
+     * calls the callback from the pin interrupt. The violated limit is read with readDiagnosticFlags(), which also
+     * releases a latched ALERT pin. The ALERT pin interrupt shall be enabled on the falling edge in the
+     * PIO configuration. During continuous sampling, the callback is also called on every conversion.
      *
-     * @return The die temperature (in Celsius).
+     * @param alertPin The MCU pin connected to the ALERT pin of the device.
+     * @param callback The callback called from the pin interrupt.
+     * @param context The context passed to the callback.
+     * @param latch True to keep the ALERT pin asserted until the flags are read.
+     * @param slowAlert True to compare the averaged values instead of every conversion against the limits.
+     * @return An error if the I2C transaction failed.
      */
-    [[nodiscard]] float getDieTemperature() const;
+    etl::expected<void, Error> enableAlert(PIO_PIN alertPin, AlertCallback callback, uintptr_t context = 0,
+                                           bool latch = true, bool slowAlert = false);
 
     /**
-     * Function that reads the energy measurements from the INA228 device.
+     * Function that disables the limit alert callback.
      *
-     * @return The energy measurement (in Joules).
+     * @return An error if the I2C transaction failed.
      */
-    [[nodiscard]] double getEnergy() const;
+    etl::expected<void, Error> disableAlert();
 
     /**
-     * Function that reads the shunt voltage measurements from the INA228 device.
+     * Function that reads the flags of the DIAG_ALRT register, with the limit flags cleared by continuous sampling
+     * since the previous call.
      *
-     * @return The shunt voltage measurement (in milliVolts).
+     * @return The flags, to be tested with the DiagnosticAlert masks.
+     */
+    [[nodiscard]] etl::expected<DiagnosticAlert_t, Error> readDiagnosticFlags() const;
+
+    /**
+     * Function that returns the number of conversions that were not read, either because the sampling task was late
+     * or because their sample was overwritten in the full ring buffer.
+     *
+     * @brief A conversion that completes while the latched ALERT pin is asserted is not signalled, so it is counted
+     * from the time elapsed since continuous sampling was started and the conversion period. The count can lag the
+     * device by the conversions of up to two ticks.
+     *
+     * @return The number of missed conversions since continuous sampling was started.
      */
-    [[nodiscard]] float getShuntVoltage() const;
+    [[nodiscard]] uint32_t getMissedConversions() const {
+        return missedConversions + unsignalledConversions;
+    }
 
 private:
     /**
@@ -207,6 +1031,111 @@ private:
      */
     const ADCConfiguration ADCConfigurationSelected = ADCConfiguration::Configuration1;
 
+    /**
+     * The ADC_CONFIG register value currently written to the device.
+     */
+    uint16_t ADCConfigurationValue = static_cast<uint16_t>(ADCConfigurationSelected);
+
+    /**
+     * The MCU pin connected to the ALERT pin, while continuous sampling is active.
+     */
+    PIO_PIN AlertPin = PIO_PIN_NONE;
+
+    /**
+     * The ALATCH, SLOWALERT and APOL bits written to the DIAG_ALRT register.
+     */
+    DiagnosticAlert_t diagnosticAlertConfiguration = 0;
+
+    /**
+     * The limit flags read by continuous sampling and not yet returned by readDiagnosticFlags().
+     */
+    mutable DiagnosticAlert_t pendingDiagnosticFlags = 0;
+
+    /**
+     * The callback of the limit alerts.
+     */
+    AlertCallback alertCallback = nullptr;
+
+    /**
+     * The context of the limit alerts callback.
+     */
+    uintptr_t alertCallbackContext = 0;
+
+    /**
+     * The task notified on every conversion ready interrupt.
+     */
+    TaskHandle_t samplingTaskHandle = nullptr;
+
+    /**
+     * The ring buffer of the continuous sampling results.
+     */
+    etl::circular_buffer<Snapshot, SampleBufferSize> samples;
+
+    /**
+     * The number of signalled conversions that were not read during continuous sampling.
+     */
+    uint32_t missedConversions = 0;
+
+    /**
+     * The number of conversions signalled by the ALERT pin during continuous sampling.
+     */
+    uint32_t signalledConversions = 0;
+
+    /**
+     * The number of conversions that completed while the ALERT pin was latched, so were not signalled.
+     */
+    uint32_t unsignalledConversions = 0;
+
+    /**
+     * The tick at which continuous sampling restarted the conversions.
+     */
+    TickType_t samplingStartTick = 0;
+
+    /**
+     * The initial conversion delay of continuous sampling (in microseconds).
+     */
+    uint32_t samplingDelayMicroSeconds = 0;
+
+    /**
+     * The conversion period of continuous sampling (in microseconds), 0 while it is stopped.
+     */
+    uint32_t samplingPeriodMicroSeconds = 0;
+
+    /**
+     * Buffer of the binary semaphore given on transfer completion.
+     */
+    mutable StaticSemaphore_t transferSemaphoreBuffer{};
+
+    /**
+     * Binary semaphore given from the TWIHS interrupt on transfer completion.
+     */
+    SemaphoreHandle_t transferSemaphore = xSemaphoreCreateBinaryStatic(&transferSemaphoreBuffer);
+
+    /**
+     * True while an asynchronous transfer of this device is in progress.
+     */
+    mutable volatile bool transferPending = false;
+
+    /**
+     * The result of the last completed transfer.
+     */
+    mutable etl::expected<void, Error> transferResult{};
+
+    /**
+     * The completion callback of the pending transfer.
+     */
+    mutable TransferCallback transferCallback = nullptr;
+
+    /**
+     * The context of the completion callback.
+     */
+    mutable uintptr_t transferCallbackContext = 0;
+
+    /**
+     * The register address written by the pending transfer.
+     */
+    mutable RegisterAddress_t transferRegisterAddress = 0;
+
     /**
      * The maximum expected current, used to calculate CurrentLSB.
      */
@@ -221,6 +1150,15 @@ private:
      */
     const float CurrentLSB = MaximumExpectedCurrent / (static_cast<float>(uint32_t{1} << 19));
 
+    /**
+     * The maximum expected current (in microAmperes), the integer scale of the fixed-point conversions.
+     *
+     * @brief Since CurrentLSB is MaximumExpectedCurrent / 2^19, a register value in CurrentLSB units is converted
+     * to microAmperes as value * MaximumExpectedCurrentMicroAmperes / 2^19, with no rounding of CurrentLSB.
+     */
+    const uint32_t MaximumExpectedCurrentMicroAmperes = static_cast<uint32_t>(round(MaximumExpectedCurrent *
+                                                                                    1000000.0f));
+
     /**
      * Value of current-sensing resistor (in Ohms).
      */
@@ -244,37 +1182,9 @@ private:
     }();
 
     /**
-     * Underlying type of the RegisterAddress enum.
+     * The RSTACC bit of the CONFIG register, resets the ENERGY and CHARGE registers.
      */
-    using RegisterAddress_t = uint8_t;
-
-    /**
-    * @enum RegisterAddress
-    *
-    * Contains the addresses of all the INA228 registers.
-    */
-    enum class RegisterAddress : RegisterAddress_t {
-        CONFIG = 0x00,
-        ADC_CONFIG = 0x01,
-        SHUNT_CAL = 0x02,
-        SHUNT_TEMPCO = 0x03,
-        VSHUNT = 0x04,
-        VBUS = 0x05,
-        DIETEMP = 0x06,
-        CURRENT = 0x07,
-        POWER = 0x08,
-        ENERGY = 0x09,
-        CHARGE = 0x0A,
-        DIAG_ALRT = 0x0B,
-        SOVL = 0x0C,
-        SUVL = 0x0D,
-        BOVL = 0x0E,
-        BUVL = 0x0F,
-        TEMP_LIMIT = 0x10,
-        PWR_LIMIT = 0x11,
-        MANUFACTURER_ID = 0x3E,
-        DEVICE_ID = 0x3F,
-    };
+    static constexpr uint16_t ResetAccumulationMask = 1 << 14;
 
     /**
      * Underlying type of the RegisterAddress enum.
@@ -290,7 +1200,7 @@ private:
         CONFIG = 2,
         ADC_CONFIG = 2,
         SHUNT_CAL = 2,
-        SHUNT_TEMPCO = 0x03,
+        SHUNT_TEMPCO = 2,
         VSHUNT = 3,
         VBUS = 3,
         DIETEMP = 2,
@@ -298,15 +1208,15 @@ private:
         POWER = 3,
         ENERGY = 5,
         CHARGE = 5,
-        DIAG_ALRT = 0,
-        SOVL = 0,
-        SUVL = 0,
-        BOVL = 0,
-        BUVL = 0,
-        TEMP_LIMIT = 0,
-        PWR_LIMIT = 0,
-        MANUFACTURER_ID = 0,
-        DEVICE_ID = 0,
+        DIAG_ALRT = 2,
+        SOVL = 2,
+        SUVL = 2,
+        BOVL = 2,
+        BUVL = 2,
+        TEMP_LIMIT = 2,
+        PWR_LIMIT = 2,
+        MANUFACTURER_ID = 2,
+        DEVICE_ID = 2,
     };
 
     /**
@@ -335,17 +1245,14 @@ private:
     using Energy_t = uint64_t;
 
     /**
-     * Type alias for representing the shunt die temp register data (2 bytes).
+     * Type alias for representing the charge register data (5 bytes).
      */
-    using DieTemp_t = uint16_t;
+    using Charge_t = uint64_t;
 
     /**
-     * Function that sets up the device's registers CONFIG, ADC_CONFIG, and SHUNT_CAL on power-up.
-     *
-     * @brief The SHUNT_CAL register provides the device with a conversion constant value that represents shunt
-     * resistance used to calculate current value (in Amperes).
+     * Type alias for representing the shunt die temp register data (2 bytes).
      */
-    void setupConfigurationRegisters() const;
+    using DieTemp_t = uint16_t;
 
     /**
      * Function that decodes the returned data from an array of bytes to a binary number.
@@ -362,16 +1269,147 @@ private:
      * Function that reads from a specified register of the INA228 device.
      *
      * @param registerAddress The address of the register.
-     * @return True if the I2C transaction was completed successfully.
+     * @return The bytes read from the register, or the error of the I2C transaction.
      */
     template<uint8_t RETURNED_BYTES>
-    etl::array<uint8_t, RETURNED_BYTES> readRegister(RegisterAddress registerAddress) const;
+    etl::expected<etl::array<uint8_t, RETURNED_BYTES>, Error> readRegister(RegisterAddress registerAddress) const;
 
     /**
      * Function that writes to a specified register of the INA228 device.
      *
      * @param data The data sent to the specified register as an array of bytes.
-     * @return True if the I2C transaction was completed successfully.
+     * @return An error if the I2C transaction failed.
+     */
+    [[nodiscard]] etl::expected<void, Error> writeRegister(etl::span<uint8_t> data) const;
+
+    /**
+     * Function that writes a 16-bit value to a specified register of the INA228 device.
+     *
+     * @param registerAddress The address of the register.
+     * @param data The value written to the register.
+     * @return An error if the I2C transaction failed.
+     */
+    [[nodiscard]] etl::expected<void, Error> writeRegister(RegisterAddress registerAddress, uint16_t data) const;
+
+    /**
+     * Function that claims the transfer state of this device, testing and setting transferPending atomically, so
+     * that two tasks cannot start a transfer of the same device.
+     *
+     * @return An error if a transfer is pending, or if the scheduler has not started.
+     */
+    etl::expected<void, Error> claimTransfer() const;
+
+    /**
+     * Function that starts a transfer on the TWIHS peripheral, with the completion signalled by its interrupt.
+     *
+     * @param writeData The bytes written to the device.
+     * @param readData The buffer of the bytes read from the device, empty for a write-only transfer.
+     * @param callback The completion callback, or nullptr.
+     * @param context The context passed to the callback.
+     * @return An error if the transfer could not be started.
+     */
+    etl::expected<void, Error> startTransfer(etl::span<uint8_t> writeData, etl::span<uint8_t> readData,
+                                             TransferCallback callback, uintptr_t context) const;
+
+    /**
+     * Function that starts a transfer claimed by claimTransfer(), releasing the claim if it cannot be started.
+     *
+     * @param writeData The bytes written to the device.
+     * @param readData The buffer of the bytes read from the device, empty for a write-only transfer.
+     * @param callback The completion callback, or nullptr.
+     * @param context The context passed to the callback.
+     * @return An error if the transfer could not be started.
+     */
+    etl::expected<void, Error> startClaimedTransfer(etl::span<uint8_t> writeData, etl::span<uint8_t> readData,
+                                                    TransferCallback callback, uintptr_t context) const;
+
+    /**
+     * TWIHS completion callback, records the transfer result and wakes the waiting task.
+     *
+     * @param context Pointer to the INA228 instance.
+     */
+    static void transferCompleteCallback(uintptr_t context);
+
+    /**
+     * The limit flags of the DIAG_ALRT register.
+     */
+    static constexpr DiagnosticAlert_t LimitFlagsMask = static_cast<DiagnosticAlert_t>(DiagnosticAlert::TMPOL) |
+                                                        static_cast<DiagnosticAlert_t>(DiagnosticAlert::SHNTOL) |
+                                                        static_cast<DiagnosticAlert_t>(DiagnosticAlert::SHNTUL) |
+                                                        static_cast<DiagnosticAlert_t>(DiagnosticAlert::BUSOL) |
+                                                        static_cast<DiagnosticAlert_t>(DiagnosticAlert::BUSUL) |
+                                                        static_cast<DiagnosticAlert_t>(DiagnosticAlert::POL);
+
+    /**
+     * The conversion times of the ConversionTime values (in microseconds).
+     */
+    static constexpr etl::array<uint16_t, 8> ConversionTimesMicroSeconds{50, 84, 150, 280, 540, 1052, 2074, 4120};
+
+    /**
+     * The averaged samples of the AveragingCount values.
+     */
+    static constexpr etl::array<uint16_t, 8> AveragingCounts{1, 4, 16, 64, 128, 256, 512, 1024};
+
+    /**
+     * Function that computes the time of a conversion of all measurements.
+     *
+     * @param adcConfiguration The ADC_CONFIG register value.
+     * @return The time (in microseconds).
+     */
+    static uint32_t getConversionPeriodMicroSeconds(uint16_t adcConfiguration);
+
+    /**
+     * Function that counts the conversions of continuous sampling that the ALERT pin did not signal.
+     */
+    void updateUnsignalledConversions();
+
+    /**
+     * Function that measures the variance of the shunt voltage over a calibration window, with the current ADC
+     * configuration.
+     *
+     * @param conversionPeriodMicroSeconds The time of one conversion of all measurements (in microseconds).
+     * @param samplesNumber The number of samples of the window.
+     * @return The variance (in nanoVolts squared).
+     */
+    etl::expected<uint64_t, Error> measureShuntVoltageVariance(uint32_t conversionPeriodMicroSeconds,
+                                                               uint8_t samplesNumber) const;
+
+    /**
+     * Function that writes a limit register, after checking that the value fits in it.
+     *
+     * @param registerAddress The address of the limit register.
+     * @param value The value in register units.
+     * @param minimum The minimum value of the register.
+     * @param maximum The maximum value of the register.
+     * @return An error if the value is out of range or the I2C transaction failed.
+     */
+    etl::expected<void, Error> writeLimit(RegisterAddress registerAddress, int64_t value, int64_t minimum,
+                                          int64_t maximum) const;
+
+    /**
+     * Function that writes the DIAG_ALRT register, with conversion ready alerts enabled during continuous sampling.
+     *
+     * @return An error if the I2C transaction failed.
+     */
+    etl::expected<void, Error> writeDiagnosticAlertConfiguration() const;
+
+    /**
+     * Function that registers and enables the ALERT pin interrupt.
+     *
+     * @param alertPin The MCU pin connected to the ALERT pin of the device.
+     */
+    void attachAlertPin(PIO_PIN alertPin);
+
+    /**
+     * Function that disables the ALERT pin interrupt, once neither continuous sampling nor limit alerts use it.
+     */
+    void detachAlertPin();
+
+    /**
+     * Interrupt callback of the ALERT pin, calls the limit alerts callback and notifies the sampling task.
+     *
+     * @param pin The interrupt pin.
+     * @param context Pointer to the INA228 instance.
      */
-    [[nodiscard]] bool writeRegister(etl::span<uint8_t> data) const;
+    static void alertPinCallback(PIO_PIN pin, uintptr_t context);
 };
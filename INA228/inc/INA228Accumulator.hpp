@@ -0,0 +1,119 @@
+#pragma once
+
+#include <cstdint>
+#include "INA228.hpp"
+
+/**
+ * Class that tracks the energy and charge consumed by the load of an INA228 device.
+ *
+ * @brief The 40-bit ENERGY and CHARGE registers of the device are read on every update() and their increments are
+ * summed into 64-bit totals, so that a register wrap-around is not lost. A mission power budget can be assigned to
+ * the load (e.g. pump, heaters or camera), checked from the totals without any I2C transaction.
+ *
+ * @note update() shall be called at least once every half wrap period of the CHARGE register, which is
+ * 2^39 * CurrentLSB Coulombs at the maximum expected current (more than 12 days for the default configuration).
+ */
+class INA228Accumulator {
+public:
+    /**
+     * Constructor for the INA228Accumulator class.
+     *
+     * @param device The INA228 device measuring the load.
+     * @param energyBudgetMicroJoules The energy budget of the load (in microJoules), 0 for no budget.
+     */
+    explicit INA228Accumulator(const INA228 &device, uint64_t energyBudgetMicroJoules = 0)
+            : Device(device), energyBudget(energyBudgetMicroJoules) {}
+
+    /**
+     * Function that reads the accumulator registers and adds their increments since the previous update.
+     *
+     * @brief The first update only records the register values, so the totals count from that moment.
+     *
+     * @return An error if a register could not be read, in which case the totals are not updated.
+     */
+    etl::expected<void, INA228::Error> update();
+
+    /**
+     * Function that resets the accumulator registers of the device and the totals.
+     *
+     * @return An error if the device could not be reset.
+     */
+    etl::expected<void, INA228::Error> reset();
+
+    /**
+     * Function that sets the energy budget of the load.
+     *
+     * @param energyBudgetMicroJoules The energy budget (in microJoules), 0 for no budget.
+     */
+    void setEnergyBudget(uint64_t energyBudgetMicroJoules) {
+        energyBudget = energyBudgetMicroJoules;
+    }
+
+    /**
+     * Function that returns the energy consumed since the first update or the last reset.
+     *
+     * @return The energy (in microJoules).
+     */
+    [[nodiscard]] uint64_t getEnergyMicroJoules() const {
+        return Device.convertEnergyMicroJoules(energy);
+    }
+
+    /**
+     * Function that returns the charge consumed since the first update or the last reset.
+     *
+     * @return The charge (in microCoulombs).
+     */
+    [[nodiscard]] int64_t getChargeMicroCoulombs() const {
+        return Device.convertChargeMicroCoulombs(charge);
+    }
+
+    /**
+     * Function that returns the energy budget left for the load.
+     *
+     * @return The remaining energy (in microJoules), 0 if the budget is exceeded or no budget is set.
+     */
+    [[nodiscard]] uint64_t getRemainingEnergyBudget() const;
+
+    /**
+     * Function that checks whether the load has consumed more than its energy budget.
+     *
+     * @return True if a budget is set and exceeded.
+     */
+    [[nodiscard]] bool isEnergyBudgetExceeded() const;
+
+private:
+    /**
+     * The INA228 device measuring the load.
+     */
+    const INA228 &Device;
+
+    /**
+     * The energy budget of the load (in microJoules), 0 for no budget.
+     */
+    uint64_t energyBudget = 0;
+
+    /**
+     * The ENERGY register value of the previous update.
+     */
+    uint64_t lastEnergyRegister = 0;
+
+    /**
+     * The CHARGE register value of the previous update, as an unsigned 40-bit value.
+     */
+    uint64_t lastChargeRegister = 0;
+
+    /**
+     * The total energy, in ENERGY register units.
+     */
+    uint64_t energy = 0;
+
+    /**
+     * The total charge, in CHARGE register units.
+     */
+    int64_t charge = 0;
+
+    /**
+     * True once the register values have been recorded by an update.
+     */
+    bool isSynchronized = false;
+};
@@ -0,0 +1,109 @@
+#pragma once
+
+#include <cstdint>
+#include "INA228.hpp"
+
+/**
+ * Compile-time configuration of an INA228 device.
+ *
+ * @brief All the values written to the configuration registers and the conversion constants are computed at compile
+ * time, and configurations the device cannot measure fail to compile. The shunt resistance and the maximum expected
+ * current are given in integer micro-units, so that SHUNT_CAL is computed exactly.
+ *
+ * @tparam SHUNT_RESISTOR_MICRO_OHMS The hardware configured Rshunt (in microOhms).
+ * @tparam MAXIMUM_EXPECTED_CURRENT_MICRO_AMPERES The maximum expected current (in microAmperes).
+ * @tparam ADC_RANGE_LOW The ADCRANGE selection, true for the ±40.96 mV range and false for the ±163.84 mV range.
+ * @tparam MODE The ADC conversion mode.
+ * @tparam AVERAGING The number of averaged samples.
+ * @tparam BUS_VOLTAGE_CONVERSION_TIME The bus voltage conversion time.
+ * @tparam SHUNT_VOLTAGE_CONVERSION_TIME The shunt voltage conversion time.
+ * @tparam TEMPERATURE_CONVERSION_TIME The temperature conversion time.
+ */
+template<uint32_t SHUNT_RESISTOR_MICRO_OHMS, uint32_t MAXIMUM_EXPECTED_CURRENT_MICRO_AMPERES,
+        bool ADC_RANGE_LOW = false,
+        INA228::ADCMode MODE = INA228::ADCMode::ContinuousAll,
+        INA228::AveragingCount AVERAGING = INA228::AveragingCount::Samples1,
+        INA228::ConversionTime BUS_VOLTAGE_CONVERSION_TIME = INA228::ConversionTime::Time1052us,
+        INA228::ConversionTime SHUNT_VOLTAGE_CONVERSION_TIME = INA228::ConversionTime::Time1052us,
+        INA228::ConversionTime TEMPERATURE_CONVERSION_TIME = INA228::ConversionTime::Time1052us>
+struct INA228Configuration {
+    static_assert(SHUNT_RESISTOR_MICRO_OHMS > 0, "The shunt resistance must be positive");
+    static_assert(MAXIMUM_EXPECTED_CURRENT_MICRO_AMPERES > 0, "The maximum expected current must be positive");
+
+    /**
+     * The shunt voltage full scale of the selected ADCRANGE (in nanoVolts).
+     */
+    static constexpr uint64_t ShuntFullScaleNanoVolts = ADC_RANGE_LOW ? 40'960'000 : 163'840'000;
+
+    /**
+     * The shunt voltage at the maximum expected current (in nanoVolts).
+     */
+    static constexpr uint64_t MaximumShuntVoltageNanoVolts =
+            static_cast<uint64_t>(SHUNT_RESISTOR_MICRO_OHMS) * MAXIMUM_EXPECTED_CURRENT_MICRO_AMPERES / 1000;
+
+    static_assert(MaximumShuntVoltageNanoVolts <= ShuntFullScaleNanoVolts,
+                  "The maximum expected current exceeds the shunt voltage range of the selected ADCRANGE");
+
+    /**
+     * The value written to the SHUNT_CAL register.
+     *
+     * @brief SHUNT_CAL = 13107.2 * 10^6 * CurrentLSB * Rshunt, with CurrentLSB = MaximumExpectedCurrent / 2^19,
+     * simplifies to MaximumExpectedCurrent[μA] * Rshunt[μΩ] / (4 * 10^7), multiplied by 4 for ADCRANGE = 1.
+     */
+    static constexpr uint16_t ShuntCalValue = [] {
+        constexpr uint64_t Divisor = 40'000'000;
+        constexpr uint64_t Product = static_cast<uint64_t>(MAXIMUM_EXPECTED_CURRENT_MICRO_AMPERES) *
+                                     SHUNT_RESISTOR_MICRO_OHMS * (ADC_RANGE_LOW ? 4 : 1);
+        constexpr uint64_t ShuntCal = (Product + Divisor / 2) / Divisor;
+
+        static_assert(ShuntCal > 0, "SHUNT_CAL rounds to zero, the current would always read zero");
+        static_assert(ShuntCal <= 0x7FFF, "SHUNT_CAL exceeds its 15-bit register field");
+
+        return static_cast<uint16_t>(ShuntCal);
+    }();
+
+    /**
+     * The value written to the CONFIG register.
+     */
+    static constexpr INA228::Configuration ConfigurationValue = ADC_RANGE_LOW ? INA228::Configuration::Configuration2
+                                                                              : INA228::Configuration::Configuration1;
+
+    /**
+     * The value written to the ADC_CONFIG register.
+     */
+    static constexpr uint16_t ADCConfigurationValue = INA228::makeADCConfiguration(MODE, BUS_VOLTAGE_CONVERSION_TIME,
+                                                                                   SHUNT_VOLTAGE_CONVERSION_TIME,
+                                                                                   TEMPERATURE_CONVERSION_TIME,
+                                                                                   AVERAGING);
+
+    /**
+     * The maximum expected current (in microAmperes).
+     */
+    static constexpr uint32_t MaximumExpectedCurrentMicroAmperes = MAXIMUM_EXPECTED_CURRENT_MICRO_AMPERES;
+
+    /**
+     * The maximum expected current (in Amperes).
+     */
+    static constexpr float MaximumExpectedCurrent = static_cast<float>(MAXIMUM_EXPECTED_CURRENT_MICRO_AMPERES) /
+                                                    1000000.0f;
+
+    /**
+     * The LSB step size for the CURRENT register (in Amperes).
+     */
+    static constexpr float CurrentLSB = MaximumExpectedCurrent / static_cast<float>(uint32_t{1} << 19);
+
+    /**
+     * The shunt resistance (in Ohms).
+     */
+    static constexpr float ShuntResistor = static_cast<float>(SHUNT_RESISTOR_MICRO_OHMS) / 1000000.0f;
+};
+
+/**
+ * The default configuration of the INA228 class: Rshunt = 50 mΩ, 1 A maximum expected current, ±163.84 mV range and
+ * continuous measurements.
+ */
+using INA228DefaultConfiguration = INA228Configuration<50'000, 1'000'000>;
+
+static_assert(INA228DefaultConfiguration::ShuntCalValue == 1250);
+static_assert(INA228DefaultConfiguration::ADCConfigurationValue ==
+              static_cast<uint16_t>(INA228::ADCConfiguration::Configuration1));
@@ -0,0 +1,138 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <etl/array.h>
+#include <etl/optional.h>
+#include "INA228.hpp"
+
+/**
+ * Class that owns the I2C bus of several INA228 devices and polls them from a single task.
+ *
+ * @brief Each registered monitor is read with its own period, in round-robin order among the monitors that are due,
+ * so that only one transaction is on the bus at a time. The latest measurements of every monitor are published in a
+ * table, and both the poller and the readers copy an entry inside a short critical section, so that a reader never
+ * waits for the poller whatever their priorities. Consumers shall read the measurements from the table instead of
+ * calling the INA228 getters.
+ */
+class INA228Poller {
+public:
+    /**
+     * The maximum number of monitors that can be registered.
+     */
+    static constexpr uint8_t MaximumMonitors = 8;
+
+    /**
+     * The index of a registered monitor in the latest-value table.
+     */
+    using MonitorIndex = uint8_t;
+
+    /**
+     * @struct Measurement
+     *
+     * The latest measurements of a monitor.
+     */
+    struct Measurement {
+        /**
+         * The measurements of the latest successful read.
+         */
+        INA228::Snapshot snapshot;
+
+        /**
+         * The number of failed reads since the monitor was registered.
+         */
+        uint32_t readErrors = 0;
+
+        /**
+         * The error of the latest read, if it failed.
+         */
+        etl::optional<INA228::Error> lastError;
+    };
+
+    /**
+     * Function that registers a monitor to be polled.
+     *
+     * @brief Registration may happen while the poller task runs, but it is not safe to register monitors from
+     * several tasks at the same time, as they could be given the same entry.
+     *
+     * @param monitor The INA228 device, which shall not be accessed outside the poller afterwards.
+     * @param period The polling period of the monitor (in ticks).
+     * @return The index of the monitor in the latest-value table, or nothing if the table is full.
+     */
+    etl::optional<MonitorIndex> registerMonitor(const INA228 &monitor, TickType_t period);
+
+    /**
+     * Function that reads every monitor that is due, in round-robin order.
+     *
+     * @return The time until the next monitor is due (in ticks).
+     */
+    TickType_t poll();
+
+    /**
+     * Function that polls the monitors forever, to be called as the body of the poller task.
+     */
+    [[noreturn]] void run();
+
+    /**
+     * Function that copies the latest measurements of a monitor from the table, without any I2C transaction.
+     *
+     * @param index The index returned by registerMonitor().
+     * @return The latest measurements, or nothing if the index is invalid or no read has completed yet.
+     */
+    [[nodiscard]] etl::optional<Measurement> getLatest(MonitorIndex index) const;
+
+private:
+    /**
+     * @struct Entry
+     *
+     * A registered monitor and its entry in the latest-value table.
+     */
+    struct Entry {
+        /**
+         * The INA228 device.
+         */
+        const INA228 *monitor = nullptr;
+
+        /**
+         * The polling period (in ticks).
+         */
+        TickType_t period = 0;
+
+        /**
+         * The tick count when the next read is due.
+         */
+        TickType_t nextDue = 0;
+
+        /**
+         * The latest measurements.
+         */
+        Measurement measurement;
+
+        /**
+         * True once a read has completed.
+         */
+        bool hasMeasurement = false;
+    };
+
+    /**
+     * The registered monitors.
+     */
+    etl::array<Entry, MaximumMonitors> entries;
+
+    /**
+     * The number of registered monitors.
+     */
+    std::atomic<uint8_t> monitorsNumber{0};
+
+    /**
+     * The index of the monitor read last, where the round-robin search resumes.
+     */
+    MonitorIndex lastPolledIndex = 0;
+
+    /**
+     * Function that reads a monitor and publishes its measurements in the table.
+     *
+     * @param entry The entry of the monitor.
+     */
+    static void pollEntry(Entry &entry);
+};
@@ -1,190 +1,972 @@
 #include "INA228.hpp"
 
-void INA228::setupConfigurationRegisters() const {
-    auto createDataPacket = [](RegisterAddress registerAddress, uint16_t data) {
-        const uint8_t NumberOfBytesToTransmit = sizeof(data) / sizeof(uint8_t) + sizeof(RegisterAddress_t);
-
-        const etl::array<uint8_t, NumberOfBytesToTransmit> Buffer{static_cast<RegisterAddress_t>(registerAddress),
-                                                                  static_cast<uint8_t>(
-                                                                          (static_cast<uint16_t>(data) & 0xFF00) >> 8),
-                                                                  static_cast<uint8_t>(data & 0xFF)};
-        return Buffer;
-    };
+using namespace INA228FixedPoint;
+
+etl::expected<void, INA228::Error> INA228::init() const {
+    if (auto written = writeRegister(RegisterAddress::CONFIG, static_cast<uint16_t>(ConfigurationSelected));
+            not written) {
+        return written;
+    }
 
-    auto configRegisterBuffer = createDataPacket(RegisterAddress::CONFIG, static_cast<uint16_t>(ConfigurationSelected));
-    auto adcConfigRegisterBuffer = createDataPacket(RegisterAddress::ADC_CONFIG,
-                                                    static_cast<uint16_t>(ADCConfigurationSelected));
-    auto shuntCalRegisterBuffer = createDataPacket(RegisterAddress::SHUNT_CAL, ShuntCalValue);
+    if (auto written = writeRegister(RegisterAddress::ADC_CONFIG, static_cast<uint16_t>(ADCConfigurationSelected));
+            not written) {
+        return written;
+    }
 
-    writeRegister(configRegisterBuffer);
-    writeRegister(adcConfigRegisterBuffer);
-    writeRegister(shuntCalRegisterBuffer);
+    return writeRegister(RegisterAddress::SHUNT_CAL, ShuntCalValue);
 }
 
-template<uint8_t RETURNED_BYTES>
-etl::array<uint8_t, RETURNED_BYTES> INA228::readRegister(INA228::RegisterAddress registerAddress) const {
-    etl::array<uint8_t, RETURNED_BYTES> bufferRead{0};
+etl::expected<void, INA228::Error> INA228::claimTransfer() const {
+    if (xTaskGetSchedulerState() == taskSCHEDULER_NOT_STARTED) {
+        // On the Cortex-M7 port, a critical section entered before the scheduler starts leaves BASEPRI raised, so
+        // the TWIHS interrupt would never complete the transfer
+        LOG_ERROR << "Current monitor failed to perform I2C transaction: scheduler not started";
+        return etl::unexpected(Error::SchedulerNotStarted);
+    }
 
-    constexpr uint8_t BytesToWrite = 1;
-    etl::array<RegisterAddress_t, BytesToWrite> bufferWrite{static_cast<RegisterAddress_t>(registerAddress)};
+    taskENTER_CRITICAL();
+    const bool Pending = transferPending;
+    transferPending = true;
+    taskEXIT_CRITICAL();
 
-    if (not INA228_TWIHS_WriteRead(static_cast<uint8_t>(I2CChipAddress), bufferWrite.data(), bufferWrite.size(),
-                                   bufferRead.data(), RETURNED_BYTES)) {
-        LOG_INFO << "Current monitor failed to perform I2C transaction: bus is busy";
-        // TODO: Error handling
+    if (Pending) {
+        return etl::unexpected(Error::TransferPending);
     }
 
-    while (INA228_TWIHS_IsBusy());
+    return {};
+}
 
-    if (INA228_TWIHS_ErrorGet() == TWIHS_ERROR_NACK) {
-        LOG_ERROR << "Current monitor failed to perform I2C transaction: device NACK";
-        // TODO: Error handling
+etl::expected<void, INA228::Error> INA228::startTransfer(etl::span<uint8_t> writeData, etl::span<uint8_t> readData,
+                                                         TransferCallback callback, uintptr_t context) const {
+    if (auto claimed = claimTransfer(); not claimed) {
+        return claimed;
     }
 
-    return bufferRead;
+    return startClaimedTransfer(writeData, readData, callback, context);
 }
 
-bool INA228::writeRegister(etl::span<uint8_t> data) const {
-    if (not INA228_TWIHS_Write(static_cast<uint8_t>(I2CChipAddress), data.data(), data.size())) {
+etl::expected<void, INA228::Error> INA228::startClaimedTransfer(etl::span<uint8_t> writeData,
+                                                                etl::span<uint8_t> readData,
+                                                                TransferCallback callback, uintptr_t context) const {
+    transferCallback = callback;
+    transferCallbackContext = context;
+    transferResult = {};
+
+    // Drop the completion of a transfer that was abandoned after a timeout
+    xSemaphoreTake(transferSemaphore, 0);
+
+    INA228_TWIHS_CallbackRegister(transferCompleteCallback, reinterpret_cast<uintptr_t>(this));
+
+    const bool Started = readData.empty()
+                         ? INA228_TWIHS_Write(static_cast<uint16_t>(I2CChipAddress), writeData.data(),
+                                              writeData.size())
+                         : INA228_TWIHS_WriteRead(static_cast<uint16_t>(I2CChipAddress), writeData.data(),
+                                                  writeData.size(), readData.data(), readData.size());
+
+    if (not Started) {
+        transferPending = false;
         LOG_INFO << "Current monitor failed to perform I2C transaction: bus is busy";
-        return false;
+        return etl::unexpected(Error::BusBusy);
     }
 
-    while (INA228_TWIHS_IsBusy());
+    return {};
+}
+
+void INA228::transferCompleteCallback(uintptr_t context) {
+    auto *ina228 = reinterpret_cast<INA228 *>(context);
+
+    if (not ina228->transferPending) {
+        return;
+    }
+
+    etl::expected<void, Error> result{};
 
     if (INA228_TWIHS_ErrorGet() == TWIHS_ERROR_NACK) {
-        LOG_ERROR << "Current monitor failed to perform I2C transaction: device NACK";
-        return false;
+        result = etl::unexpected(Error::NACK);
+    }
+
+    ina228->transferResult = result;
+    ina228->transferPending = false;
+
+    if (ina228->transferCallback != nullptr) {
+        ina228->transferCallback(result, ina228->transferCallbackContext);
+    }
+
+    BaseType_t higherPriorityTaskWoken = pdFALSE;
+    xSemaphoreGiveFromISR(ina228->transferSemaphore, &higherPriorityTaskWoken);
+    portYIELD_FROM_ISR(higherPriorityTaskWoken);
+}
+
+etl::expected<void, INA228::Error> INA228::readRegisterAsync(RegisterAddress registerAddress, etl::span<uint8_t> data,
+                                                             TransferCallback callback, uintptr_t context) const {
+    // The register address is only written once the transfer is claimed, as it may be on the bus of a pending one
+    if (auto claimed = claimTransfer(); not claimed) {
+        return claimed;
+    }
+
+    transferRegisterAddress = static_cast<RegisterAddress_t>(registerAddress);
+
+    return startClaimedTransfer(etl::span<uint8_t>(&transferRegisterAddress, 1), data, callback, context);
+}
+
+etl::expected<void, INA228::Error> INA228::waitForTransfer(TickType_t timeout) const {
+    if (xSemaphoreTake(transferSemaphore, timeout) == pdTRUE) {
+        if (not transferResult) {
+            LOG_ERROR << "Current monitor failed to perform I2C transaction: device NACK";
+        }
+        return transferResult;
+    }
+
+    taskENTER_CRITICAL();
+    const bool Completed = not transferPending;
+    transferPending = false;
+    taskEXIT_CRITICAL();
+
+    if (Completed) {
+        xSemaphoreTake(transferSemaphore, 0);
+        return transferResult;
+    }
+
+    // The reinitialization stops the interrupt driven transfer from writing to a buffer that is no longer owned
+    INA228_TWIHS_Initialize();
+
+    LOG_ERROR << "Current monitor failed to perform I2C transaction: timeout";
+    return etl::unexpected(Error::Timeout);
+}
+
+template<uint8_t RETURNED_BYTES>
+etl::expected<etl::array<uint8_t, RETURNED_BYTES>, INA228::Error>
+INA228::readRegister(INA228::RegisterAddress registerAddress) const {
+    etl::array<uint8_t, RETURNED_BYTES> bufferRead{0};
+
+    if (auto started = readRegisterAsync(registerAddress, bufferRead); not started) {
+        return etl::unexpected(started.error());
+    }
+
+    if (auto completed = waitForTransfer(TransferTimeout); not completed) {
+        return etl::unexpected(completed.error());
+    }
+
+    return bufferRead;
+}
+
+etl::expected<void, INA228::Error> INA228::writeRegister(etl::span<uint8_t> data) const {
+    if (auto started = startTransfer(data, etl::span<uint8_t>(), nullptr, 0); not started) {
+        return started;
     }
 
-    return true;
+    return waitForTransfer(TransferTimeout);
+}
+
+etl::expected<void, INA228::Error> INA228::writeRegister(RegisterAddress registerAddress, uint16_t data) const {
+    etl::array<uint8_t, 3> buffer{static_cast<RegisterAddress_t>(registerAddress),
+                                  static_cast<uint8_t>((data & 0xFF00) >> 8),
+                                  static_cast<uint8_t>(data & 0xFF)};
+
+    return writeRegister(buffer);
 }
 
 template<uint8_t NUMBER_OF_BYTES, typename T>
 T INA228::decodeReturnedData(const etl::array<uint8_t, NUMBER_OF_BYTES> &returnedData) const {
-    static_assert(std::is_integral<T>::value, "Invalid template argument");
+    return decodeBigEndian<NUMBER_OF_BYTES, T>(returnedData);
+}
+
+etl::expected<float, INA228::Error> INA228::getCurrent() const {
+    constexpr auto CurrentRegisterBytes = static_cast<RegisterBytesNumber_t>(RegisterBytesNumber::CURRENT);
+    const auto returnedData = readRegister<CurrentRegisterBytes>(RegisterAddress::CURRENT);
 
-    if (NUMBER_OF_BYTES != returnedData.size()) {
-        LOG_ERROR << "Error in decoding function";
-        // TODO: Error-handling
+    if (not returnedData) {
+        return etl::unexpected(returnedData.error());
     }
 
-    T convertedBinary = 0;
-    constexpr uint8_t ShiftStep = 8 * (NUMBER_OF_BYTES - 1);
+    return convertCurrent(decodeReturnedData<CurrentRegisterBytes, Current_t>(returnedData.value()));
+}
+
+etl::expected<float, INA228::Error> INA228::getPower() const {
+    constexpr auto PowerRegisterBytes = static_cast<RegisterBytesNumber_t>(RegisterBytesNumber::POWER);
+    const auto returnedData = readRegister<PowerRegisterBytes>(RegisterAddress::POWER);
 
-    for (uint8_t i = 0; i < NUMBER_OF_BYTES; i++) {
-        convertedBinary |= static_cast<T>(static_cast<T>(returnedData[i]) << (ShiftStep - 8 * i));
+    if (not returnedData) {
+        return etl::unexpected(returnedData.error());
     }
 
-    return convertedBinary;
+    return convertPower(decodeReturnedData<PowerRegisterBytes, Power_t>(returnedData.value()));
 }
 
-float INA228::getCurrent() const {
-    constexpr auto CurrentRegisterBytes = static_cast<RegisterBytesNumber_t>(RegisterBytesNumber::CURRENT);
-    auto returnedData = readRegister<CurrentRegisterBytes>(RegisterAddress::CURRENT);
+etl::expected<float, INA228::Error> INA228::getVoltage() const {
+    constexpr auto VBusRegisterBytes = static_cast<RegisterBytesNumber_t>(RegisterBytesNumber::VBUS);
+    const auto returnedData = readRegister<VBusRegisterBytes>(RegisterAddress::VBUS);
 
-    if (returnedData.data() == nullptr) {
-        LOG_ERROR << "Current monitor failed to perform I2C transaction: returned data is nullptr";
-        // TODO: Error handling
+    if (not returnedData) {
+        return etl::unexpected(returnedData.error());
     }
 
-    const auto Current = [=]() -> float {
-        auto current = decodeReturnedData<CurrentRegisterBytes, Current_t>(returnedData);
-        current = (current >> 4) & 0xFFFFF;
+    return convertVoltage(decodeReturnedData<VBusRegisterBytes, BusVoltage_t>(returnedData.value()));
+}
 
-        const Current_t Sign = current & 0x80000;
+etl::expected<float, INA228::Error> INA228::getDieTemperature() const {
+    constexpr auto DieTempRegisterBytes = static_cast<RegisterBytesNumber_t>(RegisterBytesNumber::DIETEMP);
+    const auto returnedData = readRegister<DieTempRegisterBytes>(RegisterAddress::DIETEMP);
 
-        if (Sign != 0) {
-            current = (~current & 0xFFFFF) + 1;
-            const auto CurrentFloat = -static_cast<float>(current);
-            return CurrentFloat;
-        }
+    if (not returnedData) {
+        return etl::unexpected(returnedData.error());
+    }
 
-        return static_cast<float>(current);
-    }();
+    return convertDieTemperature(decodeReturnedData<DieTempRegisterBytes, DieTemp_t>(returnedData.value()));
+}
 
-    return Current * CurrentLSB;
+etl::expected<double, INA228::Error> INA228::getEnergy() const {
+    constexpr auto EnergyRegisterBytes = static_cast<RegisterBytesNumber_t>(RegisterBytesNumber::ENERGY);
+    const auto returnedData = readRegister<EnergyRegisterBytes>(RegisterAddress::ENERGY);
+
+    if (not returnedData) {
+        return etl::unexpected(returnedData.error());
+    }
+
+    return convertEnergy(decodeReturnedData<EnergyRegisterBytes, Energy_t>(returnedData.value()));
 }
 
-float INA228::getPower() const {
-    constexpr auto PowerRegisterBytes = static_cast<RegisterBytesNumber_t>(RegisterBytesNumber::POWER);
-    auto returnedData = readRegister<PowerRegisterBytes>(RegisterAddress::POWER);
+etl::expected<float, INA228::Error> INA228::getShuntVoltage() const {
+    constexpr auto VShuntRegisterBytes = static_cast<RegisterBytesNumber_t>(RegisterBytesNumber::VSHUNT);
+    const auto returnedData = readRegister<VShuntRegisterBytes>(RegisterAddress::VSHUNT);
 
-    auto power = decodeReturnedData<PowerRegisterBytes, Power_t>(returnedData);
+    if (not returnedData) {
+        return etl::unexpected(returnedData.error());
+    }
 
-    const float Resolution = 3.2f * CurrentLSB;
+    return convertShuntVoltage(decodeReturnedData<VShuntRegisterBytes, ShuntVoltage_t>(returnedData.value()));
+}
 
-    return Resolution * static_cast<float>(power);
+etl::expected<int32_t, INA228::Error> INA228::getCurrentMicroAmperes() const {
+    constexpr auto CurrentRegisterBytes = static_cast<RegisterBytesNumber_t>(RegisterBytesNumber::CURRENT);
+    const auto returnedData = readRegister<CurrentRegisterBytes>(RegisterAddress::CURRENT);
+
+    if (not returnedData) {
+        return etl::unexpected(returnedData.error());
+    }
+
+    return convertCurrentMicroAmperes(decodeReturnedData<CurrentRegisterBytes, Current_t>(returnedData.value()));
 }
 
-float INA228::getVoltage() const {
-    constexpr auto VBusRegisterBytes = static_cast<RegisterBytesNumber_t>(RegisterBytesNumber::VBUS);
-    auto returnedData = readRegister<VBusRegisterBytes>(RegisterAddress::VBUS);
+etl::expected<uint32_t, INA228::Error> INA228::getPowerMicroWatts() const {
+    constexpr auto PowerRegisterBytes = static_cast<RegisterBytesNumber_t>(RegisterBytesNumber::POWER);
+    const auto returnedData = readRegister<PowerRegisterBytes>(RegisterAddress::POWER);
 
-    auto busVoltage = decodeReturnedData<VBusRegisterBytes, BusVoltage_t>(returnedData);
+    if (not returnedData) {
+        return etl::unexpected(returnedData.error());
+    }
 
-    busVoltage = (busVoltage >> 4) & 0xFFFFF;
+    return convertPowerMicroWatts(decodeReturnedData<PowerRegisterBytes, Power_t>(returnedData.value()));
+}
 
-    constexpr float ResolutionSize = 0.0001953125f;
+etl::expected<int32_t, INA228::Error> INA228::getVoltageMicroVolts() const {
+    constexpr auto VBusRegisterBytes = static_cast<RegisterBytesNumber_t>(RegisterBytesNumber::VBUS);
+    const auto returnedData = readRegister<VBusRegisterBytes>(RegisterAddress::VBUS);
 
-    return static_cast<float>(busVoltage) * ResolutionSize;
+    if (not returnedData) {
+        return etl::unexpected(returnedData.error());
+    }
+
+    return convertVoltageMicroVolts(decodeReturnedData<VBusRegisterBytes, BusVoltage_t>(returnedData.value()));
 }
 
-float INA228::getDieTemperature() const {
+etl::expected<int32_t, INA228::Error> INA228::getDieTemperatureMilliCelsius() const {
     constexpr auto DieTempRegisterBytes = static_cast<RegisterBytesNumber_t>(RegisterBytesNumber::DIETEMP);
-    auto returnedData = readRegister<DieTempRegisterBytes>(RegisterAddress::DIETEMP);
+    const auto returnedData = readRegister<DieTempRegisterBytes>(RegisterAddress::DIETEMP);
 
-    const auto InternalTemperature = [=]() -> float {
-        auto internalTemperature = decodeReturnedData<DieTempRegisterBytes, DieTemp_t>(returnedData);
+    if (not returnedData) {
+        return etl::unexpected(returnedData.error());
+    }
 
-        const DieTemp_t Sign = internalTemperature & 0x8000;
+    return convertDieTemperatureMilliCelsius(
+            decodeReturnedData<DieTempRegisterBytes, DieTemp_t>(returnedData.value()));
+}
 
-        if (Sign != 0) {
-            internalTemperature = (~internalTemperature & 0xFFFFF) + 1;
-            const auto InternalTemperatureFloat = -static_cast<float>(internalTemperature);
-            return InternalTemperatureFloat;
-        }
+etl::expected<uint64_t, INA228::Error> INA228::getEnergyMicroJoules() const {
+    const auto Energy = readEnergyRegister();
 
-        return static_cast<float>(internalTemperature);
-    }();
+    if (not Energy) {
+        return etl::unexpected(Energy.error());
+    }
 
-    constexpr float ResolutionSize = 0.0078125f;
+    return convertEnergyMicroJoules(Energy.value());
+}
 
-    return InternalTemperature * ResolutionSize;
+etl::expected<int32_t, INA228::Error> INA228::getShuntVoltageNanoVolts() const {
+    constexpr auto VShuntRegisterBytes = static_cast<RegisterBytesNumber_t>(RegisterBytesNumber::VSHUNT);
+    const auto returnedData = readRegister<VShuntRegisterBytes>(RegisterAddress::VSHUNT);
+
+    if (not returnedData) {
+        return etl::unexpected(returnedData.error());
+    }
+
+    return convertShuntVoltageNanoVolts(
+            decodeReturnedData<VShuntRegisterBytes, ShuntVoltage_t>(returnedData.value()));
+}
+
+etl::expected<double, INA228::Error> INA228::getCharge() const {
+    const auto Charge = readChargeRegister();
+
+    if (not Charge) {
+        return etl::unexpected(Charge.error());
+    }
+
+    return static_cast<double>(Charge.value()) * static_cast<double>(CurrentLSB);
 }
 
-double INA228::getEnergy() const {
+etl::expected<uint64_t, INA228::Error> INA228::readEnergyRegister() const {
     constexpr auto EnergyRegisterBytes = static_cast<RegisterBytesNumber_t>(RegisterBytesNumber::ENERGY);
-    auto returnedData = readRegister<EnergyRegisterBytes>(RegisterAddress::ENERGY);
+    const auto returnedData = readRegister<EnergyRegisterBytes>(RegisterAddress::ENERGY);
 
-    auto energy = decodeReturnedData<EnergyRegisterBytes>(returnedData);
+    if (not returnedData) {
+        return etl::unexpected(returnedData.error());
+    }
 
-    static_assert(sizeof(double) == 8, "double is less than 64 bits");
+    return decodeReturnedData<EnergyRegisterBytes, Energy_t>(returnedData.value());
+}
 
-    const double Resolution = 16.0f * 3.2f * CurrentLSB;
+etl::expected<int64_t, INA228::Error> INA228::readChargeRegister() const {
+    constexpr auto ChargeRegisterBytes = static_cast<RegisterBytesNumber_t>(RegisterBytesNumber::CHARGE);
+    const auto returnedData = readRegister<ChargeRegisterBytes>(RegisterAddress::CHARGE);
 
-    return Resolution * static_cast<double>(energy);
+    if (not returnedData) {
+        return etl::unexpected(returnedData.error());
+    }
+
+    return decodeSigned40Bit(decodeReturnedData<ChargeRegisterBytes, Charge_t>(returnedData.value()));
+}
+
+etl::expected<void, INA228::Error> INA228::resetAccumulators() const {
+    const auto Value = static_cast<uint16_t>(static_cast<uint16_t>(ConfigurationSelected) | ResetAccumulationMask);
+
+    return writeRegister(RegisterAddress::CONFIG, Value);
+}
+
+uint64_t INA228::convertEnergyMicroJoules(uint64_t energy) const {
+    // The accumulated value times the scale may overflow 64 bits, so the quotient and remainder by the
+    // denominator are scaled separately
+    const auto Numerator = static_cast<uint64_t>(EnergyLSBPerCurrentUnit.numerator) * MaximumExpectedCurrentMicroAmperes;
+    const auto Denominator = static_cast<uint64_t>(EnergyLSBPerCurrentUnit.denominator);
+
+    return (energy / Denominator) * Numerator + ((energy % Denominator) * Numerator) / Denominator;
+}
+
+int64_t INA228::convertChargeMicroCoulombs(int64_t charge) const {
+    const auto Numerator = static_cast<int64_t>(MaximumExpectedCurrentMicroAmperes);
+    constexpr int64_t Denominator = int64_t{1} << 19;
+
+    return (charge / Denominator) * Numerator + ((charge % Denominator) * Numerator) / Denominator;
+}
+
+int32_t INA228::convertCurrentMicroAmperes(uint32_t current) const {
+    return static_cast<int32_t>(static_cast<int64_t>(decodeSigned20Bit(current)) * MaximumExpectedCurrentMicroAmperes /
+                                (int64_t{1} << 19));
+}
+
+uint32_t INA228::convertPowerMicroWatts(uint32_t power) const {
+    return static_cast<uint32_t>(static_cast<int64_t>(power) * MaximumExpectedCurrentMicroAmperes *
+                                 PowerLSBPerCurrentUnit.numerator / PowerLSBPerCurrentUnit.denominator);
+}
+
+int32_t INA228::convertVoltageMicroVolts(uint32_t busVoltage) const {
+    return static_cast<int32_t>(BusVoltageMicroVolts.apply(decodeSigned20Bit(busVoltage)));
+}
+
+int32_t INA228::convertDieTemperatureMilliCelsius(uint16_t dieTemperature) const {
+    return static_cast<int32_t>(DieTemperatureMilliCelsius.apply(decodeSigned16Bit(dieTemperature)));
+}
+
+int32_t INA228::convertShuntVoltageNanoVolts(uint32_t shuntVoltage) const {
+    const ScaleFactor Resolution = (ConfigurationSelected == Configuration::Configuration2)
+                                   ? ShuntVoltageNanoVoltsRange1 : ShuntVoltageNanoVoltsRange0;
+
+    return static_cast<int32_t>(Resolution.apply(decodeSigned20Bit(shuntVoltage)));
 }
 
-float INA228::getShuntVoltage() const {
+etl::expected<INA228::Snapshot, INA228::Error> INA228::readAll() const {
     constexpr auto VShuntRegisterBytes = static_cast<RegisterBytesNumber_t>(RegisterBytesNumber::VSHUNT);
-    auto returnedData = readRegister<VShuntRegisterBytes>(RegisterAddress::VSHUNT);
+    constexpr auto VBusRegisterBytes = static_cast<RegisterBytesNumber_t>(RegisterBytesNumber::VBUS);
+    constexpr auto DieTempRegisterBytes = static_cast<RegisterBytesNumber_t>(RegisterBytesNumber::DIETEMP);
+    constexpr auto CurrentRegisterBytes = static_cast<RegisterBytesNumber_t>(RegisterBytesNumber::CURRENT);
+    constexpr auto PowerRegisterBytes = static_cast<RegisterBytesNumber_t>(RegisterBytesNumber::POWER);
+    constexpr auto EnergyRegisterBytes = static_cast<RegisterBytesNumber_t>(RegisterBytesNumber::ENERGY);
+
+    Snapshot snapshot;
+
+    snapshot.timestamp = xTaskGetTickCount();
+
+    const auto shuntVoltageData = readRegister<VShuntRegisterBytes>(RegisterAddress::VSHUNT);
+    if (not shuntVoltageData) {
+        return etl::unexpected(shuntVoltageData.error());
+    }
+    const auto busVoltageData = readRegister<VBusRegisterBytes>(RegisterAddress::VBUS);
+    if (not busVoltageData) {
+        return etl::unexpected(busVoltageData.error());
+    }
+    const auto dieTemperatureData = readRegister<DieTempRegisterBytes>(RegisterAddress::DIETEMP);
+    if (not dieTemperatureData) {
+        return etl::unexpected(dieTemperatureData.error());
+    }
+    const auto currentData = readRegister<CurrentRegisterBytes>(RegisterAddress::CURRENT);
+    if (not currentData) {
+        return etl::unexpected(currentData.error());
+    }
+    const auto powerData = readRegister<PowerRegisterBytes>(RegisterAddress::POWER);
+    if (not powerData) {
+        return etl::unexpected(powerData.error());
+    }
+    const auto energyData = readRegister<EnergyRegisterBytes>(RegisterAddress::ENERGY);
+    if (not energyData) {
+        return etl::unexpected(energyData.error());
+    }
+
+    snapshot.shuntVoltage = convertShuntVoltage(
+            decodeReturnedData<VShuntRegisterBytes, ShuntVoltage_t>(shuntVoltageData.value()));
+    snapshot.busVoltage = convertVoltage(decodeReturnedData<VBusRegisterBytes, BusVoltage_t>(busVoltageData.value()));
+    snapshot.dieTemperature = convertDieTemperature(
+            decodeReturnedData<DieTempRegisterBytes, DieTemp_t>(dieTemperatureData.value()));
+    snapshot.current = convertCurrent(decodeReturnedData<CurrentRegisterBytes, Current_t>(currentData.value()));
+    snapshot.power = convertPower(decodeReturnedData<PowerRegisterBytes, Power_t>(powerData.value()));
+    snapshot.energy = convertEnergy(decodeReturnedData<EnergyRegisterBytes, Energy_t>(energyData.value()));
+
+    return snapshot;
+}
+
+etl::expected<void, INA228::Error> INA228::configureADC(ADCMode mode, ConversionTime busVoltageConversionTime,
+                                                        ConversionTime shuntVoltageConversionTime,
+                                                        ConversionTime temperatureConversionTime,
+                                                        AveragingCount averagingCount) {
+    const uint16_t Value = makeADCConfiguration(mode, busVoltageConversionTime, shuntVoltageConversionTime,
+                                                temperatureConversionTime, averagingCount);
+
+    if (auto written = writeRegister(RegisterAddress::ADC_CONFIG, Value); not written) {
+        return written;
+    }
+
+    ADCConfigurationValue = Value;
+    return {};
+}
 
-    const auto ShuntVoltage = [=]() -> float {
-        auto shuntVoltage = decodeReturnedData<VShuntRegisterBytes, ShuntVoltage_t>(returnedData);
+etl::expected<INA228::ADCTuning, INA228::Error> INA228::autoTuneADC(uint32_t maximumSamplePeriodMicroSeconds,
+                                                                    uint32_t maximumShuntNoiseNanoVolts,
+                                                                    uint8_t calibrationSamples) {
+    struct Candidate {
+        uint8_t averaging;
+        uint8_t conversionTime;
+        uint32_t integrationMicroSeconds;
+        uint32_t periodMicroSeconds;
+    };
+
+    constexpr auto TemperatureConversionTime = ConversionTime::Time50us;
+    const uint32_t TemperatureMicroSeconds = ConversionTimesMicroSeconds[static_cast<uint8_t>(TemperatureConversionTime)];
+
+    etl::array<Candidate, ConversionTimesMicroSeconds.size() * AveragingCounts.size()> candidates{};
+    size_t candidatesNumber = 0;
+
+    for (uint8_t averaging = 0; averaging < AveragingCounts.size(); averaging++) {
+        for (uint8_t conversionTime = 0; conversionTime < ConversionTimesMicroSeconds.size(); conversionTime++) {
+            const uint32_t Period = AveragingCounts[averaging] *
+                                    (2 * ConversionTimesMicroSeconds[conversionTime] + TemperatureMicroSeconds);
+
+            if (Period > maximumSamplePeriodMicroSeconds) {
+                continue;
+            }
+
+            const Candidate NewCandidate{averaging, conversionTime,
+                                         static_cast<uint32_t>(AveragingCounts[averaging]) *
+                                         ConversionTimesMicroSeconds[conversionTime], Period};
+
+            // Insertion by integration time, which the noise decreases with
+            size_t position = candidatesNumber;
+            while ((position > 0) and
+                   (candidates[position - 1].integrationMicroSeconds > NewCandidate.integrationMicroSeconds)) {
+                candidates[position] = candidates[position - 1];
+                position--;
+            }
+            candidates[position] = NewCandidate;
+            candidatesNumber++;
+        }
+    }
 
-        shuntVoltage = (shuntVoltage >> 4) & 0xFFFFF;
+    if (candidatesNumber == 0) {
+        LOG_ERROR << "Current monitor ADC tuning: no configuration fits in the sample period";
+        return etl::unexpected(Error::OutOfRange);
+    }
 
-        const ShuntVoltage_t Sign = shuntVoltage & 0x80000;
+    if (calibrationSamples < 2) {
+        calibrationSamples = 2;
+    }
 
-        if (Sign != 0) {
-            shuntVoltage = (~shuntVoltage & 0xFFFFF) + 1;
-            auto ShuntVoltageFloat = -static_cast<float>(shuntVoltage);
-            return ShuntVoltageFloat;
+    const auto Mode = static_cast<ADCMode>(ADCConfigurationValue >> 12);
+    const uint64_t MaximumVariance = static_cast<uint64_t>(maximumShuntNoiseNanoVolts) * maximumShuntNoiseNanoVolts;
+
+    auto measureCandidate = [&](const Candidate &tested) -> etl::expected<uint64_t, Error> {
+        if (auto configured = configureADC(ADCMode::ContinuousAll,
+                                           static_cast<ConversionTime>(tested.conversionTime),
+                                           static_cast<ConversionTime>(tested.conversionTime),
+                                           TemperatureConversionTime,
+                                           static_cast<AveragingCount>(tested.averaging)); not configured) {
+            return etl::unexpected(configured.error());
         }
 
-        return static_cast<float>(shuntVoltage);
-    }();
+        return measureShuntVoltageVariance(tested.periodMicroSeconds, calibrationSamples);
+    };
+
+    // Binary search of the shortest integration time within the noise target, the longest one if none is
+    size_t low = 0;
+    size_t high = candidatesNumber - 1;
+    etl::optional<size_t> measuredIndex;
+    uint64_t measuredVariance = 0;
+
+    while (low < high) {
+        const size_t Middle = low + (high - low) / 2;
+        const auto Variance = measureCandidate(candidates[Middle]);
+
+        if (not Variance) {
+            return etl::unexpected(Variance.error());
+        }
+
+        if (Variance.value() <= MaximumVariance) {
+            high = Middle;
+            measuredIndex = Middle;
+            measuredVariance = Variance.value();
+        } else {
+            low = Middle + 1;
+        }
+    }
+
+    if (measuredIndex != low) {
+        const auto Variance = measureCandidate(candidates[low]);
+
+        if (not Variance) {
+            return etl::unexpected(Variance.error());
+        }
+
+        measuredVariance = Variance.value();
+    }
+
+    const Candidate &Selected = candidates[low];
+    const uint64_t SelectedVariance = measuredVariance;
+
+    ADCTuning tuning;
+    tuning.averagingCount = static_cast<AveragingCount>(Selected.averaging);
+    tuning.conversionTime = static_cast<ConversionTime>(Selected.conversionTime);
+    tuning.conversionPeriodMicroSeconds = Selected.periodMicroSeconds;
+    tuning.meetsNoiseTarget = SelectedVariance <= MaximumVariance;
+
+    // Integer square root of the variance
+    uint64_t noise = 0;
+    for (uint64_t bit = uint64_t{1} << 31; bit != 0; bit >>= 1) {
+        if ((noise + bit) * (noise + bit) <= SelectedVariance) {
+            noise += bit;
+        }
+    }
+    tuning.shuntNoiseNanoVolts = static_cast<uint32_t>(noise);
+
+    if (auto configured = configureADC(Mode, tuning.conversionTime, tuning.conversionTime, TemperatureConversionTime,
+                                       tuning.averagingCount); not configured) {
+        return etl::unexpected(configured.error());
+    }
+
+    return tuning;
+}
+
+etl::expected<uint64_t, INA228::Error> INA228::measureShuntVoltageVariance(uint32_t conversionPeriodMicroSeconds,
+                                                                          uint8_t samplesNumber) const {
+    const TickType_t ConversionPeriodTicks = pdMS_TO_TICKS((conversionPeriodMicroSeconds + 999) / 1000) + 1;
+
+    // The first conversion may have started with the previous configuration
+    vTaskDelay(ConversionPeriodTicks);
+
+    int32_t firstSample = 0;
+    int64_t sum = 0;
+    int64_t sumOfSquares = 0;
+
+    for (uint8_t i = 0; i < samplesNumber; i++) {
+        const auto Sample = getShuntVoltageNanoVolts();
+
+        if (not Sample) {
+            return etl::unexpected(Sample.error());
+        }
+
+        if (i == 0) {
+            firstSample = Sample.value();
+        }
+
+        // The offset from the first sample keeps the sums small, so they are exact in 64 bits
+        const int64_t Offset = static_cast<int64_t>(Sample.value()) - firstSample;
+        sum += Offset;
+        sumOfSquares += Offset * Offset;
+
+        vTaskDelay(ConversionPeriodTicks);
+    }
+
+    const auto SamplesNumber = static_cast<int64_t>(samplesNumber);
+    const int64_t Numerator = SamplesNumber * sumOfSquares - sum * sum;
+
+    return static_cast<uint64_t>(Numerator / (SamplesNumber * (SamplesNumber - 1)));
+}
+
+etl::expected<void, INA228::Error> INA228::startContinuousSampling(PIO_PIN alertPin, TaskHandle_t samplingTask) {
+    configASSERT((alertPin != PIO_PIN_NONE) and (samplingTask != nullptr));
+
+    samplingTaskHandle = samplingTask;
+    samples.clear();
+    missedConversions = 0;
+    signalledConversions = 0;
+    unsignalledConversions = 0;
+    samplingPeriodMicroSeconds = 0;
+
+    if (auto written = writeDiagnosticAlertConfiguration(); not written) {
+        samplingTaskHandle = nullptr;
+        return written;
+    }
+
+    attachAlertPin(alertPin);
+
+    // The conversion ready flag of an earlier conversion is cleared, so that a notification left from a previous
+    // run is not taken for a conversion. The pin is attached first, to not miss the edge of a following conversion
+    const auto Flags = readDiagnosticFlags();
+
+    if (not Flags) {
+        samplingTaskHandle = nullptr;
+        detachAlertPin();
+        return etl::unexpected(Flags.error());
+    }
+
+    pendingDiagnosticFlags = Flags.value() & LimitFlagsMask;
+
+    const auto Value = static_cast<uint16_t>((ADCConfigurationValue & 0x0FFF) |
+                                             (static_cast<uint16_t>(ADCMode::ContinuousAll) << 12));
+
+    if (auto written = writeRegister(RegisterAddress::ADC_CONFIG, Value); not written) {
+        samplingTaskHandle = nullptr;
+        detachAlertPin();
+        return written;
+    }
+
+    ADCConfigurationValue = Value;
+
+    // Writing ADC_CONFIG restarts the conversions, after the initial delay of CONFIG in steps of 2 ms
+    samplingStartTick = xTaskGetTickCount();
+    samplingDelayMicroSeconds = ((static_cast<uint16_t>(ConfigurationSelected) >> 6) & 0xFF) * 2000;
+    samplingPeriodMicroSeconds = getConversionPeriodMicroSeconds(Value);
+
+    return {};
+}
+
+etl::expected<void, INA228::Error> INA228::stopContinuousSampling() {
+    samplingTaskHandle = nullptr;
+    samplingPeriodMicroSeconds = 0;
+    detachAlertPin();
+
+    const auto Value = static_cast<uint16_t>((ADCConfigurationValue & 0x0FFF) |
+                                             (static_cast<uint16_t>(ADCConfigurationSelected) & 0xF000));
+
+    if (auto written = writeDiagnosticAlertConfiguration(); not written) {
+        return written;
+    }
+
+    if (auto written = writeRegister(RegisterAddress::ADC_CONFIG, Value); not written) {
+        return written;
+    }
+
+    ADCConfigurationValue = Value;
+    return {};
+}
+
+etl::expected<void, INA228::Error> INA228::serviceConversionReady(TickType_t timeout) {
+    constexpr auto DiagAlrtRegisterBytes = static_cast<RegisterBytesNumber_t>(RegisterBytesNumber::DIAG_ALRT);
+
+    const uint32_t Notifications = ulTaskNotifyTake(pdTRUE, timeout);
+
+    if (Notifications == 0) {
+        return etl::unexpected(Error::Timeout);
+    }
+
+    // Reading DIAG_ALRT clears the conversion ready flag and releases the ALERT pin. It is read before the results,
+    // so that a conversion completing during the readout asserts the pin again and is signalled
+    const auto diagnosticAlertData = readRegister<DiagAlrtRegisterBytes>(RegisterAddress::DIAG_ALRT);
+
+    if (diagnosticAlertData) {
+        const auto Flags = decodeReturnedData<DiagAlrtRegisterBytes, DiagnosticAlert_t>(diagnosticAlertData.value());
+        pendingDiagnosticFlags |= Flags & LimitFlagsMask;
+
+        if ((Flags & static_cast<DiagnosticAlert_t>(DiagnosticAlert::CNVRF)) == 0) {
+            // No conversion completed since the previous read, e.g. the notification is left from a conversion
+            // signalled after the readout of a previous continuous sampling run
+            return {};
+        }
+    }
+
+    missedConversions += Notifications - 1;
+    signalledConversions += Notifications;
+
+    const auto Sample = readAll();
+
+    updateUnsignalledConversions();
+
+    if (not Sample) {
+        return etl::unexpected(Sample.error());
+    }
+
+    taskENTER_CRITICAL();
+    if (samples.full()) {
+        missedConversions++;
+    }
+    samples.push(Sample.value());
+    taskEXIT_CRITICAL();
+
+    if (not diagnosticAlertData) {
+        return etl::unexpected(diagnosticAlertData.error());
+    }
+
+    return {};
+}
+
+void INA228::updateUnsignalledConversions() {
+    if (samplingPeriodMicroSeconds == 0) {
+        return;
+    }
+
+    // The start tick and the current tick are both truncated, so one tick is subtracted from the elapsed time to
+    // never count a conversion that has not completed yet
+    const TickType_t ElapsedTicks = xTaskGetTickCount() - samplingStartTick;
+    const uint64_t ElapsedMicroSeconds = (ElapsedTicks > 1) ? static_cast<uint64_t>(ElapsedTicks - 1) *
+                                                              portTICK_PERIOD_MS * 1000 : 0;
+
+    if (ElapsedMicroSeconds <= samplingDelayMicroSeconds) {
+        return;
+    }
+
+    const uint64_t CompletedConversions = (ElapsedMicroSeconds - samplingDelayMicroSeconds) /
+                                          samplingPeriodMicroSeconds;
+
+    // A conversion completing while the latched ALERT pin is still asserted makes no edge, so it is only seen as
+    // the difference between the conversions that the elapsed time accounts for and the signalled ones
+    if (CompletedConversions > static_cast<uint64_t>(signalledConversions) + unsignalledConversions) {
+        unsignalledConversions = static_cast<uint32_t>(CompletedConversions - signalledConversions);
+    }
+}
+
+uint32_t INA228::getConversionPeriodMicroSeconds(uint16_t adcConfiguration) {
+    const uint32_t BusMicroSeconds = ConversionTimesMicroSeconds[(adcConfiguration >> 9) & 0x7];
+    const uint32_t ShuntMicroSeconds = ConversionTimesMicroSeconds[(adcConfiguration >> 6) & 0x7];
+    const uint32_t TemperatureMicroSeconds = ConversionTimesMicroSeconds[(adcConfiguration >> 3) & 0x7];
+
+    return AveragingCounts[adcConfiguration & 0x7] * (BusMicroSeconds + ShuntMicroSeconds + TemperatureMicroSeconds);
+}
+
+etl::optional<INA228::Snapshot> INA228::getSample() {
+    etl::optional<Snapshot> sample;
+
+    taskENTER_CRITICAL();
+    if (not samples.empty()) {
+        sample = samples.front();
+        samples.pop();
+    }
+    taskEXIT_CRITICAL();
+
+    return sample;
+}
+
+etl::expected<void, INA228::Error> INA228::setShuntVoltageLimits(int32_t overVoltageNanoVolts,
+                                                                  int32_t underVoltageNanoVolts) const {
+    const int64_t ResolutionNanoVolts = (ConfigurationSelected == Configuration::Configuration2) ? 1250 : 5000;
+
+    if (auto written = writeLimit(RegisterAddress::SOVL, overVoltageNanoVolts / ResolutionNanoVolts, INT16_MIN,
+                                  INT16_MAX); not written) {
+        return written;
+    }
+
+    return writeLimit(RegisterAddress::SUVL, underVoltageNanoVolts / ResolutionNanoVolts, INT16_MIN, INT16_MAX);
+}
+
+etl::expected<void, INA228::Error> INA228::setOvercurrentLimit(int32_t overCurrentMicroAmperes) const {
+    const int64_t ResolutionNanoVolts = (ConfigurationSelected == Configuration::Configuration2) ? 1250 : 5000;
+    const auto OverVoltageNanoVolts = static_cast<int64_t>(round(static_cast<float>(overCurrentMicroAmperes) *
+                                                                 ShuntResistor * 1000.0f));
+
+    return writeLimit(RegisterAddress::SOVL, OverVoltageNanoVolts / ResolutionNanoVolts, INT16_MIN, INT16_MAX);
+}
+
+etl::expected<void, INA228::Error> INA228::setBusVoltageLimits(uint32_t overVoltageMicroVolts,
+                                                               uint32_t underVoltageMicroVolts) const {
+    constexpr int64_t ResolutionMicroVolts = 3125;
+
+    if (auto written = writeLimit(RegisterAddress::BOVL, overVoltageMicroVolts / ResolutionMicroVolts, 0, 0x7FFF);
+            not written) {
+        return written;
+    }
+
+    return writeLimit(RegisterAddress::BUVL, underVoltageMicroVolts / ResolutionMicroVolts, 0, 0x7FFF);
+}
+
+etl::expected<void, INA228::Error> INA228::setTemperatureLimit(int32_t overTemperatureMilliCelsius) const {
+    const int64_t Value = static_cast<int64_t>(overTemperatureMilliCelsius) * DieTemperatureMilliCelsius.denominator /
+                          DieTemperatureMilliCelsius.numerator;
+
+    return writeLimit(RegisterAddress::TEMP_LIMIT, Value, INT16_MIN, INT16_MAX);
+}
+
+etl::expected<void, INA228::Error> INA228::setPowerLimit(uint32_t overPowerMicroWatts) const {
+    constexpr int64_t PowerLimitLSBs = 256;
+
+    const int64_t Value = static_cast<int64_t>(overPowerMicroWatts) * PowerLSBPerCurrentUnit.denominator /
+                          (PowerLimitLSBs * PowerLSBPerCurrentUnit.numerator * MaximumExpectedCurrentMicroAmperes);
+
+    return writeLimit(RegisterAddress::PWR_LIMIT, Value, 0, UINT16_MAX);
+}
+
+etl::expected<void, INA228::Error> INA228::enableAlert(PIO_PIN alertPin, AlertCallback callback, uintptr_t context,
+                                                       bool latch, bool slowAlert) {
+    configASSERT((alertPin != PIO_PIN_NONE) and (callback != nullptr));
+
+    diagnosticAlertConfiguration = 0;
+
+    if (latch) {
+        diagnosticAlertConfiguration |= static_cast<DiagnosticAlert_t>(DiagnosticAlert::ALATCH);
+    }
+
+    if (slowAlert) {
+        diagnosticAlertConfiguration |= static_cast<DiagnosticAlert_t>(DiagnosticAlert::SLOWALERT);
+    }
+
+    if (auto written = writeDiagnosticAlertConfiguration(); not written) {
+        return written;
+    }
+
+    taskENTER_CRITICAL();
+    alertCallback = callback;
+    alertCallbackContext = context;
+    taskEXIT_CRITICAL();
+
+    attachAlertPin(alertPin);
+
+    return {};
+}
+
+etl::expected<void, INA228::Error> INA228::disableAlert() {
+    taskENTER_CRITICAL();
+    alertCallback = nullptr;
+    alertCallbackContext = 0;
+    taskEXIT_CRITICAL();
+
+    detachAlertPin();
+
+    diagnosticAlertConfiguration = 0;
+
+    return writeDiagnosticAlertConfiguration();
+}
+
+etl::expected<INA228::DiagnosticAlert_t, INA228::Error> INA228::readDiagnosticFlags() const {
+    constexpr auto DiagAlrtRegisterBytes = static_cast<RegisterBytesNumber_t>(RegisterBytesNumber::DIAG_ALRT);
+
+    const auto returnedData = readRegister<DiagAlrtRegisterBytes>(RegisterAddress::DIAG_ALRT);
+
+    if (not returnedData) {
+        return etl::unexpected(returnedData.error());
+    }
+
+    const auto Flags = static_cast<DiagnosticAlert_t>(
+            decodeReturnedData<DiagAlrtRegisterBytes, DiagnosticAlert_t>(returnedData.value()) | pendingDiagnosticFlags);
+
+    pendingDiagnosticFlags = 0;
+
+    return Flags;
+}
+
+etl::expected<void, INA228::Error> INA228::writeLimit(RegisterAddress registerAddress, int64_t value, int64_t minimum,
+                                                      int64_t maximum) const {
+    if ((value < minimum) or (value > maximum)) {
+        LOG_ERROR << "Current monitor limit out of range";
+        return etl::unexpected(Error::OutOfRange);
+    }
+
+    return writeRegister(registerAddress, static_cast<uint16_t>(value));
+}
+
+etl::expected<void, INA228::Error> INA228::writeDiagnosticAlertConfiguration() const {
+    DiagnosticAlert_t value = diagnosticAlertConfiguration;
+
+    if (samplingTaskHandle != nullptr) {
+        // The latched ALERT pin stays asserted until DIAG_ALRT is read, so no conversion ready edge is lost
+        value |= static_cast<DiagnosticAlert_t>(DiagnosticAlert::ALATCH) |
+                 static_cast<DiagnosticAlert_t>(DiagnosticAlert::CNVR);
+    }
+
+    return writeRegister(RegisterAddress::DIAG_ALRT, value);
+}
+
+void INA228::attachAlertPin(PIO_PIN alertPin) {
+    if (AlertPin != PIO_PIN_NONE) {
+        configASSERT(AlertPin == alertPin);
+        return;
+    }
+
+    AlertPin = alertPin;
+    PIO_PinInterruptCallbackRegister(AlertPin, alertPinCallback, reinterpret_cast<uintptr_t>(this));
+    PIO_PinInterruptEnable(AlertPin);
+}
+
+void INA228::detachAlertPin() {
+    if ((AlertPin == PIO_PIN_NONE) or (samplingTaskHandle != nullptr) or (alertCallback != nullptr)) {
+        return;
+    }
+
+    PIO_PinInterruptDisable(AlertPin);
+    AlertPin = PIO_PIN_NONE;
+}
+
+void INA228::alertPinCallback(PIO_PIN pin, uintptr_t context) {
+    auto *ina228 = reinterpret_cast<INA228 *>(context);
+    BaseType_t higherPriorityTaskWoken = pdFALSE;
+
+    if (ina228->alertCallback != nullptr) {
+        ina228->alertCallback(ina228->alertCallbackContext);
+    }
+
+    if (ina228->samplingTaskHandle != nullptr) {
+        vTaskNotifyGiveFromISR(ina228->samplingTaskHandle, &higherPriorityTaskWoken);
+    }
+
+    portYIELD_FROM_ISR(higherPriorityTaskWoken);
+}
+
+float INA228::convertCurrent(uint32_t current) const {
+    return static_cast<float>(decodeSigned20Bit(current)) * CurrentLSB;
+}
+
+float INA228::convertPower(uint32_t power) const {
+    const float Resolution = 3.2f * CurrentLSB;
+
+    return Resolution * static_cast<float>(power);
+}
+
+float INA228::convertVoltage(uint32_t busVoltage) const {
+    busVoltage = (busVoltage >> 4) & 0xFFFFF;
+
+    constexpr float ResolutionSize = 0.0001953125f;
+
+    return static_cast<float>(busVoltage) * ResolutionSize;
+}
+
+float INA228::convertDieTemperature(uint16_t dieTemperature) const {
+    constexpr float ResolutionSize = 0.0078125f;
+
+    return static_cast<float>(decodeSigned16Bit(dieTemperature)) * ResolutionSize;
+}
+
+double INA228::convertEnergy(uint64_t energy) const {
+    static_assert(sizeof(double) == 8, "double is less than 64 bits");
+
+    const double Resolution = 16.0f * 3.2f * CurrentLSB;
+
+    return Resolution * static_cast<double>(energy);
+}
+
+float INA228::convertShuntVoltage(uint32_t shuntVoltage) const {
+    const auto ShuntVoltage = static_cast<float>(decodeSigned20Bit(shuntVoltage));
 
     const auto ResolutionSize = [=]() -> float {
 
@@ -0,0 +1,59 @@
+#include "INA228Accumulator.hpp"
+
+using namespace INA228FixedPoint;
+
+etl::expected<void, INA228::Error> INA228Accumulator::update() {
+    const auto EnergyRegister = Device.readEnergyRegister();
+
+    if (not EnergyRegister) {
+        return etl::unexpected(EnergyRegister.error());
+    }
+
+    const auto ChargeRegister = Device.readChargeRegister();
+
+    if (not ChargeRegister) {
+        return etl::unexpected(ChargeRegister.error());
+    }
+
+    const auto ChargeRegisterUnsigned = static_cast<uint64_t>(ChargeRegister.value()) & AccumulatorMask;
+
+    if (isSynchronized) {
+        // Modulo 2^40 differences are correct across a single wrap of the registers
+        energy += (EnergyRegister.value() - lastEnergyRegister) & AccumulatorMask;
+        charge += decodeSigned40Bit(ChargeRegisterUnsigned - lastChargeRegister);
+    }
+
+    lastEnergyRegister = EnergyRegister.value();
+    lastChargeRegister = ChargeRegisterUnsigned;
+    isSynchronized = true;
+
+    return {};
+}
+
+etl::expected<void, INA228::Error> INA228Accumulator::reset() {
+    if (auto resetResult = Device.resetAccumulators(); not resetResult) {
+        return resetResult;
+    }
+
+    lastEnergyRegister = 0;
+    lastChargeRegister = 0;
+    energy = 0;
+    charge = 0;
+    isSynchronized = true;
+
+    return {};
+}
+
+uint64_t INA228Accumulator::getRemainingEnergyBudget() const {
+    const uint64_t Consumed = getEnergyMicroJoules();
+
+    if ((energyBudget == 0) or (Consumed >= energyBudget)) {
+        return 0;
+    }
+
+    return energyBudget - Consumed;
+}
+
+bool INA228Accumulator::isEnergyBudgetExceeded() const {
+    return (energyBudget != 0) and (getEnergyMicroJoules() > energyBudget);
+}
@@ -0,0 +1,109 @@
+#include "INA228Poller.hpp"
+
+etl::optional<INA228Poller::MonitorIndex> INA228Poller::registerMonitor(const INA228 &monitor, TickType_t period) {
+    const uint8_t Index = monitorsNumber.load(std::memory_order_relaxed);
+
+    if (Index >= MaximumMonitors) {
+        LOG_ERROR << "Current monitor poller is full";
+        return etl::nullopt;
+    }
+
+    Entry &entry = entries[Index];
+    entry.monitor = &monitor;
+    entry.period = (period > 0) ? period : 1;
+    entry.nextDue = xTaskGetTickCount();
+
+    monitorsNumber.store(Index + 1, std::memory_order_release);
+
+    return Index;
+}
+
+TickType_t INA228Poller::poll() {
+    const uint8_t MonitorsNumber = monitorsNumber.load(std::memory_order_acquire);
+
+    if (MonitorsNumber == 0) {
+        return portMAX_DELAY;
+    }
+
+    // Every due monitor is read once per call, starting after the one read last so that none is starved
+    for (uint8_t i = 1; i <= MonitorsNumber; i++) {
+        const auto Index = static_cast<MonitorIndex>((lastPolledIndex + i) % MonitorsNumber);
+        Entry &entry = entries[Index];
+
+        if (static_cast<int32_t>(xTaskGetTickCount() - entry.nextDue) >= 0) {
+            pollEntry(entry);
+            lastPolledIndex = Index;
+        }
+    }
+
+    const TickType_t Now = xTaskGetTickCount();
+    TickType_t delay = portMAX_DELAY;
+
+    for (uint8_t i = 0; i < MonitorsNumber; i++) {
+        const auto Remaining = static_cast<int32_t>(entries[i].nextDue - Now);
+
+        if (Remaining <= 0) {
+            return 0;
+        }
+
+        if (static_cast<TickType_t>(Remaining) < delay) {
+            delay = static_cast<TickType_t>(Remaining);
+        }
+    }
+
+    return delay;
+}
+
+void INA228Poller::run() {
+    while (true) {
+        const TickType_t Delay = poll();
+
+        // Registration may happen while the poller sleeps, so the sleep is bounded
+        constexpr TickType_t MaximumDelay = pdMS_TO_TICKS(100);
+
+        if (Delay > 0) {
+            vTaskDelay((Delay < MaximumDelay) ? Delay : MaximumDelay);
+        }
+    }
+}
+
+etl::optional<INA228Poller::Measurement> INA228Poller::getLatest(MonitorIndex index) const {
+    if (index >= monitorsNumber.load(std::memory_order_acquire)) {
+        return etl::nullopt;
+    }
+
+    const Entry &entry = entries[index];
+
+    taskENTER_CRITICAL();
+    const Measurement Latest = entry.measurement;
+    const bool HasMeasurement = entry.hasMeasurement;
+    taskEXIT_CRITICAL();
+
+    if (not HasMeasurement) {
+        return etl::nullopt;
+    }
+
+    return Latest;
+}
+
+void INA228Poller::pollEntry(Entry &entry) {
+    entry.nextDue += entry.period;
+
+    // A late poller skips the missed periods instead of reading a burst to catch up
+    if (static_cast<int32_t>(xTaskGetTickCount() - entry.nextDue) >= 0) {
+        entry.nextDue = xTaskGetTickCount() + entry.period;
+    }
+
+    const auto Snapshot = entry.monitor->readAll();
+
+    taskENTER_CRITICAL();
+    if (Snapshot) {
+        entry.measurement.snapshot = Snapshot.value();
+        entry.measurement.lastError = etl::nullopt;
+        entry.hasMeasurement = true;
+    } else {
+        entry.measurement.readErrors++;
+        entry.measurement.lastError = Snapshot.error();
+    }
+    taskEXIT_CRITICAL();
+}
@@ -2,6 +2,7 @@
 
 #include <etl/utility.h>
 #include <etl/array.h>
+#include <etl/span.h>
 #include <cstdint>
 #include "FreeRTOS.h"
 #include "Logger.hpp"
@@ -156,6 +157,44 @@ public:
      */
     void triggerOneShotMode();
 
+    /**
+     * Starts a one-shot measurement without waiting for it to complete, preserving the rest of CTRL_REG2.
+     * The completion is checked with isMeasurementReady(), so that a task can interleave the conversions of
+     * several sensors.
+     */
+    void startOneShotMeasurement();
+
+    /**
+     * Checks the pressure and temperature data available bits of the STATUS register.
+     * @return true if both a new pressure and a new temperature value are available
+     */
+    bool isMeasurementReady();
+
+    /**
+     * Reads the latest pressure and temperature values without triggering a new measurement.
+     * @return a pair of float types, the pressure in hPa and the temperature in °C
+     */
+    etl::pair<float, float> readLatestMeasurement();
+
+    /**
+     * Reads the number of unread samples stored in the FIFO (FIFO_STATUS1(25h)).
+     * @return the number of samples, up to FIFODepth
+     */
+    uint8_t getFIFOLevel();
+
+    /**
+     * Drains the FIFO with a single auto-increment read of all the stored samples. The register address rolls back
+     * from FIFO_DATA_OUT_TEMP_H to FIFO_DATA_OUT_PRESS_XL, so that consecutive samples are read in one transaction.
+     * @param samples the read samples, pairs of the pressure in hPa and the temperature in °C, oldest first
+     * @return the number of samples written, at most the size of samples
+     */
+    size_t readFIFO(etl::span<etl::pair<float, float>> samples);
+
+    /**
+     * The number of samples the FIFO can store.
+     */
+    static constexpr uint8_t FIFODepth = 128;
+
 private:
     /**
      * I2C device address.
@@ -179,6 +218,26 @@ private:
      */
     static constexpr uint8_t NumberOfBytesToReadFromRegister = 1;
 
+    /**
+     * The number of bytes of the pressure output registers, PRESSURE_OUT_XL to PRESSURE_OUT_H.
+     */
+    static constexpr uint8_t NumberOfBytesOfPressure = 3;
+
+    /**
+     * The number of bytes of the temperature output registers, TEMP_OUT_L to TEMP_OUT_H.
+     */
+    static constexpr uint8_t NumberOfBytesOfTemperature = 2;
+
+    /**
+     * The number of bytes of a sample, the pressure followed by the temperature output registers.
+     */
+    static constexpr uint8_t NumberOfBytesOfSample = NumberOfBytesOfPressure + NumberOfBytesOfTemperature;
+
+    /**
+     * Buffer of the FIFO reads, large enough for a full FIFO.
+     */
+    etl::array<uint8_t, FIFODepth * NumberOfBytesOfSample> fifoBuffer{};
+
     /**
      * Wait period before for abandoning an I2C transaction because the send/receive buffer does not get unloaded/gets loaded.
      */
@@ -194,6 +253,27 @@ private:
      */
     static constexpr  uint8_t TemperatureSensitivity = 100;
 
+    /**
+     * The ONE_SHOT bit of the Control Register 2.
+     */
+    static constexpr uint8_t OneShotBit = 0x01;
+
+    /**
+     * The IF_ADD_INC bit of the Control Register 2, which increments the register address during multiple byte
+     * accesses. It is set by default.
+     */
+    static constexpr uint8_t AutoIncrementBit = 0x10;
+
+    /**
+     * The pressure data available (P_DA) bit of the STATUS register.
+     */
+    static constexpr uint8_t PressureDataAvailableBit = 0x01;
+
+    /**
+     * The temperature data available (T_DA) bit of the STATUS register.
+     */
+    static constexpr uint8_t TemperatureDataAvailableBit = 0x02;
+
     /**
      * Function that prevents hanging when a I2C device is not responding.
      */
@@ -238,4 +318,49 @@ private:
      */
     uint8_t readFromRegister(RegisterAddress registerAddress);
 
+    /**
+     * Reads consecutive registers in a single auto-increment transaction.
+     * @param registerAddress the address of the first register
+     * @param registerData the read data, its size is the number of bytes to read
+     * @return true if the transaction was successful
+     */
+    bool readFromRegisters(RegisterAddress registerAddress, etl::span<uint8_t> registerData);
+
+    /**
+     * Converts the pressure output bytes to hPa.
+     * @param pressureOut the PRESSURE_OUT_XL, PRESSURE_OUT_L and PRESSURE_OUT_H bytes, in this order
+     * @return the pressure in hPa
+     */
+    static float convertPressure(const uint8_t *pressureOut) {
+        const auto pressureData = static_cast<int32_t>((static_cast<uint32_t>(pressureOut[2]) << 24) |
+                                                       (static_cast<uint32_t>(pressureOut[1]) << 16) |
+                                                       (static_cast<uint32_t>(pressureOut[0]) << 8)) >> 8;
+
+        return static_cast<float>(pressureData) / PressureSensitivity;
+    }
+
+    /**
+     * Converts the temperature output bytes to °C.
+     * @param temperatureOut the TEMP_OUT_L and TEMP_OUT_H bytes, in this order
+     * @return the temperature in °C
+     */
+    static float convertTemperature(const uint8_t *temperatureOut) {
+        const auto signedValue = static_cast<int16_t>((static_cast<uint16_t>(temperatureOut[1]) << 8) |
+                                                      temperatureOut[0]);
+
+        return static_cast<float>(signedValue) / TemperatureSensitivity;
+    }
+
+    /**
+     * Reads the pressure output registers.
+     * @return the pressure in hPa
+     */
+    float readPressureOutput();
+
+    /**
+     * Reads the temperature output registers.
+     * @return the temperature in °C
+     */
+    float readTemperatureOutput();
+
 };
@@ -1,4 +1,5 @@
 #include "LPS22HH.hpp"
+#include <etl/algorithm.h>
 
 template<typename F, typename... Arguments>
 bool LPS22HH::executeI2CTransaction(F i2cFunction, Arguments... arguments) {
@@ -34,32 +35,36 @@ uint8_t LPS22HH::readFromRegister(RegisterAddress registerAddress) {
     return registerData;
 }
 
+bool LPS22HH::readFromRegisters(RegisterAddress registerAddress, etl::span<uint8_t> registerData) {
+    uint8_t registerAddressArray[1] = {registerAddress};
+    return executeI2CTransaction(LPS22HH_TWIHS_WriteRead, registerAddressArray, NumberOfBytesInCommand,
+                                 registerData.data(), registerData.size());
+}
+
 float LPS22HH::readPressure() {
     triggerOneShotMode();
 
-    const uint8_t pressureOutH = readFromRegister(PRESSURE_OUT_H);
-    const uint8_t pressureOutL = readFromRegister(PRESSURE_OUT_L);
-    const uint8_t pressureOutXL = readFromRegister(PRESSURE_OUT_XL);
-
-    const int8_t sign = (pressureOutH & 0b1000'0000) ? 0b1111'1111 : 0;
+    return readPressureOutput();
+}
 
-    const int32_t pressureData = (sign << 24) |
-                           static_cast<int32_t>(pressureOutH << 16) |
-                           static_cast<int32_t>(pressureOutL << 8) |
-                           static_cast<int32_t>(pressureOutXL);
+float LPS22HH::readPressureOutput() {
+    etl::array<uint8_t, NumberOfBytesOfPressure> pressureOut{};
+    readFromRegisters(PRESSURE_OUT_XL, pressureOut);
 
-    return static_cast<float>(pressureData) / PressureSensitivity;
+    return convertPressure(pressureOut.data());
 }
 
 float LPS22HH::readTemperature() {
     triggerOneShotMode();
 
-    const uint8_t temperatureOutH = readFromRegister(TEMP_OUT_H);
-    const uint8_t temperatureOutL = readFromRegister(TEMP_OUT_L);
+    return readTemperatureOutput();
+}
 
-    auto signedValue = static_cast<int16_t>(((static_cast<uint16_t>(temperatureOutH) << 8) & 0xFF00) | temperatureOutL);
+float LPS22HH::readTemperatureOutput() {
+    etl::array<uint8_t, NumberOfBytesOfTemperature> temperatureOut{};
+    readFromRegisters(TEMP_OUT_L, temperatureOut);
 
-    return static_cast<float>(signedValue) / TemperatureSensitivity;
+    return convertTemperature(temperatureOut.data());
 }
 
 void LPS22HH::setODRBits(OutputDataRate rate) {
@@ -85,10 +90,53 @@ void LPS22HH::setFIFOMode(FIFOModes mode) {
 }
 
 void LPS22HH::triggerOneShotMode() {
-    /* todo: read CTRL_REG2 first and then write, to preserve any previous config done */
-    uint8_t oneShotBit = 0x01;
-    writeToRegister(CTRL_REG2, oneShotBit);
+    startOneShotMeasurement();
 
     vTaskDelay(pdMS_TO_TICKS(500));
 }
 
+void LPS22HH::startOneShotMeasurement() {
+    const uint8_t registerData = readFromRegister(CTRL_REG2);
+    writeToRegister(CTRL_REG2, registerData | AutoIncrementBit | OneShotBit);
+}
+
+bool LPS22HH::isMeasurementReady() {
+    const uint8_t status = readFromRegister(STATUS);
+    constexpr uint8_t DataAvailableBits = PressureDataAvailableBit | TemperatureDataAvailableBit;
+
+    return (status & DataAvailableBits) == DataAvailableBits;
+}
+
+etl::pair<float, float> LPS22HH::readLatestMeasurement() {
+    etl::array<uint8_t, NumberOfBytesOfSample> sampleData{};
+    readFromRegisters(PRESSURE_OUT_XL, sampleData);
+
+    return {convertPressure(sampleData.data()), convertTemperature(sampleData.data() + NumberOfBytesOfPressure)};
+}
+
+uint8_t LPS22HH::getFIFOLevel() {
+    return readFromRegister(FIFO_STATUS1);
+}
+
+size_t LPS22HH::readFIFO(etl::span<etl::pair<float, float>> samples) {
+    const size_t samplesNumber = etl::min(static_cast<size_t>(getFIFOLevel()),
+                                          etl::min(samples.size(), static_cast<size_t>(FIFODepth)));
+
+    if (samplesNumber == 0) {
+        return 0;
+    }
+
+    const etl::span<uint8_t> fifoData(fifoBuffer.data(), samplesNumber * NumberOfBytesOfSample);
+
+    if (not readFromRegisters(FIFO_DATA_OUT_PRESS_XL, fifoData)) {
+        return 0;
+    }
+
+    for (size_t index = 0; index < samplesNumber; index++) {
+        const uint8_t *sampleData = fifoData.data() + index * NumberOfBytesOfSample;
+        samples[index] = {convertPressure(sampleData), convertTemperature(sampleData + NumberOfBytesOfPressure)};
+    }
+
+    return samplesNumber;
+}
+
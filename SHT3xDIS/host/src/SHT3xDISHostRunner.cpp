@@ -0,0 +1,272 @@
+#include <array>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <random>
+#if defined(__x86_64__)
+#include <x86intrin.h>
+#endif
+#include "SHT3xDIS.hpp"
+
+/**
+ * The host build runner of the SHT3x-DIS checksum and conversion functions: exhaustive checks of the table driven
+ * CRC-8 against the bit by bit algorithm of the datasheet and of the integer conversions against the exact values,
+ * then, with --benchmark, the host cycles of the implementations.
+ *
+ * The cycles are those of the host, to compare the implementations, not an estimate of the Cortex-M7 time. The
+ * process exits with a non-zero status if a check fails.
+ */
+
+namespace {
+    uint32_t checksNumber = 0;
+
+    uint32_t failedChecksNumber = 0;
+
+    void check(bool condition, const char *description) {
+        checksNumber++;
+
+        if (not condition) {
+            failedChecksNumber++;
+        }
+
+        std::printf("[%s] %s\n", condition ? "PASS" : "FAIL", description);
+    }
+
+    /**
+     * The CRC-8 of a word, bit by bit as in the paragraph 4.12 of the datasheet: polynomial 0x31, initialization
+     * 0xFF, no reflection, no final XOR.
+     */
+    uint8_t calculateBitwiseCRC8(uint8_t msb, uint8_t lsb) {
+        constexpr uint8_t Polynomial = 0x31;
+        uint8_t crc = 0xFF;
+
+        for (const uint8_t Byte: {msb, lsb}) {
+            crc ^= Byte;
+
+            for (uint8_t bit = 0; bit < 8; bit++) {
+                crc = (crc & 0x80) ? static_cast<uint8_t>((crc << 1) ^ Polynomial) : static_cast<uint8_t>(crc << 1);
+            }
+        }
+
+        return crc;
+    }
+
+    /**
+     * Checks the CRC-8 of every word against the bit by bit algorithm, and the checksum checks of every word and
+     * checksum, 2^24 inputs.
+     */
+    void checkCRC8() {
+        uint32_t wordMismatches = 0;
+        uint32_t checkMismatches = 0;
+        uint32_t verifyMismatches = 0;
+        uint32_t measurementMismatches = 0;
+
+        for (uint32_t word = 0; word <= 0xFFFF; word++) {
+            const auto Msb = static_cast<uint8_t>(word >> 8);
+            const auto Lsb = static_cast<uint8_t>(word & 0xFF);
+            const uint8_t Expected = calculateBitwiseCRC8(Msb, Lsb);
+
+            if (SHT3xDIS::calculateCRC8(Msb, Lsb) != Expected) {
+                wordMismatches++;
+            }
+
+            for (uint32_t checksum = 0; checksum <= 0xFF; checksum++) {
+                const bool IsValid = (checksum == Expected);
+                const std::array<uint8_t, 3> WordWithCRC = {Msb, Lsb, static_cast<uint8_t>(checksum)};
+
+                if (SHT3xDIS::crc8(Msb, Lsb, static_cast<uint8_t>(checksum)) != IsValid) {
+                    checkMismatches++;
+                }
+                if (SHT3xDIS::verifyCRC8(WordWithCRC) != IsValid) {
+                    verifyMismatches++;
+                }
+            }
+
+            // A measurement is accepted only with both checksums correct, whichever word is corrupted
+            const std::array<uint8_t, 6> Measurement = {Msb, Lsb, Expected, Lsb, Msb, calculateBitwiseCRC8(Lsb, Msb)};
+            std::array<uint8_t, 6> corrupted = Measurement;
+            corrupted[word % 6] ^= static_cast<uint8_t>(1 << (word % 8));
+
+            if (not SHT3xDIS::verifyCRC8(Measurement) or SHT3xDIS::verifyCRC8(corrupted)) {
+                measurementMismatches++;
+            }
+        }
+
+        check(wordMismatches == 0, "calculateCRC8 equals the bitwise CRC-8 for all 2^16 words");
+        check(checkMismatches == 0, "crc8 accepts exactly the bitwise CRC-8 for all 2^24 words and checksums");
+        check(verifyMismatches == 0, "verifyCRC8 accepts exactly the bitwise CRC-8 for all 2^24 words and checksums");
+        check(measurementMismatches == 0, "verifyCRC8 rejects a measurement with a bit error in any of its 6 bytes");
+
+        constexpr std::array<uint8_t, 5> PartialWord = {0xBE, 0xEF, 0x92, 0xBE, 0xEF};
+        check(not SHT3xDIS::verifyCRC8(PartialWord), "verifyCRC8 rejects data that are not whole words");
+        check(SHT3xDIS::calculateCRC8(0xBE, 0xEF) == 0x92, "calculateCRC8 of the datasheet example");
+    }
+
+    /**
+     * Checks the conversions of every raw word: the integer conversions are the exact values rounded to the nearest
+     * hundredth, the float conversions are within a few units in the last place of the exact values.
+     */
+    void checkConversions() {
+        constexpr int64_t FullScale = 0xFFFF;
+        // The largest float conversion error allowed, about 8 ULP at 130 Celsius
+        constexpr double Tolerance = 1.0 / (1 << 14);
+
+        uint32_t centiDegreesMismatches = 0;
+        uint32_t centiPercentMismatches = 0;
+        double largestTemperatureError = 0;
+        double largestHumidityError = 0;
+
+        for (int64_t raw = 0; raw <= FullScale; raw++) {
+            const auto Raw = static_cast<uint16_t>(raw);
+
+            // The scaled values are never halfway between two integers, since 2 * FullScale does not divide an odd
+            // numerator, so the rounding direction of the ties does not matter
+            const int64_t CentiDegrees = -4500 + (2 * 17500 * raw + FullScale) / (2 * FullScale);
+            const int64_t CentiPercent = (2 * 10000 * raw + FullScale) / (2 * FullScale);
+
+            if (SHT3xDIS::convertRawTemperatureValueToCentiDegrees(Raw) != CentiDegrees) {
+                centiDegreesMismatches++;
+            }
+            if (SHT3xDIS::convertRawHumidityValueToCentiPercent(Raw) != CentiPercent) {
+                centiPercentMismatches++;
+            }
+
+            const double ExactTemperature = -45 + 175 * static_cast<double>(raw) / FullScale;
+            const double ExactHumidity = 100 * static_cast<double>(raw) / FullScale;
+            largestTemperatureError = std::fmax(largestTemperatureError, std::fabs(
+                    SHT3xDIS::convertRawTemperatureValueToPhysicalScale(Raw) - ExactTemperature));
+            largestHumidityError = std::fmax(largestHumidityError, std::fabs(
+                    SHT3xDIS::convertRawHumidityValueToPhysicalScale(Raw) - ExactHumidity));
+        }
+
+        check(centiDegreesMismatches == 0,
+              "convertRawTemperatureValueToCentiDegrees is the exact value rounded for all 2^16 words");
+        check(centiPercentMismatches == 0,
+              "convertRawHumidityValueToCentiPercent is the exact value rounded for all 2^16 words");
+        check(largestTemperatureError <= Tolerance,
+              "convertRawTemperatureValueToPhysicalScale is within 2^-14 Celsius for all 2^16 words");
+        check(largestHumidityError <= Tolerance,
+              "convertRawHumidityValueToPhysicalScale is within 2^-14 %RH for all 2^16 words");
+
+        std::printf("       largest float errors: %.3g Celsius, %.3g %%RH\n", largestTemperatureError,
+                    largestHumidityError);
+    }
+
+    /**
+     * Function that reads the host cycle counter: the time stamp counter on x86-64, the steady clock in nanoseconds
+     * elsewhere.
+     */
+    uint64_t readHostCycles() {
+#if defined(__x86_64__)
+        return __rdtsc();
+#else
+        return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                std::chrono::steady_clock::now().time_since_epoch()).count());
+#endif
+    }
+
+#if defined(__x86_64__)
+    constexpr const char *CyclesUnit = "TSC cycles";
+#else
+    constexpr const char *CyclesUnit = "nanoseconds";
+#endif
+
+    /**
+     * Measures the host cycles per call of an operation over a buffer of random values, the lowest mean of several
+     * batches, to leave out the interruptions of the host.
+     */
+    template<typename T, size_t SIZE, typename OPERATION>
+    double measureHostCycles(const std::array<T, SIZE> &values, size_t stride, OPERATION operation) {
+        using Result = decltype(operation(&values[0]));
+        constexpr uint32_t Batches = 25;
+        double lowest = 0;
+
+        // The results are summed into a volatile so that the operations are not optimized out
+        volatile Result sink = 0;
+
+        for (uint32_t batch = 0; batch < Batches; batch++) {
+            Result sum = 0;
+            const uint64_t Start = readHostCycles();
+
+            for (size_t index = 0; (index + stride) <= SIZE; index += stride) {
+                sum += operation(&values[index]);
+            }
+
+            const double Mean = static_cast<double>(readHostCycles() - Start) / static_cast<double>(SIZE / stride);
+            lowest = ((batch == 0) or (Mean < lowest)) ? Mean : lowest;
+            sink = sink + sum;
+        }
+
+        return lowest;
+    }
+
+    void benchmarkCRC8() {
+        static std::array<uint8_t, 6 * 4096> bytes{};
+        std::mt19937 generator(1);
+        for (auto &byte: bytes) {
+            byte = static_cast<uint8_t>(generator());
+        }
+
+        std::printf("\nCRC-8, host %s per call\n", CyclesUnit);
+
+        std::printf("  %-44s %8.2f\n", "bitwise CRC-8 of a word", measureHostCycles(bytes, 2, [](const uint8_t *data) {
+            return calculateBitwiseCRC8(data[0], data[1]);
+        }));
+        std::printf("  %-44s %8.2f\n", "calculateCRC8 of a word", measureHostCycles(bytes, 2, [](const uint8_t *data) {
+            return SHT3xDIS::calculateCRC8(data[0], data[1]);
+        }));
+        std::printf("  %-44s %8.2f\n", "bitwise check of a measurement (2 words)",
+                    measureHostCycles(bytes, 6, [](const uint8_t *data) {
+                        return static_cast<uint32_t>((calculateBitwiseCRC8(data[0], data[1]) == data[2]) and
+                                                     (calculateBitwiseCRC8(data[3], data[4]) == data[5]));
+                    }));
+        std::printf("  %-44s %8.2f\n", "verifyCRC8 of a measurement (2 words)",
+                    measureHostCycles(bytes, 6, [](const uint8_t *data) {
+                        return static_cast<uint32_t>(SHT3xDIS::verifyCRC8(etl::span<const uint8_t>(data, 6)));
+                    }));
+    }
+
+    void benchmarkConversions() {
+        static std::array<uint16_t, 4096> rawValues{};
+        std::mt19937 generator(1);
+        for (auto &raw: rawValues) {
+            raw = static_cast<uint16_t>(generator());
+        }
+
+        std::printf("\nConversions, host %s per call\n", CyclesUnit);
+
+        std::printf("  %-44s %8.2f\n", "convertRawTemperatureValueToPhysicalScale",
+                    measureHostCycles(rawValues, 1, [](const uint16_t *raw) {
+                        return SHT3xDIS::convertRawTemperatureValueToPhysicalScale(*raw);
+                    }));
+        std::printf("  %-44s %8.2f\n", "convertRawTemperatureValueToCentiDegrees",
+                    measureHostCycles(rawValues, 1, [](const uint16_t *raw) {
+                        return static_cast<int32_t>(SHT3xDIS::convertRawTemperatureValueToCentiDegrees(*raw));
+                    }));
+        std::printf("  %-44s %8.2f\n", "convertRawHumidityValueToPhysicalScale",
+                    measureHostCycles(rawValues, 1, [](const uint16_t *raw) {
+                        return SHT3xDIS::convertRawHumidityValueToPhysicalScale(*raw);
+                    }));
+        std::printf("  %-44s %8.2f\n", "convertRawHumidityValueToCentiPercent",
+                    measureHostCycles(rawValues, 1, [](const uint16_t *raw) {
+                        return static_cast<uint32_t>(SHT3xDIS::convertRawHumidityValueToCentiPercent(*raw));
+                    }));
+    }
+}
+
+int main(int argc, char **argv) {
+    const bool Benchmark = (argc > 1) and (std::strcmp(argv[1], "--benchmark") == 0);
+
+    checkCRC8();
+    checkConversions();
+
+    std::printf("\n%u checks, %u failed\n", checksNumber, failedChecksNumber);
+
+    if (Benchmark) {
+        benchmarkCRC8();
+        benchmarkConversions();
+    }
+
+    return (failedChecksNumber == 0) ? 0 : 1;
+}
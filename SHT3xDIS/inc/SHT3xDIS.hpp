@@ -2,6 +2,9 @@
 
 #include <etl/utility.h>
 #include <etl/array.h>
+#include <etl/optional.h>
+#include <etl/span.h>
+#include <etl/algorithm.h>
 #include <cstdint>
 #include "FreeRTOS.h"
 #include "Logger.hpp"
@@ -22,6 +25,7 @@
 #define SHT3xDIS_TWIHS_Read TWIHS0_Read
 #define SHT3xDIS_TWIHS_Initialize TWIHS0_Initialize
 #define SHT3xDIS_TWIHS_IsBusy TWIHS0_IsBusy
+#define SHT3xDIS_TWIHS_REGS TWIHS0_REGS
 
 #elif SHT3xDIS_TWI_PORT == 1
 
@@ -32,6 +36,7 @@
 #define SHT3xDIS_TWIHS_Read TWIHS1_Read
 #define SHT3xDIS_TWIHS_Initialize TWIHS1_Initialize
 #define SHT3xDIS_TWIHS_IsBusy TWIHS1_IsBusy
+#define SHT3xDIS_TWIHS_REGS TWIHS1_REGS
 
 #elif SHT3xDIS_TWI_PORT == 2
 
@@ -43,6 +48,7 @@
 #define SHT3xDIS_TWIHS_Read TWIHS2_Read
 #define SHT3xDIS_TWIHS_Initialize TWIHS2_Initialize
 #define SHT3xDIS_TWIHS_IsBusy TWIHS2_IsBusy
+#define SHT3xDIS_TWIHS_REGS TWIHS2_REGS
 #endif
 
 /**
@@ -79,6 +85,168 @@ public:
         DISABLED_LOW = 0x2416
     };
 
+    /**
+     * Callback called by pollResult() when a measurement started by startMeasurement() completes.
+     * The first parameter is the temperature, the second one the humidity.
+     */
+    using MeasurementCallback = void (*)(float temperature, float humidity, uintptr_t context);
+
+    /**
+     * Start commands for the periodic data acquisition mode. The commands are in the form
+     * MeasurementsPerSecond_RepeatabilityConfiguration
+     * i.e MPS_0_5_HIGH means 0.5 measurements per second, Repeatability High
+     * ART starts the Accelerated Response Time mode, with 4 measurements per second.
+     */
+    enum PeriodicModeCommands : uint16_t {
+        MPS_0_5_HIGH = 0x2032,
+        MPS_0_5_MEDIUM = 0x2024,
+        MPS_0_5_LOW = 0x202F,
+        MPS_1_HIGH = 0x2130,
+        MPS_1_MEDIUM = 0x2126,
+        MPS_1_LOW = 0x212D,
+        MPS_2_HIGH = 0x2236,
+        MPS_2_MEDIUM = 0x2220,
+        MPS_2_LOW = 0x222B,
+        MPS_4_HIGH = 0x2334,
+        MPS_4_MEDIUM = 0x2322,
+        MPS_4_LOW = 0x2329,
+        MPS_10_HIGH = 0x2737,
+        MPS_10_MEDIUM = 0x2721,
+        MPS_10_LOW = 0x272A,
+        ART = 0x2B32
+    };
+
+    /**
+     * The alert limits of the sensor. The Alert pin is set when a measurement exceeds the high set limit or falls
+     * below the low set limit, and it is cleared when the measurement returns inside the clear limits.
+     */
+    enum AlertLimit : uint8_t {
+        HIGH_SET = 0,
+        HIGH_CLEAR,
+        LOW_CLEAR,
+        LOW_SET
+    };
+
+    /**
+     * Callback called from the interrupt of the Alert pin, it shall be ISR safe.
+     */
+    using AlertCallback = void (*)(uintptr_t context);
+
+    /**
+     * The health of the communication with the sensor.
+     * ONLINE : the last transaction was successful
+     * DEGRADED : the last transactions failed, every transaction is still attempted with retries
+     * OFFLINE : too many consecutive transactions failed, the sensor is probed once every OfflineProbePeriod and
+     * the other transactions are skipped, so that they do not hold the bus and the calling task
+     */
+    enum HealthState : uint8_t {
+        ONLINE = 0,
+        DEGRADED,
+        OFFLINE
+    };
+
+    /**
+     * Counters of the communication errors since the construction of the driver. busBusy counts the transactions
+     * that could not be started because the shared bus was in use, which do not affect the health state.
+     */
+    struct HealthCounters {
+        uint32_t nacks = 0;
+        uint32_t timeouts = 0;
+        uint32_t retries = 0;
+        uint32_t busRecoveries = 0;
+        uint32_t skippedTransactions = 0;
+        uint32_t busBusy = 0;
+    };
+
+    /**
+     * Implementation of CRC8 algorithm, parameters are set according to the manual (paragraph 4.12).
+     * Polynomial: 0x31 (x^8 + x^5 + x^4 + 1)
+     * Initialization: 0xFF
+     * Reflect input: False
+     * Reflect output: False
+     * Final XOR: 0x00
+     * @param msb the first byte of the word
+     * @param lsb the second byte of the word
+     * @return the checksum of the word
+     */
+    [[nodiscard]] static constexpr uint8_t calculateCRC8(uint8_t msb, uint8_t lsb) {
+        return CRC8Table[CRC8Table[0xFF ^ msb] ^ lsb];
+    }
+
+    /**
+     * Checks the checksum of a 2-byte word.
+     */
+    [[nodiscard]] static constexpr bool crc8(uint8_t msb, uint8_t lsb, uint8_t checksum) {
+        return calculateCRC8(msb, lsb) == checksum;
+    }
+
+    /**
+     * Checks the checksums of all the words of a read, in one pass.
+     * @param data the read bytes, a sequence of words of 2 data bytes followed by their checksum
+     * @return true if the data consist of whole words and all checksums are correct
+     */
+    [[nodiscard]] static constexpr bool verifyCRC8(etl::span<const uint8_t> data) {
+        if ((data.size() % NumberOfBytesOfWordWithCRC) != 0) {
+            return false;
+        }
+
+        uint8_t mismatch = 0;
+
+        for (size_t index = 0; index < data.size(); index += NumberOfBytesOfWordWithCRC) {
+            mismatch |= calculateCRC8(data[index], data[index + 1]) ^ data[index + 2];
+        }
+
+        return mismatch == 0;
+    }
+
+    /**
+     * Converts the raw temperature data to the physical scale according to the section 4.13 of the datasheet.
+     * @Note Negative values are converted properly
+     * @param rawTemperature raw temperature data as received from the sensor
+     * @return temperature in Celsius
+     */
+    [[nodiscard]] static inline float convertRawTemperatureValueToPhysicalScale(uint16_t rawTemperature) {
+        return -45 + 175 * (static_cast<float>(rawTemperature) / 0xFFFF);
+    }
+
+    /**
+     * Converts the raw humidity data to the physical scale according to the section 4.13 of the datasheet.
+     * @param rawHumidity raw humidity data as received from the sensor
+     * @return humidity in Relative humidity %
+     */
+    [[nodiscard]] static inline float convertRawHumidityValueToPhysicalScale(uint16_t rawHumidity) {
+        return 100 * (static_cast<float>(rawHumidity) / 0xFFFF);
+    }
+
+    /**
+     * Converts the raw temperature data to hundredths of a degree Celsius with integer arithmetic only.
+     * -4500 + 17500 * raw / 65535 is rounded to the nearest integer by a multiplication with 286724375 / 2^30,
+     * which is exact for all 65536 raw values.
+     * @param rawTemperature raw temperature data as received from the sensor
+     * @return temperature in centi-degrees Celsius
+     */
+    [[nodiscard]] static constexpr int16_t convertRawTemperatureValueToCentiDegrees(uint16_t rawTemperature) {
+        constexpr uint64_t Multiplier = 286724375;
+        constexpr uint8_t Shift = 30;
+
+        return static_cast<int16_t>(-4500 + static_cast<int32_t>(
+                (rawTemperature * Multiplier + (uint64_t{1} << (Shift - 1))) >> Shift));
+    }
+
+    /**
+     * Converts the raw humidity data to hundredths of a percent of relative humidity with integer arithmetic only.
+     * 10000 * raw / 65535 is rounded to the nearest integer by a multiplication with 40960625 / 2^28,
+     * which is exact for all 65536 raw values.
+     * @param rawHumidity raw humidity data as received from the sensor
+     * @return humidity in centi-%RH
+     */
+    [[nodiscard]] static constexpr uint16_t convertRawHumidityValueToCentiPercent(uint16_t rawHumidity) {
+        constexpr uint64_t Multiplier = 40960625;
+        constexpr uint8_t Shift = 28;
+
+        return static_cast<uint16_t>((rawHumidity * Multiplier + (uint64_t{1} << (Shift - 1))) >> Shift);
+    }
+
 private:
     /**
      * I2C device address.
@@ -120,6 +288,105 @@ private:
      */
     static inline constexpr uint8_t NumberOfBytesOfMeasurementsWithCRC = 6;
 
+    /**
+     * The number of bytes of a write of an alert limit, the command, the limit and its checksum.
+     */
+    static inline constexpr uint8_t NumberOfBytesOfAlertLimitWrite = 5;
+
+    /**
+     * Callback called when the Alert pin is raised.
+     */
+    AlertCallback alertCallback = nullptr;
+
+    /**
+     * Context of the alert callback.
+     */
+    uintptr_t alertCallbackContext = 0;
+
+    /**
+     * Maximum measurement durations of the single shot mode for high, medium and low repeatability in
+     * microseconds (Table 4 of the datasheet).
+     */
+    static inline constexpr uint16_t MaximumMeasurementDurationHighUs = 15500;
+    static inline constexpr uint16_t MaximumMeasurementDurationMediumUs = 6500;
+    static inline constexpr uint16_t MaximumMeasurementDurationLowUs = 4500;
+
+    /**
+     * True while a measurement started by startMeasurement() has not been read.
+     */
+    bool isMeasurementPending = false;
+
+    /**
+     * Tick count after which the pending measurement is completed.
+     */
+    TickType_t measurementReadyTick = 0;
+
+    /**
+     * Completion callback of the pending measurement.
+     */
+    MeasurementCallback measurementCallback = nullptr;
+
+    /**
+     * Context of the completion callback.
+     */
+    uintptr_t measurementCallbackContext = 0;
+
+    /**
+     * Milliseconds the sensor needs after a Break command, before accepting a new command.
+     */
+    static inline constexpr uint8_t msToWaitAfterBreak = 1;
+
+    /**
+     * True while the sensor is in the periodic data acquisition mode.
+     */
+    bool isPeriodicModeActive = false;
+
+    /**
+     * Period of the measurements of the periodic data acquisition mode.
+     */
+    TickType_t periodicMeasurementPeriod = 0;
+
+    /**
+     * Tick count of the last measurement fetched in the periodic data acquisition mode, or of the start of the mode.
+     */
+    TickType_t lastPeriodicFetchTick = 0;
+
+    /**
+     * Time after the expected completion of a measurement during which a NACK of the read header is not an error.
+     */
+    static inline constexpr TickType_t MeasurementGracePeriod = pdMS_TO_TICKS(20);
+
+    /**
+     * Checks whether the pending single shot measurement should have been completed, including the grace period.
+     * @return true if the measurement is overdue
+     */
+    [[nodiscard]] bool isMeasurementOverdue() const {
+        return static_cast<int32_t>(xTaskGetTickCount() - (measurementReadyTick + MeasurementGracePeriod)) >= 0;
+    }
+
+    /**
+     * Returns the period of the measurements of a periodic data acquisition mode command. The most significant byte
+     * of the command selects the measurement rate.
+     * @param command the measurement rate and repeatability configuration
+     * @return the period in milliseconds
+     */
+    static constexpr uint16_t getPeriodicMeasurementPeriodMs(PeriodicModeCommands command) {
+        switch (static_cast<uint16_t>(command) >> 8) {
+            case 0x20:
+                return 2000;
+            case 0x21:
+                return 1000;
+            case 0x22:
+                return 500;
+            case 0x23:
+            case 0x2B:
+                return 250;
+            case 0x27:
+            default:
+                return 100;
+        }
+    }
+
     /**
      * Variable to select the between using or not the checksum for the sensor data.
      */
@@ -130,6 +397,51 @@ private:
      */
     static inline constexpr uint16_t TimeoutTicks = 1000;
 
+    /**
+     * The number of times a failed transaction is repeated, the n-th retry waits RetryBackoffMs * 2^(n-1) before.
+     */
+    static inline constexpr uint8_t MaximumRetries = 2;
+
+    /**
+     * Wait before the first retry of a failed transaction.
+     */
+    static inline constexpr uint8_t RetryBackoffMs = 1;
+
+    /**
+     * The number of consecutive failed transactions after which the sensor is considered offline.
+     */
+    static inline constexpr uint8_t OfflineThreshold = 3;
+
+    /**
+     * Period of the probing transactions while the sensor is offline.
+     */
+    static inline constexpr TickType_t OfflineProbePeriod = pdMS_TO_TICKS(5000);
+
+    /**
+     * Wait period for the SDA line to be released after a bus clear command.
+     */
+    static inline constexpr TickType_t BusClearTimeoutTicks = pdMS_TO_TICKS(2);
+
+    /**
+     * The health of the communication with the sensor.
+     */
+    HealthState healthState = ONLINE;
+
+    /**
+     * Counters of the communication errors.
+     */
+    HealthCounters healthCounters{};
+
+    /**
+     * The number of consecutive failed transactions.
+     */
+    uint8_t consecutiveFailures = 0;
+
+    /**
+     * Tick count of the last failed transaction.
+     */
+    TickType_t lastFailureTick = 0;
+
     /**
      * Control commands for the Heater.
      */
@@ -146,6 +458,24 @@ private:
         CLEAR = 0x3041
     };
 
+    /**
+     * Control commands for the periodic data acquisition mode.
+     */
+    enum PeriodicModeControlCommands : uint16_t {
+        FETCH_DATA = 0xE000,
+        BREAK = 0x3093
+    };
+
+    /**
+     * Commands to read the alert limits, in the order of AlertLimit.
+     */
+    static inline constexpr etl::array<uint16_t, 4> ReadAlertLimitCommands = {0xE11F, 0xE114, 0xE109, 0xE102};
+
+    /**
+     * Commands to write the alert limits, in the order of AlertLimit.
+     */
+    static inline constexpr etl::array<uint16_t, 4> WriteAlertLimitCommands = {0x611D, 0x6116, 0x610B, 0x6100};
+
     enum ResetSensorCommands : uint16_t {
         INTERFACE_RESET = 0x00,
         SOFT_RESET = 0x30A2,
@@ -153,32 +483,82 @@ private:
     };
 
     /**
-     * Function that prevents hanging when a I2C device is not responding.
+     * Function that prevents hanging when a I2C device is not responding. On a timeout the bus is recovered.
+     * @return true if the transaction completed, false if it timed out
      */
-    inline void waitForI2CBuffer() const {
+    inline bool waitForI2CBuffer() {
         auto start = xTaskGetTickCount();
         while (SHT3xDIS_TWIHS_IsBusy()) {
             if (xTaskGetTickCount() - start > TimeoutTicks) {
                 LOG_ERROR << "Humidity sensor with address " << I2CAddress << " , communication has timed out";
-                SHT3xDIS_TWIHS_Initialize();
-                break;
+                healthCounters.timeouts++;
+                recoverBus();
+                return false;
             }
         }
+
+        return true;
     };
 
     /**
-     * Implementation of CRC8 algorithm, parameters are set according to the manual (paragraph 4.12).
+     * Recovers a bus held by a slave, with the bus clear command of the TWIHS peripheral which clocks out SCL until
+     * the slave releases SDA, followed by a re-initialization of the peripheral.
+     */
+    void recoverBus();
+
+    /**
+     * Checks whether a transaction shall be attempted. While the sensor is offline, only one probing transaction
+     * is allowed every OfflineProbePeriod.
+     * @return true if the transaction shall be attempted
+     */
+    bool isTransactionAllowed();
+
+    /**
+     * Updates the health state after a successful transaction.
+     */
+    void recordSuccess();
+
+    /**
+     * Updates the health state after a transaction that failed all its attempts.
+     */
+    void recordFailure();
+
+    /**
+     * Waits before a retry, the wait doubles with every attempt. There is no wait before the scheduler is started.
+     * @param attempt the number of the retry, starting from 1
+     */
+    static void waitBeforeRetry(uint8_t attempt);
+
+    /**
+     * The number of bytes of a CRC protected word, 2 data bytes followed by 1 checksum byte.
+     */
+    static inline constexpr uint8_t NumberOfBytesOfWordWithCRC = 3;
+
+    /**
+     * Lookup table of the CRC8 algorithm, the CRC of every byte value with a zero initialization.
      * Polynomial: 0x31 (x^8 + x^5 + x^4 + 1)
-     * Initialization: 0xFF
-     * Reflect input: False
-     * Reflect output: False
-     * Final XOR: 0x00
      */
-    static bool crc8(uint8_t msb, uint8_t lsb, uint8_t checksum);
+    static inline constexpr etl::array<uint8_t, 256> CRC8Table = [] {
+        etl::array<uint8_t, 256> table{};
+        constexpr uint8_t Polynomial = 0x31;
+
+        for (uint16_t value = 0; value < 256; ++value) {
+            auto crc = static_cast<uint8_t>(value);
+
+            for (uint8_t index = 0; index < 8; ++index) {
+                crc = (crc & 0x80) ? static_cast<uint8_t>((crc << 1) ^ Polynomial) : static_cast<uint8_t>(crc << 1);
+            }
+
+            table[value] = crc;
+        }
+
+        return table;
+    }();
 
     /**
      * An abstraction layer function that is the only one that interacts with the HAL. Executes one of the Read, Write or ReadWrite functions of
-     * the HAL with the correct number of parameters.
+     * the HAL with the correct number of parameters. A NACK or a timeout is retried up to MaximumRetries times,
+     * a busy bus is not retried and does not affect the health state.
      * @tparam F function template
      * @tparam Arguments template for arbitrary number of arguments
      * @param i2cFunction the HAL I2C function to execute
@@ -189,15 +569,17 @@ private:
     bool executeI2CTransaction(F i2cFunction, Arguments... arguments);
 
     /**
-     * Function that prevents hanging when a I2C device is not responding.
+     * Checks whether the last transaction was not acknowledged by the sensor.
+     * @return true if a NACK was received
      */
-    void checkForNACK();
+    bool checkForNACK();
 
     /**
      * Sends a command to the sensor.
      * @param command can be one of the command enum types
+     * @return true if the command was sent
      */
-    void sendCommandToSensor(uint16_t command);
+    bool sendCommandToSensor(uint16_t command);
 
     /**
      * Executes a continues Write-Read Transaction with a Repeated start condition as it is required for the Status
@@ -214,24 +596,55 @@ private:
     void readSensorDataSingleShotMode(etl::array<uint8_t, NumberOfBytesOfMeasurementsWithCRC> &sensorData);
 
     /**
-     * Converts the raw temperature data to the physical scale according to the section 4.13 of the datasheet.
-     * @Note Negative values are converted properly
-     * @param rawTemperature raw temperature data as received from the sensor
-     * @return temperature in Celsius
+     * Sends the Fetch Data command and reads the measurement of the periodic mode with a repeated start.
+     * The sensor does not acknowledge the read header when no new measurement is available, which is not an error.
+     * @param sensorData the temperature and humidity data with their checksums
+     * @return true if a new measurement was read, false otherwise
      */
-    [[nodiscard]] static inline float convertRawTemperatureValueToPhysicalScale(uint16_t rawTemperature) {
-        return -45 + 175 * (static_cast<float>(rawTemperature) / 0xFFFF);
-    }
+    bool fetchSensorDataPeriodicMode(etl::array<uint8_t, NumberOfBytesOfMeasurementsWithCRC> &sensorData);
 
     /**
-     * Converts the raw humidity data to the physical scale according to the section 4.13 of the datasheet.
-     * @param rawHumidity raw humidity data as received from the sensor
-     * @return humidity in Relative humidity %
+     * Reads the measurement of the single shot mode, if it is completed. The sensor does not acknowledge the read
+     * header while the measurement is in progress, which is not an error.
+     * @param sensorData the temperature and humidity data with their checksums
+     * @return true if the measurement was read, false otherwise
      */
-    [[nodiscard]] static inline float convertRawHumidityValueToPhysicalScale(uint16_t rawHumidity) {
-        return 100 * (static_cast<float>(rawHumidity) / 0xFFFF);
+    bool readSensorDataIfReady(etl::array<uint8_t, NumberOfBytesOfMeasurementsWithCRC> &sensorData);
+
+    /**
+     * Checks the checksums of the temperature and humidity data.
+     * @param sensorData the temperature and humidity data with their checksums
+     * @return true if both checksums are correct
+     */
+    static bool checkSensorDataCRC(const etl::array<uint8_t, NumberOfBytesOfMeasurementsWithCRC> &sensorData);
+
+    /**
+     * Extracts the raw temperature and humidity words of a measurement.
+     * @param sensorData the temperature and humidity data with their checksums
+     * @return a pair, the raw temperature and the raw humidity
+     */
+    [[nodiscard]] static inline etl::pair<uint16_t, uint16_t>
+    decodeRawMeasurement(const etl::array<uint8_t, NumberOfBytesOfMeasurementsWithCRC> &sensorData) {
+        return {concatenateTwoBytesToHalfWord(sensorData[0], sensorData[1]),
+                concatenateTwoBytesToHalfWord(sensorData[3], sensorData[4])};
     }
 
+    /**
+     * Reads a measurement with the Single Shot Data Acquisition Mode, the common path of getOneShotMeasurement()
+     * and getOneShotMeasurementCentiUnits().
+     * @param command the Single Shot sensor measurement configuration, @see SingleShotModeCommands
+     * @return a pair, the raw temperature and the raw humidity
+     */
+    etl::pair<uint16_t, uint16_t> readOneShotRawMeasurement(SingleShotModeCommands command);
+
+    /**
+     * Reads the latest measurement of the Periodic Data Acquisition Mode, the common path of
+     * fetchPeriodicMeasurement() and fetchPeriodicMeasurementCentiUnits().
+     * @return a pair, the raw temperature and the raw humidity, or nothing if no new measurement is available or
+     * its checksum is wrong
+     */
+    etl::optional<etl::pair<uint16_t, uint16_t>> fetchPeriodicRawMeasurement();
+
     /**
      * Create 16-bit data by concatenating 2 bytes
      * @param msb the first 8 bits of the half word
@@ -252,6 +665,44 @@ private:
         dataArray = {static_cast<uint8_t>((halfWord >> 8) & 0xFF), static_cast<uint8_t>(halfWord & 0xFF)};
     }
 
+    /**
+     * Converts a temperature to the raw scale of the sensor, the inverse of convertRawTemperatureValueToPhysicalScale().
+     * @param temperature temperature in Celsius, limited to the range of the sensor
+     * @return the raw temperature data
+     */
+    [[nodiscard]] static inline uint16_t convertTemperatureToRawValue(float temperature) {
+        const float Limited = etl::clamp(temperature, -45.0f, 130.0f);
+        return static_cast<uint16_t>((Limited + 45) / 175 * 0xFFFF + 0.5f);
+    }
+
+    /**
+     * Converts a humidity to the raw scale of the sensor, the inverse of convertRawHumidityValueToPhysicalScale().
+     * @param humidity humidity in Relative humidity %, limited to 0 - 100
+     * @return the raw humidity data
+     */
+    [[nodiscard]] static inline uint16_t convertHumidityToRawValue(float humidity) {
+        const float Limited = etl::clamp(humidity, 0.0f, 100.0f);
+        return static_cast<uint16_t>(Limited / 100 * 0xFFFF + 0.5f);
+    }
+
+    /**
+     * Packs an alert limit into the format of the limit registers. The 7 most significant bits of the raw humidity
+     * are bits 15 - 9 and the 9 most significant bits of the raw temperature are bits 8 - 0.
+     * @param rawTemperature the raw temperature data
+     * @param rawHumidity the raw humidity data
+     * @return the limit word
+     */
+    [[nodiscard]] static constexpr uint16_t packAlertLimit(uint16_t rawTemperature, uint16_t rawHumidity) {
+        return static_cast<uint16_t>((rawHumidity & 0xFE00) | (rawTemperature >> 7));
+    }
+
+    /**
+     * Interrupt callback of the Alert pin.
+     * @param pin the pin that caused the interrupt
+     * @param context the SHT3xDIS instance
+     */
+    static void alertPinCallback(PIO_PIN pin, uintptr_t context);
+
     /**
      * Initialize the sensor by clearing the Status Register and pulling the nRESET pin High.
      */
@@ -280,6 +731,122 @@ public:
      */
     etl::pair<float, float> getOneShotMeasurement(SingleShotModeCommands command);
 
+    /**
+     * Starts a measurement with the Single Shot Data Acquisition Mode, without waiting for it to complete.
+     * The result is read by pollResult() once the maximum measurement duration has passed, so that a task can
+     * interleave the conversions of several sensors.
+     * @param command the Single Shot sensor measurement configuration, clock stretching shall be disabled
+     * @param callback called by pollResult() with the measurement, may be nullptr
+     * @param context passed to the callback
+     * @return true if the measurement was started
+     */
+    bool startMeasurement(SingleShotModeCommands command, MeasurementCallback callback = nullptr,
+                          uintptr_t context = 0);
+
+    /**
+     * Returns the maximum measurement duration of a single shot command without clock stretching.
+     * @param command the Single Shot sensor measurement configuration
+     * @return the duration in microseconds, 0 for the commands with clock stretching
+     */
+    static constexpr uint16_t getMaximumMeasurementDurationUs(SingleShotModeCommands command) {
+        switch (command) {
+            case DISABLED_HIGH:
+                return MaximumMeasurementDurationHighUs;
+            case DISABLED_MEDIUM:
+                return MaximumMeasurementDurationMediumUs;
+            case DISABLED_LOW:
+                return MaximumMeasurementDurationLowUs;
+            default:
+                return 0;
+        }
+    }
+
+    /**
+     * Reads the measurement started by startMeasurement(), if it is completed. There is no I2C transaction before
+     * the maximum measurement duration has passed.
+     * A measurement that is still not acknowledged MeasurementGracePeriod after its maximum duration is abandoned
+     * and counted as a failure of the sensor.
+     * @return a pair of float types, the temperature and the humidity, or nothing if the measurement is not completed,
+     * not started or its checksum is wrong
+     */
+    etl::optional<etl::pair<float, float>> pollResult();
+
+    /**
+     * Checks whether a measurement started by startMeasurement() has not been read yet.
+     * @return true if a measurement is pending
+     */
+    [[nodiscard]] bool isMeasurementInProgress() const {
+        return isMeasurementPending;
+    }
+
+    /**
+     * Starts the Periodic Data Acquisition Mode, in which the sensor measures on its own at the selected rate.
+     * The measurements are then read with fetchPeriodicMeasurement(), without waiting for the conversion.
+     * @param command the measurement rate and repeatability configuration, @see PeriodicModeCommands
+     */
+    void startPeriodicMeasurement(PeriodicModeCommands command);
+
+    /**
+     * Get temperature and humidity data from the sensor with the Single Shot Data Acquisition Mode, converted with
+     * integer arithmetic only.
+     * @param command the Single Shot sensor measurement configuration, @see SingleShotModeCommands
+     * @return a pair, the temperature in centi-degrees Celsius and the humidity in centi-%RH
+     */
+    etl::pair<int16_t, uint16_t> getOneShotMeasurementCentiUnits(SingleShotModeCommands command);
+
+    /**
+     * Reads the latest measurement of the Periodic Data Acquisition Mode, converted with integer arithmetic only.
+     * @return a pair, the temperature in centi-degrees Celsius and the humidity in centi-%RH, or nothing if no new
+     * measurement is available or its checksum is wrong
+     */
+    etl::optional<etl::pair<int16_t, uint16_t>> fetchPeriodicMeasurementCentiUnits();
+
+    /**
+     * Reads the latest measurement of the Periodic Data Acquisition Mode. The sensor keeps only the latest
+     * measurement and clears it when read, so a fetch before the next measurement is completed returns nothing.
+     * @return a pair of float types, the temperature and the humidity, or nothing if no new measurement is available
+     * or its checksum is wrong
+     */
+    etl::optional<etl::pair<float, float>> fetchPeriodicMeasurement();
+
+    /**
+     * Writes an alert limit. The limits are kept with 9 bits of resolution for the temperature and 7 bits for the
+     * humidity, and they are lost on a reset of the sensor.
+     * @param limit the alert limit to write
+     * @param temperature the temperature limit in Celsius
+     * @param humidity the humidity limit in Relative humidity %
+     * @return true if the limit was written
+     */
+    bool writeAlertLimit(AlertLimit limit, float temperature, float humidity);
+
+    /**
+     * Reads an alert limit.
+     * @param limit the alert limit to read
+     * @return a pair of float types, the temperature and the humidity limit, or nothing if the checksum is wrong
+     * or the bus is busy
+     */
+    etl::optional<etl::pair<float, float>> readAlertLimit(AlertLimit limit);
+
+    /**
+     * Enables the interrupt of the Alert pin, so that threshold crossings of the periodic mode are signalled without
+     * any I2C transaction. The interrupt edge is selected by the PIO configuration. The cause of the alert can then be
+     * read from the bits 11 (humidity) and 10 (temperature) of the Status Register.
+     * @param callback called from the interrupt when the Alert pin is raised
+     * @param context passed to the callback
+     * @return true if the interrupt was enabled, false if no Alert pin is connected
+     */
+    bool enableAlert(AlertCallback callback, uintptr_t context = 0);
+
+    /**
+     * Disables the interrupt of the Alert pin.
+     */
+    void disableAlert();
+
+    /**
+     * Stops the Periodic Data Acquisition Mode with the Break command, returning the sensor to the single shot mode.
+     */
+    void stopPeriodicMeasurement();
+
     /**
      * Sets the heater (On/Off).
      * @param command the command to either turn the heater off or on
@@ -301,4 +868,18 @@ public:
      * Soft resets the sensor.
      */
     void performSoftReset();
+
+    /**
+     * Returns the health of the communication with the sensor.
+     */
+    [[nodiscard]] HealthState getHealthState() const {
+        return healthState;
+    }
+
+    /**
+     * Returns the counters of the communication errors.
+     */
+    [[nodiscard]] const HealthCounters &getHealthCounters() const {
+        return healthCounters;
+    }
 };
@@ -0,0 +1,64 @@
+#pragma once
+
+#include <etl/array.h>
+#include <etl/optional.h>
+#include <etl/utility.h>
+#include <cstdint>
+#include "SHT3xDIS.hpp"
+
+/**
+ * Manager of the SHT3x-DIS sensors of the I2C bus selected by SHT3xDIS_TWI_PORT.
+ * The measurements of all sensors are started back-to-back and read after a single wait for the maximum
+ * measurement duration, so the conversions overlap and a sample of all sensors takes about one conversion time.
+ */
+class SHT3xDISManager {
+public:
+    /**
+     * The maximum number of sensors, one for each I2C address of the SHT3x-DIS on the bus.
+     */
+    static inline constexpr uint8_t MaximumSensors = 2;
+
+    /**
+     * The temperature and humidity of each registered sensor, in the order of registration, or nothing if the
+     * sensor did not return a valid measurement.
+     */
+    using Measurements = etl::array<etl::optional<etl::pair<float, float>>, MaximumSensors>;
+
+    /**
+     * Registers a sensor to be measured.
+     * @param sensor the sensor, which shall not be measured outside the manager afterwards
+     * @return true if the sensor was registered, false if all the sensors are already registered
+     */
+    bool registerSensor(SHT3xDIS &sensor);
+
+    /**
+     * Measures all the registered sensors with the Single Shot Data Acquisition Mode, overlapping their
+     * conversions.
+     * @param command the Single Shot sensor measurement configuration, clock stretching shall be disabled
+     * @return the measurements of the sensors
+     */
+    Measurements measureAll(SHT3xDIS::SingleShotModeCommands command);
+
+    /**
+     * @return the number of registered sensors
+     */
+    [[nodiscard]] uint8_t getSensorsNumber() const {
+        return sensorsNumber;
+    }
+
+private:
+    /**
+     * Milliseconds to keep polling the sensors after the maximum measurement duration, before giving up.
+     */
+    static inline constexpr uint8_t msToWaitForLateSensors = 5;
+
+    /**
+     * The registered sensors.
+     */
+    etl::array<SHT3xDIS *, MaximumSensors> sensors{};
+
+    /**
+     * The number of registered sensors.
+     */
+    uint8_t sensorsNumber = 0;
+};
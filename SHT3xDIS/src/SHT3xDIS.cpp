@@ -1,46 +1,121 @@
 #include "SHT3xDIS.hpp"
 
-bool SHT3xDIS::crc8(uint8_t msb, uint8_t lsb, uint8_t checksum) {
-    uint8_t CRC = 0xFF;
-    uint8_t polynomial = 0x31;
+static_assert(SHT3xDIS::calculateCRC8(0xBE, 0xEF) == 0x92, "CRC8 example of the datasheet (paragraph 4.12)");
+static_assert(SHT3xDIS::convertRawTemperatureValueToCentiDegrees(0) == -4500);
+static_assert(SHT3xDIS::convertRawTemperatureValueToCentiDegrees(0x8000) == 4250);
+static_assert(SHT3xDIS::convertRawTemperatureValueToCentiDegrees(0xFFFF) == 13000);
+static_assert(SHT3xDIS::convertRawHumidityValueToCentiPercent(0) == 0);
+static_assert(SHT3xDIS::convertRawHumidityValueToCentiPercent(0x8000) == 5000);
+static_assert(SHT3xDIS::convertRawHumidityValueToCentiPercent(0xFFFF) == 10000);
 
-    CRC ^= msb;
-    for (uint8_t index = 0; index < 8; ++index) {
-        CRC = (CRC & 0x80) ? ((CRC & 0x7F) << 1) ^ polynomial : (CRC & 0x7F) << 1;
+template<typename F, typename... Arguments>
+bool SHT3xDIS::executeI2CTransaction(F i2cFunction, Arguments... arguments) {
+    if (not isTransactionAllowed()) {
+        return false;
     }
 
-    CRC ^= lsb;
-    for (uint8_t index = 0; index < 8; ++index) {
-        CRC = (CRC & 0x80) ? ((CRC & 0x7F) << 1) ^ polynomial : (CRC & 0x7F) << 1;
+    // A probe of an offline sensor is not retried, to keep its cost to a single transaction
+    const uint8_t attempts = (healthState == OFFLINE) ? 1 : MaximumRetries + 1;
+
+    for (uint8_t attempt = 0; attempt < attempts; attempt++) {
+        if (attempt > 0) {
+            healthCounters.retries++;
+            waitBeforeRetry(attempt);
+        }
+
+        // A transfer of another device on the shared bus is not a fault of the sensor
+        if (not i2cFunction(I2CAddress, arguments...)) {
+            LOG_INFO << "Humidity sensor with address " << I2CAddress << ": I2C bus is busy";
+            healthCounters.busBusy++;
+            return false;
+        }
+
+        if (waitForI2CBuffer() and not checkForNACK()) {
+            recordSuccess();
+            return true;
+        }
     }
 
-    return CRC == checksum;
+    recordFailure();
+    return false;
 }
 
-template<typename F, typename... Arguments>
-bool SHT3xDIS::executeI2CTransaction(F i2cFunction, Arguments... arguments) {
-    if (i2cFunction(I2CAddress, arguments...)) {
-        waitForI2CBuffer();
-        checkForNACK();
+bool SHT3xDIS::checkForNACK() {
+    auto error = SHT3xDIS_TWIHS_ErrorGet();
+    if (error == TWIHS_ERROR_NACK) {
+        LOG_ERROR << "Humidity-Temperature sensor with address " << I2CAddress << " , did not acknowledge";
+        healthCounters.nacks++;
         return true;
-    } else {
-        LOG_INFO << "Humidity sensor with address " << I2CAddress << ": I2C bus is busy";
+    }
+
+    return false;
+}
+
+void SHT3xDIS::recoverBus() {
+    SHT3xDIS_TWIHS_REGS->TWIHS_CR = TWIHS_CR_CLEAR_Msk;
+
+    auto start = xTaskGetTickCount();
+    while ((SHT3xDIS_TWIHS_REGS->TWIHS_SR & TWIHS_SR_SDA_Msk) == 0) {
+        if (xTaskGetTickCount() - start > BusClearTimeoutTicks) {
+            LOG_ERROR << "Humidity sensor with address " << I2CAddress << ": SDA is still held low after a bus clear";
+            break;
+        }
+    }
+
+    SHT3xDIS_TWIHS_Initialize();
+    healthCounters.busRecoveries++;
+}
+
+bool SHT3xDIS::isTransactionAllowed() {
+    if ((healthState == OFFLINE) and (xTaskGetTickCount() - lastFailureTick < OfflineProbePeriod)) {
+        healthCounters.skippedTransactions++;
         return false;
     }
+
+    return true;
 }
 
-void SHT3xDIS::checkForNACK() {
-    auto error = SHT3xDIS_TWIHS_ErrorGet();
-    if (error == TWIHS_ERROR_NACK) {
-        LOG_ERROR << "Humidity-Temperature sensor with address " << I2CAddress << " , is disconnected, suspending task";
-        vTaskSuspend(nullptr);
+void SHT3xDIS::recordSuccess() {
+    if (healthState != ONLINE) {
+        LOG_INFO << "Humidity sensor with address " << I2CAddress << " is back online";
     }
+
+    healthState = ONLINE;
+    consecutiveFailures = 0;
 }
 
-void SHT3xDIS::sendCommandToSensor(uint16_t command) {
+void SHT3xDIS::recordFailure() {
+    lastFailureTick = xTaskGetTickCount();
+
+    if (consecutiveFailures < OfflineThreshold) {
+        consecutiveFailures++;
+    }
+
+    if (consecutiveFailures < OfflineThreshold) {
+        healthState = DEGRADED;
+        return;
+    }
+
+    if (healthState != OFFLINE) {
+        LOG_ERROR << "Humidity sensor with address " << I2CAddress << " is offline, probing every "
+                  << OfflineProbePeriod << " ticks";
+    }
+
+    healthState = OFFLINE;
+}
+
+void SHT3xDIS::waitBeforeRetry(uint8_t attempt) {
+    if (xTaskGetSchedulerState() == taskSCHEDULER_NOT_STARTED) {
+        return;
+    }
+
+    vTaskDelay(pdMS_TO_TICKS(RetryBackoffMs << (attempt - 1)));
+}
+
+bool SHT3xDIS::sendCommandToSensor(uint16_t command) {
     etl::array<uint8_t, NumberOfBytesInCommand> commandBytes{};
     splitHalfWordToByteArray(commandBytes, command);
-    executeI2CTransaction(SHT3xDIS_TWIHS_Write, commandBytes.data(), NumberOfBytesInCommand);
+    return executeI2CTransaction(SHT3xDIS_TWIHS_Write, commandBytes.data(), NumberOfBytesInCommand);
 }
 
 void
@@ -67,25 +142,305 @@ void SHT3xDIS::readSensorDataSingleShotMode(etl::array<uint8_t, NumberOfBytesOfM
     }
 
     if constexpr (UseCRC) {
-        if (not crc8(sensorData[0], sensorData[1], sensorData[2])) {
-            LOG_ERROR << "Error in Humidity Sensor temperature value checksum";
+        checkSensorDataCRC(sensorData);
+    }
+
+}
+
+bool SHT3xDIS::checkSensorDataCRC(const etl::array<uint8_t, NumberOfBytesOfMeasurementsWithCRC> &sensorData) {
+    if (not verifyCRC8(sensorData)) {
+        LOG_ERROR << "Error in Humidity Sensor measurement checksum";
+        return false;
+    }
+
+    return true;
+}
+
+bool SHT3xDIS::fetchSensorDataPeriodicMode(etl::array<uint8_t, NumberOfBytesOfMeasurementsWithCRC> &sensorData) {
+    etl::array<uint8_t, NumberOfBytesInCommand> commandBytes{};
+    splitHalfWordToByteArray(commandBytes, PeriodicModeControlCommands::FETCH_DATA);
+
+    if (not isTransactionAllowed()) {
+        return false;
+    }
+
+    if (not SHT3xDIS_TWIHS_WriteRead(I2CAddress, commandBytes.data(), NumberOfBytesInCommand, sensorData.data(),
+                                     NumberOfBytesOfMeasurementsWithCRC)) {
+        LOG_INFO << "Humidity sensor with address " << I2CAddress << ": I2C bus is busy";
+        healthCounters.busBusy++;
+        return false;
+    }
+
+    if (not waitForI2CBuffer()) {
+        recordFailure();
+        return false;
+    }
+
+    // A NACK of the read header means that no new measurement is available, unless a measurement period has
+    // passed since the last one
+    if (SHT3xDIS_TWIHS_ErrorGet() == TWIHS_ERROR_NACK) {
+        if (xTaskGetTickCount() - lastPeriodicFetchTick > periodicMeasurementPeriod + MeasurementGracePeriod) {
+            LOG_ERROR << "Humidity sensor with address " << I2CAddress << ": no measurement within its period";
+            healthCounters.nacks++;
+            recordFailure();
+            lastPeriodicFetchTick = xTaskGetTickCount();
         }
 
-        if (not crc8(sensorData[3], sensorData[4], sensorData[5])) {
-            LOG_ERROR << "Error in Humidity Sensor humidity value checksum";
+        return false;
+    }
+
+    recordSuccess();
+    lastPeriodicFetchTick = xTaskGetTickCount();
+
+    if constexpr (UseCRC) {
+        return checkSensorDataCRC(sensorData);
+    }
+
+    return true;
+}
+
+bool SHT3xDIS::readSensorDataIfReady(etl::array<uint8_t, NumberOfBytesOfMeasurementsWithCRC> &sensorData) {
+    if (not isTransactionAllowed()) {
+        return false;
+    }
+
+    if (not SHT3xDIS_TWIHS_Read(I2CAddress, sensorData.data(), NumberOfBytesOfMeasurementsWithCRC)) {
+        LOG_INFO << "Humidity sensor with address " << I2CAddress << ": I2C bus is busy";
+        healthCounters.busBusy++;
+        return false;
+    }
+
+    if (not waitForI2CBuffer()) {
+        recordFailure();
+        return false;
+    }
+
+    // A NACK of the read header means that the measurement is still in progress, unless it is overdue
+    if (SHT3xDIS_TWIHS_ErrorGet() == TWIHS_ERROR_NACK) {
+        if (isMeasurementOverdue()) {
+            LOG_ERROR << "Humidity sensor with address " << I2CAddress << ": measurement did not complete";
+            healthCounters.nacks++;
+            recordFailure();
         }
+
+        return false;
     }
 
+    recordSuccess();
+
+    return true;
 }
 
-etl::pair<float, float> SHT3xDIS::getOneShotMeasurement(SingleShotModeCommands command) {
+etl::pair<uint16_t, uint16_t> SHT3xDIS::readOneShotRawMeasurement(SingleShotModeCommands command) {
     etl::array<uint8_t, NumberOfBytesOfMeasurementsWithCRC> sensorData{};
+
+    if (isPeriodicModeActive) {
+        stopPeriodicMeasurement();
+    }
+
     sendCommandToSensor(command);
     vTaskDelay(pdMS_TO_TICKS(msToWait));
 
     readSensorDataSingleShotMode(sensorData);
-    return {convertRawTemperatureValueToPhysicalScale(concatenateTwoBytesToHalfWord(sensorData[0], sensorData[1])),
-            convertRawHumidityValueToPhysicalScale(concatenateTwoBytesToHalfWord(sensorData[3], sensorData[4]))};
+    return decodeRawMeasurement(sensorData);
+}
+
+etl::pair<float, float> SHT3xDIS::getOneShotMeasurement(SingleShotModeCommands command) {
+    const auto Raw = readOneShotRawMeasurement(command);
+
+    return {convertRawTemperatureValueToPhysicalScale(Raw.first), convertRawHumidityValueToPhysicalScale(Raw.second)};
+}
+
+bool SHT3xDIS::startMeasurement(SingleShotModeCommands command, MeasurementCallback callback, uintptr_t context) {
+    const uint16_t durationUs = getMaximumMeasurementDurationUs(command);
+
+    if (durationUs == 0) {
+        LOG_ERROR << "Humidity sensor with address " << I2CAddress << ": clock stretching is not supported";
+        return false;
+    }
+
+    if (isPeriodicModeActive) {
+        stopPeriodicMeasurement();
+    }
+
+    if (not sendCommandToSensor(command)) {
+        return false;
+    }
+
+    // Rounded up, plus one tick since the current tick may be about to end
+    measurementReadyTick = xTaskGetTickCount() + pdMS_TO_TICKS((durationUs + 999) / 1000) + 1;
+    measurementCallback = callback;
+    measurementCallbackContext = context;
+    isMeasurementPending = true;
+
+    return true;
+}
+
+etl::optional<etl::pair<float, float>> SHT3xDIS::pollResult() {
+    etl::array<uint8_t, NumberOfBytesOfMeasurementsWithCRC> sensorData{};
+
+    if (not isMeasurementPending) {
+        return etl::nullopt;
+    }
+
+    if (static_cast<int32_t>(xTaskGetTickCount() - measurementReadyTick) < 0) {
+        return etl::nullopt;
+    }
+
+    if (not readSensorDataIfReady(sensorData)) {
+        // An overdue measurement is abandoned, so that a sensor that was reset or removed does not stay pending
+        if (isMeasurementOverdue()) {
+            isMeasurementPending = false;
+        }
+
+        return etl::nullopt;
+    }
+
+    isMeasurementPending = false;
+
+    if constexpr (UseCRC) {
+        if (not checkSensorDataCRC(sensorData)) {
+            return etl::nullopt;
+        }
+    }
+
+    const auto Raw = decodeRawMeasurement(sensorData);
+    const float Temperature = convertRawTemperatureValueToPhysicalScale(Raw.first);
+    const float Humidity = convertRawHumidityValueToPhysicalScale(Raw.second);
+
+    if (measurementCallback != nullptr) {
+        measurementCallback(Temperature, Humidity, measurementCallbackContext);
+    }
+
+    return etl::pair<float, float>{Temperature, Humidity};
+}
+
+void SHT3xDIS::startPeriodicMeasurement(PeriodicModeCommands command) {
+    if (isPeriodicModeActive) {
+        stopPeriodicMeasurement();
+    }
+
+    sendCommandToSensor(command);
+    isPeriodicModeActive = true;
+    periodicMeasurementPeriod = pdMS_TO_TICKS(getPeriodicMeasurementPeriodMs(command));
+    lastPeriodicFetchTick = xTaskGetTickCount();
+}
+
+etl::optional<etl::pair<uint16_t, uint16_t>> SHT3xDIS::fetchPeriodicRawMeasurement() {
+    etl::array<uint8_t, NumberOfBytesOfMeasurementsWithCRC> sensorData{};
+
+    if (not isPeriodicModeActive) {
+        LOG_ERROR << "Humidity sensor with address " << I2CAddress << ": periodic mode is not started";
+        return etl::nullopt;
+    }
+
+    if (not fetchSensorDataPeriodicMode(sensorData)) {
+        return etl::nullopt;
+    }
+
+    return decodeRawMeasurement(sensorData);
+}
+
+etl::optional<etl::pair<float, float>> SHT3xDIS::fetchPeriodicMeasurement() {
+    const auto Raw = fetchPeriodicRawMeasurement();
+
+    if (not Raw) {
+        return etl::nullopt;
+    }
+
+    return etl::pair<float, float>{convertRawTemperatureValueToPhysicalScale(Raw->first),
+                                   convertRawHumidityValueToPhysicalScale(Raw->second)};
+}
+
+etl::pair<int16_t, uint16_t> SHT3xDIS::getOneShotMeasurementCentiUnits(SingleShotModeCommands command) {
+    const auto Raw = readOneShotRawMeasurement(command);
+
+    return {convertRawTemperatureValueToCentiDegrees(Raw.first), convertRawHumidityValueToCentiPercent(Raw.second)};
+}
+
+etl::optional<etl::pair<int16_t, uint16_t>> SHT3xDIS::fetchPeriodicMeasurementCentiUnits() {
+    const auto Raw = fetchPeriodicRawMeasurement();
+
+    if (not Raw) {
+        return etl::nullopt;
+    }
+
+    return etl::pair<int16_t, uint16_t>{convertRawTemperatureValueToCentiDegrees(Raw->first),
+                                        convertRawHumidityValueToCentiPercent(Raw->second)};
+}
+
+void SHT3xDIS::stopPeriodicMeasurement() {
+    sendCommandToSensor(PeriodicModeControlCommands::BREAK);
+    isPeriodicModeActive = false;
+    vTaskDelay(pdMS_TO_TICKS(msToWaitAfterBreak));
+}
+
+bool SHT3xDIS::writeAlertLimit(AlertLimit limit, float temperature, float humidity) {
+    const uint16_t Word = packAlertLimit(convertTemperatureToRawValue(temperature), convertHumidityToRawValue(humidity));
+    const uint16_t Command = WriteAlertLimitCommands[limit];
+
+    etl::array<uint8_t, NumberOfBytesOfAlertLimitWrite> writeData = {
+            static_cast<uint8_t>(Command >> 8), static_cast<uint8_t>(Command & 0xFF),
+            static_cast<uint8_t>(Word >> 8), static_cast<uint8_t>(Word & 0xFF),
+            calculateCRC8(static_cast<uint8_t>(Word >> 8), static_cast<uint8_t>(Word & 0xFF))};
+
+    return executeI2CTransaction(SHT3xDIS_TWIHS_Write, writeData.data(), NumberOfBytesOfAlertLimitWrite);
+}
+
+etl::optional<etl::pair<float, float>> SHT3xDIS::readAlertLimit(AlertLimit limit) {
+    etl::array<uint8_t, NumberOfBytesInCommand> commandBytes{};
+    etl::array<uint8_t, NumberOfBytesOfWordWithCRC> limitData{};
+
+    splitHalfWordToByteArray(commandBytes, ReadAlertLimitCommands[limit]);
+
+    if (not executeI2CTransaction(SHT3xDIS_TWIHS_WriteRead, commandBytes.data(), NumberOfBytesInCommand,
+                                  limitData.data(), NumberOfBytesOfWordWithCRC)) {
+        return etl::nullopt;
+    }
+
+    if (not verifyCRC8(limitData)) {
+        LOG_ERROR << "Error in Humidity Sensor alert limit checksum";
+        return etl::nullopt;
+    }
+
+    const uint16_t Word = concatenateTwoBytesToHalfWord(limitData[0], limitData[1]);
+
+    return etl::pair<float, float>{convertRawTemperatureValueToPhysicalScale(static_cast<uint16_t>((Word & 0x01FF) << 7)),
+                                   convertRawHumidityValueToPhysicalScale(static_cast<uint16_t>(Word & 0xFE00))};
+}
+
+bool SHT3xDIS::enableAlert(AlertCallback callback, uintptr_t context) {
+    if (AlertPin == PIO_PIN_NONE) {
+        LOG_ERROR << "Humidity sensor with address " << I2CAddress << ": no Alert pin is connected";
+        return false;
+    }
+
+    PIO_PinInterruptDisable(AlertPin);
+    alertCallback = callback;
+    alertCallbackContext = context;
+
+    PIO_PinInterruptCallbackRegister(AlertPin, alertPinCallback, reinterpret_cast<uintptr_t>(this));
+    PIO_PinInterruptEnable(AlertPin);
+
+    return true;
+}
+
+void SHT3xDIS::disableAlert() {
+    if (AlertPin == PIO_PIN_NONE) {
+        return;
+    }
+
+    PIO_PinInterruptDisable(AlertPin);
+    alertCallback = nullptr;
+    alertCallbackContext = 0;
+}
+
+void SHT3xDIS::alertPinCallback(PIO_PIN pin, uintptr_t context) {
+    auto *sht3xdis = reinterpret_cast<SHT3xDIS *>(context);
+
+    if ((sht3xdis->alertCallback != nullptr) and PIO_PinRead(pin)) {
+        sht3xdis->alertCallback(sht3xdis->alertCallbackContext);
+    }
 }
 
 void SHT3xDIS::setHeater(SHT3xDIS::HeaterCommands command) {
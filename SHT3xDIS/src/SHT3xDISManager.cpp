@@ -0,0 +1,48 @@
+#include "SHT3xDISManager.hpp"
+
+bool SHT3xDISManager::registerSensor(SHT3xDIS &sensor) {
+    if (sensorsNumber >= MaximumSensors) {
+        LOG_ERROR << "Humidity sensor manager is full";
+        return false;
+    }
+
+    sensors[sensorsNumber] = &sensor;
+    sensorsNumber++;
+
+    return true;
+}
+
+SHT3xDISManager::Measurements SHT3xDISManager::measureAll(SHT3xDIS::SingleShotModeCommands command) {
+    Measurements measurements{};
+    etl::array<bool, MaximumSensors> isPending{};
+
+    for (uint8_t index = 0; index < sensorsNumber; index++) {
+        isPending[index] = sensors[index]->startMeasurement(command);
+    }
+
+    // All the conversions run in parallel, so a single wait covers the longest one
+    const uint16_t durationUs = SHT3xDIS::getMaximumMeasurementDurationUs(command);
+    vTaskDelay(pdMS_TO_TICKS((durationUs + 999) / 1000) + 1);
+
+    for (uint8_t attempt = 0; attempt <= msToWaitForLateSensors; attempt++) {
+        bool isAnyPending = false;
+
+        for (uint8_t index = 0; index < sensorsNumber; index++) {
+            if (not isPending[index]) {
+                continue;
+            }
+
+            measurements[index] = sensors[index]->pollResult();
+            isPending[index] = sensors[index]->isMeasurementInProgress();
+            isAnyPending = isAnyPending or isPending[index];
+        }
+
+        if (not isAnyPending) {
+            break;
+        }
+
+        vTaskDelay(pdMS_TO_TICKS(1));
+    }
+
+    return measurements;
+}
@@ -0,0 +1,14 @@
+#pragma once
+
+#include <stdint.h>
+
+/**
+ * Host replacement of the FreeRTOS kernel header: the tick count is the virtual time of the simulated camera
+ * (HostU3VCamera.c), 1 ms per tick.
+ */
+
+typedef uint32_t TickType_t;
+
+#define configTICK_RATE_HZ          ((TickType_t)1000)
+#define portTICK_PERIOD_MS          ((TickType_t)1000 / configTICK_RATE_HZ)
+#define pdMS_TO_TICKS(xTimeInMs)    ((TickType_t)(((TickType_t)(xTimeInMs) * configTICK_RATE_HZ) / (TickType_t)1000U))
@@ -0,0 +1,12 @@
+#pragma once
+
+#include <stdint.h>
+
+/**
+ * Host replacement of the Harmony device header: the data cache maintenance used by the driver, implemented by
+ * HostCache.c.
+ */
+
+void DCACHE_CLEAN_BY_ADDR(uint32_t *addr, int32_t size);
+
+void DCACHE_INVALIDATE_BY_ADDR(uint32_t *addr, int32_t size);
@@ -0,0 +1,15 @@
+#pragma once
+
+#include "FreeRTOS.h"
+
+/**
+ * Host replacement of the FreeRTOS task header. The host build runs the driver from a single thread, so the
+ * critical sections have no effect.
+ */
+
+#define taskENTER_CRITICAL()
+#define taskEXIT_CRITICAL()
+
+TickType_t xTaskGetTickCount(void);
+
+TickType_t xTaskGetTickCountFromISR(void);
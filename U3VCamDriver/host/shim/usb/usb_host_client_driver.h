@@ -0,0 +1,44 @@
+#pragma once
+
+#include <stdint.h>
+
+/**
+ * Host replacement of the Harmony USB Host client driver header: the USB Host Layer types and functions used by the
+ * U3V App, implemented by the simulated camera (HostU3VCamera.c).
+ */
+
+#define USB_HOST_RESULT_MIN         (-100)
+#define USB_HOST_BUS_ALL            ((USB_HOST_BUS)0xFF)
+
+typedef uint8_t USB_HOST_BUS;
+
+typedef enum
+{
+    USB_HOST_RESULT_FAILURE = USB_HOST_RESULT_MIN,
+    USB_HOST_RESULT_FALSE   = 0,
+    USB_HOST_RESULT_TRUE    = 1,
+    USB_HOST_RESULT_SUCCESS = USB_HOST_RESULT_TRUE
+} USB_HOST_RESULT;
+
+typedef enum
+{
+    USB_HOST_EVENT_DEVICE_UNSUPPORTED
+} USB_HOST_EVENT;
+
+typedef enum
+{
+    USB_HOST_EVENT_RESPONSE_NONE
+} USB_HOST_EVENT_RESPONSE;
+
+typedef USB_HOST_EVENT_RESPONSE (*USB_HOST_EVENT_HANDLER)(USB_HOST_EVENT event, void *eventData, uintptr_t context);
+
+typedef struct
+{
+    void (*initialize)(void *init);
+} USB_HOST_CLIENT_DRIVER;
+
+USB_HOST_RESULT USB_HOST_EventHandlerSet(USB_HOST_EVENT_HANDLER eventHandler, uintptr_t context);
+
+USB_HOST_RESULT USB_HOST_BusEnable(USB_HOST_BUS bus);
+
+USB_HOST_RESULT USB_HOST_BusIsEnabled(USB_HOST_BUS bus);
@@ -0,0 +1,91 @@
+#include "device.h"
+#include "HostCache.h"
+
+/**
+ * The data cache maintenance of the host build. The host has a coherent cache, so the operations have no effect on
+ * the memory; they are recorded, so that the runner can check which buffers the driver maintains and that the
+ * operations cover whole cache lines.
+ */
+
+
+/*******************************************************************************
+* Local function declarations
+*******************************************************************************/
+
+static void HostCache_Record(T_HostCacheOperation operation, uint32_t *addr, int32_t size);
+
+
+/*******************************************************************************
+* Constant & Variable declarations
+*******************************************************************************/
+
+static T_HostCacheRecord hostCache_Records[HOST_CACHE_RECORDS_NUMBER];
+
+static uint32_t hostCache_RecordsNumber;
+
+static uint32_t hostCache_MisalignedNumber;
+
+
+/*******************************************************************************
+* Function definitions
+*******************************************************************************/
+
+void DCACHE_CLEAN_BY_ADDR(uint32_t *addr, int32_t size)
+{
+    HostCache_Record(HOST_CACHE_CLEAN, addr, size);
+}
+
+
+void DCACHE_INVALIDATE_BY_ADDR(uint32_t *addr, int32_t size)
+{
+    HostCache_Record(HOST_CACHE_INVALIDATE, addr, size);
+}
+
+
+void HostCache_Reset(void)
+{
+    hostCache_RecordsNumber = 0U;
+    hostCache_MisalignedNumber = 0U;
+}
+
+
+uint32_t HostCache_GetRecordsNumber(void)
+{
+    return hostCache_RecordsNumber;
+}
+
+
+const T_HostCacheRecord *HostCache_GetRecord(uint32_t index)
+{
+    bool kept = (index < hostCache_RecordsNumber) && (index < HOST_CACHE_RECORDS_NUMBER);
+
+    return kept ? &hostCache_Records[index] : NULL;
+}
+
+
+uint32_t HostCache_GetMisalignedNumber(void)
+{
+    return hostCache_MisalignedNumber;
+}
+
+
+/*******************************************************************************
+* Local function definitions
+*******************************************************************************/
+
+static void HostCache_Record(T_HostCacheOperation operation, uint32_t *addr, int32_t size)
+{
+    uintptr_t address = (uintptr_t)addr;
+
+    if (((address % HOST_CACHE_LINE_SIZE) != 0U) || (size <= 0) || (((uint32_t)size % HOST_CACHE_LINE_SIZE) != 0U))
+    {
+        hostCache_MisalignedNumber++;
+    }
+
+    if (hostCache_RecordsNumber < HOST_CACHE_RECORDS_NUMBER)
+    {
+        hostCache_Records[hostCache_RecordsNumber] = (T_HostCacheRecord){operation, address, size};
+    }
+
+    hostCache_RecordsNumber++;
+}
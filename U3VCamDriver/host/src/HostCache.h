@@ -0,0 +1,90 @@
+#pragma once
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+
+/**
+ * Host cache line size.
+ *
+ * Line size of the Cortex-M7 data cache, against which the recorded
+ * operations are checked. It is independent of U3V_DCACHE_LINE_SIZE, so that
+ * a wrong configuration is detected too.
+ */
+#define HOST_CACHE_LINE_SIZE            UINT32_C(32)
+
+/**
+ * Host cache records number.
+ *
+ * Number of operations kept after a reset, the later ones are only counted.
+ */
+#define HOST_CACHE_RECORDS_NUMBER       UINT32_C(64)
+
+
+/*******************************************************************************
+* Type definitions
+*******************************************************************************/
+
+typedef enum
+{
+    HOST_CACHE_CLEAN,
+    HOST_CACHE_INVALIDATE
+} T_HostCacheOperation;
+
+typedef struct
+{
+    T_HostCacheOperation    operation;
+    uintptr_t               address;
+    int32_t                 size;
+} T_HostCacheRecord;
+
+
+/*******************************************************************************
+* Function declarations
+*******************************************************************************/
+
+/**
+ * Host cache reset.
+ *
+ * Clears the recorded operations and the counters.
+ */
+void HostCache_Reset(void);
+
+/**
+ * Host cache get records number.
+ *
+ * @return uint32_t Number of operations since the last reset, kept or not.
+ */
+uint32_t HostCache_GetRecordsNumber(void);
+
+/**
+ * Host cache get record.
+ *
+ * @param index
+ * @return const T_HostCacheRecord* The operation, or NULL if it was not kept.
+ */
+const T_HostCacheRecord *HostCache_GetRecord(uint32_t index);
+
+/**
+ * Host cache get misaligned number.
+ *
+ * On the target an operation on part of a line acts on the whole line, so a
+ * clean or invalidate that does not start and end on line boundaries may
+ * corrupt the neighbouring data.
+ * @return uint32_t Number of such operations since the last reset.
+ */
+uint32_t HostCache_GetMisalignedNumber(void);
+
+
+#ifdef __cplusplus
+}
+#endif //__cplusplus
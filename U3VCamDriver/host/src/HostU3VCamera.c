@@ -0,0 +1,545 @@
+#include "HostU3VCamera.h"
+#include "task.h"
+
+/**
+ * The simulated camera of the host build: the U3V Host and USB Host Layer functions used by the U3V App, backed by
+ * the registers of a camera with three image presets, and the FreeRTOS tick count, backed by a virtual clock.
+ *
+ * A Control Interface function returns once its transactions are done, as the blocking functions of U3VCam_Host.c
+ * do, so it advances the virtual clock by their duration and counts them in the Control IF statistics with the
+ * command and acknowledge sizes of the U3V specification.
+ */
+
+
+/*******************************************************************************
+* Local macro definitions
+*******************************************************************************/
+
+#define HOST_U3V_CAMERA_HANDLE                  ((T_U3VHostHandle)1)
+
+/* prefix of the Control IF command and acknowledge packets, magic key, flags, command id, length and request id */
+#define HOST_U3V_CAMERA_PREFIX_SIZE             UINT32_C(12)
+
+/* register address, reserved and read length of a read memory command */
+#define HOST_U3V_CAMERA_READ_CMD_SIZE           (HOST_U3V_CAMERA_PREFIX_SIZE + UINT32_C(12))
+
+/* register address of a write memory command, followed by the data */
+#define HOST_U3V_CAMERA_WRITE_CMD_SIZE          (HOST_U3V_CAMERA_PREFIX_SIZE + UINT32_C(8))
+
+/* reserved and bytes written of a write memory acknowledge */
+#define HOST_U3V_CAMERA_WRITE_ACK_SIZE          (HOST_U3V_CAMERA_PREFIX_SIZE + UINT32_C(4))
+
+#define HOST_U3V_CAMERA_REG_SIZE                UINT32_C(4)
+
+#define HOST_U3V_CAMERA_ADDR_REG_SIZE           UINT32_C(8)
+
+/* the string registers read by the App are all 64 bytes long */
+#define HOST_U3V_CAMERA_STRING_SIZE             U3V_REG_MODEL_NAME_SIZE
+
+
+/*******************************************************************************
+* Local type definitions
+*******************************************************************************/
+
+typedef struct
+{
+    T_HostU3VCameraTiming       timing;
+    T_HostU3VCameraPreset       presets[HOST_U3V_CAMERA_PRESETS_NUMBER];
+    uint32_t                    startupPreset;
+    uint32_t                    timeMs;
+    bool                        isPluggedIn;
+    bool                        attachIsPending;
+    uint32_t                    attachDueMs;
+    bool                        busIsEnabled;
+    T_U3VHostAttachEventHandler attachEventHandler;
+    uintptr_t                   attachContext;
+    T_U3VHostDetachEventHandler detachEventHandler;
+    uintptr_t                   detachContext;
+    bool                        ctrlIfIsCreated;
+    uint32_t                    presetSelector;
+    uint32_t                    pixelFormat;
+    uint32_t                    acquisitionMode;
+    uint32_t                    width;
+    uint32_t                    height;
+    uint32_t                    triggerMode;
+    uint32_t                    presetLoads;
+    T_U3VHostCtrlIfStats        ctrlIfStats;
+} T_HostU3VCamera;
+
+
+/*******************************************************************************
+* Local function declarations
+*******************************************************************************/
+
+static void HostU3VCamera_Transactions(uint32_t number, uint32_t cmdSize, uint32_t ackSize);
+
+static void HostU3VCamera_PowerUp(void);
+
+static void HostU3VCamera_LoadPreset(uint32_t presetRegVal);
+
+static inline bool HostU3VCamera_IsConnected(T_U3VHostHandle u3vObjHandle);
+
+
+/*******************************************************************************
+* Constant & Variable declarations
+*******************************************************************************/
+
+static T_HostU3VCamera hostU3VCamera;
+
+
+/*******************************************************************************
+* Function definitions
+*******************************************************************************/
+
+void HostU3VCamera_Initialize(const T_HostU3VCameraTiming *pTiming, const T_HostU3VCameraPreset *pPresets,
+                              uint32_t startupPreset)
+{
+    memset(&hostU3VCamera, 0, sizeof(hostU3VCamera));
+    hostU3VCamera.timing = *pTiming;
+    memcpy(hostU3VCamera.presets, pPresets, sizeof(hostU3VCamera.presets));
+    hostU3VCamera.startupPreset = startupPreset;
+
+    HostU3VCamera_PowerUp();
+}
+
+
+void HostU3VCamera_Attach(void)
+{
+    hostU3VCamera.attachIsPending = true;
+    hostU3VCamera.attachDueMs = hostU3VCamera.timeMs;
+}
+
+
+void HostU3VCamera_AdvanceMs(uint32_t ms)
+{
+    hostU3VCamera.timeMs += ms;
+
+    if (hostU3VCamera.attachIsPending && hostU3VCamera.busIsEnabled && (hostU3VCamera.attachEventHandler != NULL) &&
+        ((int32_t)(hostU3VCamera.timeMs - hostU3VCamera.attachDueMs) >= 0))
+    {
+        hostU3VCamera.attachIsPending = false;
+        hostU3VCamera.isPluggedIn = true;
+        hostU3VCamera.attachEventHandler(HOST_U3V_CAMERA_HANDLE, hostU3VCamera.attachContext);
+    }
+}
+
+
+uint32_t HostU3VCamera_GetTimeMs(void)
+{
+    return hostU3VCamera.timeMs;
+}
+
+
+uint32_t HostU3VCamera_GetPresetLoadsNumber(void)
+{
+    return hostU3VCamera.presetLoads;
+}
+
+
+TickType_t xTaskGetTickCount(void)
+{
+    return (TickType_t)hostU3VCamera.timeMs;
+}
+
+
+TickType_t xTaskGetTickCountFromISR(void)
+{
+    return (TickType_t)hostU3VCamera.timeMs;
+}
+
+
+USB_HOST_RESULT USB_HOST_EventHandlerSet(USB_HOST_EVENT_HANDLER eventHandler, uintptr_t context)
+{
+    (void)eventHandler;
+    (void)context;
+
+    return USB_HOST_RESULT_SUCCESS;
+}
+
+
+USB_HOST_RESULT USB_HOST_BusEnable(USB_HOST_BUS bus)
+{
+    (void)bus;
+    hostU3VCamera.busIsEnabled = true;
+
+    return USB_HOST_RESULT_SUCCESS;
+}
+
+
+USB_HOST_RESULT USB_HOST_BusIsEnabled(USB_HOST_BUS bus)
+{
+    (void)bus;
+
+    return (hostU3VCamera.busIsEnabled) ? USB_HOST_RESULT_TRUE : USB_HOST_RESULT_FALSE;
+}
+
+
+T_U3VHostResult U3VHost_AttachEventHandlerSet(T_U3VHostAttachEventHandler eventHandler, uintptr_t context)
+{
+    hostU3VCamera.attachEventHandler = eventHandler;
+    hostU3VCamera.attachContext = context;
+
+    return U3V_HOST_RESULT_SUCCESS;
+}
+
+
+T_U3VHostResult U3VHost_DetachEventHandlerSet(T_U3VHostHandle u3vObjHandle, T_U3VHostDetachEventHandler detachEventHandler, uintptr_t context)
+{
+    if (!HostU3VCamera_IsConnected(u3vObjHandle))
+    {
+        return U3V_HOST_RESULT_HANDLE_INVALID;
+    }
+
+    hostU3VCamera.detachEventHandler = detachEventHandler;
+    hostU3VCamera.detachContext = context;
+
+    return U3V_HOST_RESULT_SUCCESS;
+}
+
+
+T_U3VHostHandle U3VHost_Open(T_U3VHostHandle u3vObjHandle)
+{
+    return HostU3VCamera_IsConnected(u3vObjHandle) ? u3vObjHandle : U3V_HOST_HANDLE_INVALID;
+}
+
+
+T_U3VHostResult U3VHost_EventHandlerSet(T_U3VHostHandle u3vObjHandle, T_U3VHostEventHandler eventHandler, uintptr_t context)
+{
+    (void)eventHandler;
+    (void)context;
+
+    return HostU3VCamera_IsConnected(u3vObjHandle) ? U3V_HOST_RESULT_SUCCESS : U3V_HOST_RESULT_HANDLE_INVALID;
+}
+
+
+T_U3VHostResult U3VHost_CtrlIf_InterfaceCreate(T_U3VHostHandle u3vObjHandle)
+{
+    if (!HostU3VCamera_IsConnected(u3vObjHandle))
+    {
+        return U3V_HOST_RESULT_HANDLE_INVALID;
+    }
+
+    /* ABRM SBRM address, host byte alignment, maximum command and acknowledge lengths */
+    HostU3VCamera_Transactions(4U, HOST_U3V_CAMERA_READ_CMD_SIZE,
+                               HOST_U3V_CAMERA_PREFIX_SIZE + HOST_U3V_CAMERA_ADDR_REG_SIZE);
+    hostU3VCamera.ctrlIfIsCreated = true;
+
+    return U3V_HOST_RESULT_SUCCESS;
+}
+
+
+void U3VHost_CtrlIf_InterfaceDestroy(T_U3VHostHandle u3vObjHandle)
+{
+    (void)u3vObjHandle;
+    hostU3VCamera.ctrlIfIsCreated = false;
+}
+
+
+T_U3VHostResult U3VHost_GetStreamCapabilities(T_U3VHostHandle u3vObjHandle)
+{
+    if (!HostU3VCamera_IsConnected(u3vObjHandle) || !hostU3VCamera.ctrlIfIsCreated)
+    {
+        return U3V_HOST_RESULT_HANDLE_INVALID;
+    }
+
+    /* SIRM address, SBRM capabilities, SIRM info and transfer alignment */
+    HostU3VCamera_Transactions(4U, HOST_U3V_CAMERA_READ_CMD_SIZE,
+                               HOST_U3V_CAMERA_PREFIX_SIZE + HOST_U3V_CAMERA_ADDR_REG_SIZE);
+
+    return U3V_HOST_RESULT_SUCCESS;
+}
+
+
+T_U3VHostResult U3VHost_SetupStreamIfTransfer(T_U3VHostHandle u3vObjHandle, uint32_t imgPayloadSize)
+{
+    if (!HostU3VCamera_IsConnected(u3vObjHandle) || !hostU3VCamera.ctrlIfIsCreated || (imgPayloadSize == 0U))
+    {
+        return U3V_HOST_RESULT_INVALID_PARAMETER;
+    }
+
+    /* the SIRM maximum transfer sizes read, then the leader, payload and trailer transfer sizes written */
+    HostU3VCamera_Transactions(3U, HOST_U3V_CAMERA_READ_CMD_SIZE,
+                               HOST_U3V_CAMERA_PREFIX_SIZE + HOST_U3V_CAMERA_REG_SIZE);
+    HostU3VCamera_Transactions(7U, HOST_U3V_CAMERA_WRITE_CMD_SIZE + HOST_U3V_CAMERA_REG_SIZE,
+                               HOST_U3V_CAMERA_WRITE_ACK_SIZE);
+
+    return U3V_HOST_RESULT_SUCCESS;
+}
+
+
+T_U3VHostResult U3VHost_StreamIfControl(T_U3VHostHandle u3vObjHandle, bool enable)
+{
+    (void)enable;
+
+    if (!HostU3VCamera_IsConnected(u3vObjHandle) || !hostU3VCamera.ctrlIfIsCreated)
+    {
+        return U3V_HOST_RESULT_HANDLE_INVALID;
+    }
+
+    HostU3VCamera_Transactions(1U, HOST_U3V_CAMERA_WRITE_CMD_SIZE + HOST_U3V_CAMERA_REG_SIZE,
+                               HOST_U3V_CAMERA_WRITE_ACK_SIZE);
+
+    return U3V_HOST_RESULT_SUCCESS;
+}
+
+
+T_U3VHostResult U3VHost_StartImgPayldTransfer(T_U3VHostHandle u3vObjHandle, void *imgBfr, size_t size)
+{
+    (void)imgBfr;
+    (void)size;
+
+    /* the simulated camera streams no image, the transfer stays pending */
+    return HostU3VCamera_IsConnected(u3vObjHandle) ? U3V_HOST_RESULT_SUCCESS : U3V_HOST_RESULT_HANDLE_INVALID;
+}
+
+
+T_U3VHostResult U3VHost_StreamIfClearHalt(T_U3VHostHandle u3vObjHandle)
+{
+    return HostU3VCamera_IsConnected(u3vObjHandle) ? U3V_HOST_RESULT_SUCCESS : U3V_HOST_RESULT_HANDLE_INVALID;
+}
+
+
+T_U3VHostResult U3VHost_ReadMemRegIntegerValue(T_U3VHostHandle u3vObjHandle, T_U3VMemRegInteger integerReg, uint32_t *pReadValue)
+{
+    uint32_t bytesPerPixel;
+
+    if (!HostU3VCamera_IsConnected(u3vObjHandle) || !hostU3VCamera.ctrlIfIsCreated || (pReadValue == NULL))
+    {
+        return U3V_HOST_RESULT_INVALID_PARAMETER;
+    }
+
+    HostU3VCamera_Transactions(1U, HOST_U3V_CAMERA_READ_CMD_SIZE, HOST_U3V_CAMERA_PREFIX_SIZE + HOST_U3V_CAMERA_REG_SIZE);
+
+    switch (integerReg)
+    {
+        case U3V_MEM_REG_INT_IMG_PRESET_CURRENT:
+        case U3V_MEM_REG_INT_IMG_PRESET_SELECT:
+            *pReadValue = hostU3VCamera.presetSelector;
+            break;
+
+        case U3V_MEM_REG_INT_ACQ_MODE:
+            *pReadValue = hostU3VCamera.acquisitionMode;
+            break;
+
+        case U3V_MEM_REG_INT_PAYLOAD_SIZE:
+            /* the PFNC pixel format holds the bits per pixel in its bits 16 to 23 */
+            bytesPerPixel = ((hostU3VCamera.pixelFormat >> 16U) & UINT32_C(0xFF)) / 8U;
+            *pReadValue = hostU3VCamera.width * hostU3VCamera.height * bytesPerPixel;
+            break;
+
+        case U3V_MEM_REG_INT_PIXEL_FORMAT:
+            *pReadValue = hostU3VCamera.pixelFormat;
+            break;
+
+        case U3V_MEM_REG_INT_TRIGGER_MODE:
+            *pReadValue = hostU3VCamera.triggerMode;
+            break;
+
+        /* command registers, read as 0 */
+        case U3V_MEM_REG_INT_IMG_PRESET_LOAD:
+        case U3V_MEM_REG_INT_ACQ_START:
+        case U3V_MEM_REG_INT_ACQ_STOP:
+        case U3V_MEM_REG_INT_DEVICE_RESET:
+        case U3V_MEM_REG_INT_TRIGGER_SOFTWARE:
+        default:
+            *pReadValue = UINT32_C(0);
+            break;
+    }
+
+    return U3V_HOST_RESULT_SUCCESS;
+}
+
+
+T_U3VHostResult U3VHost_WriteMemRegIntegerValue(T_U3VHostHandle u3vObjHandle, T_U3VMemRegInteger integerReg, uint32_t writeValue)
+{
+    if (!HostU3VCamera_IsConnected(u3vObjHandle) || !hostU3VCamera.ctrlIfIsCreated)
+    {
+        return U3V_HOST_RESULT_INVALID_PARAMETER;
+    }
+
+    HostU3VCamera_Transactions(1U, HOST_U3V_CAMERA_WRITE_CMD_SIZE + HOST_U3V_CAMERA_REG_SIZE,
+                               HOST_U3V_CAMERA_WRITE_ACK_SIZE);
+
+    switch (integerReg)
+    {
+        case U3V_MEM_REG_INT_IMG_PRESET_CURRENT:
+        case U3V_MEM_REG_INT_IMG_PRESET_SELECT:
+            hostU3VCamera.presetSelector = writeValue;
+            break;
+
+        case U3V_MEM_REG_INT_IMG_PRESET_LOAD:
+            HostU3VCamera_LoadPreset(hostU3VCamera.presetSelector);
+            hostU3VCamera.presetLoads++;
+            hostU3VCamera.timeMs += hostU3VCamera.timing.presetLoadMs;
+            break;
+
+        case U3V_MEM_REG_INT_ACQ_MODE:
+            hostU3VCamera.acquisitionMode = writeValue;
+            break;
+
+        case U3V_MEM_REG_INT_PIXEL_FORMAT:
+            hostU3VCamera.pixelFormat = writeValue;
+            hostU3VCamera.timeMs += hostU3VCamera.timing.pixelFormatMs;
+            break;
+
+        case U3V_MEM_REG_INT_TRIGGER_MODE:
+            hostU3VCamera.triggerMode = writeValue;
+            break;
+
+        case U3V_MEM_REG_INT_DEVICE_RESET:
+            /* the camera drops off the bus, reboots with its startup preset and attaches again */
+            hostU3VCamera.isPluggedIn = false;
+            hostU3VCamera.attachIsPending = true;
+            hostU3VCamera.attachDueMs = hostU3VCamera.timeMs + hostU3VCamera.timing.rebootMs;
+            HostU3VCamera_PowerUp();
+            if (hostU3VCamera.detachEventHandler != NULL)
+            {
+                hostU3VCamera.detachEventHandler(u3vObjHandle, hostU3VCamera.detachContext);
+            }
+            break;
+
+        case U3V_MEM_REG_INT_PAYLOAD_SIZE:
+        case U3V_MEM_REG_INT_ACQ_START:
+        case U3V_MEM_REG_INT_ACQ_STOP:
+        case U3V_MEM_REG_INT_TRIGGER_SOFTWARE:
+        default:
+            break;
+    }
+
+    return U3V_HOST_RESULT_SUCCESS;
+}
+
+
+T_U3VHostResult U3VHost_ReadMemRegFloatValue(T_U3VHostHandle u3vObjHandle, T_U3VMemRegFloat floatReg, float *pReadValue)
+{
+    if (!HostU3VCamera_IsConnected(u3vObjHandle) || !hostU3VCamera.ctrlIfIsCreated || (pReadValue == NULL) ||
+        (floatReg != U3V_MEM_REG_FLOAT_TEMPERATURE))
+    {
+        return U3V_HOST_RESULT_INVALID_PARAMETER;
+    }
+
+    HostU3VCamera_Transactions(1U, HOST_U3V_CAMERA_READ_CMD_SIZE, HOST_U3V_CAMERA_PREFIX_SIZE + HOST_U3V_CAMERA_REG_SIZE);
+    *pReadValue = 41.5F;
+
+    return U3V_HOST_RESULT_SUCCESS;
+}
+
+
+T_U3VHostResult U3VHost_ReadMemRegStringValue(T_U3VHostHandle u3vObjHandle, T_U3VMemRegString stringReg, void *pReadBfr)
+{
+    static const char *const Strings[] =
+    {
+        [U3V_MEM_REG_STRING_MANUFACTURER_NAME]  = "FLIR",
+        [U3V_MEM_REG_STRING_MODEL_NAME]         = "Blackfly S BFS-U3-16S2C",
+        [U3V_MEM_REG_STRING_FAMILY_NAME]        = "Blackfly S",
+        [U3V_MEM_REG_STRING_DEVICE_VERSION]     = "1.0 host",
+        [U3V_MEM_REG_STRING_MANUFACTURER_INFO]  = "host simulated camera",
+        [U3V_MEM_REG_STRING_SERIAL_NUMBER]      = "00000001",
+        [U3V_MEM_REG_STRING_USER_DEFINED_NAME]  = "",
+    };
+
+    if (!HostU3VCamera_IsConnected(u3vObjHandle) || !hostU3VCamera.ctrlIfIsCreated || (pReadBfr == NULL) ||
+        ((uint32_t)stringReg >= (sizeof(Strings) / sizeof(Strings[0]))))
+    {
+        return U3V_HOST_RESULT_INVALID_PARAMETER;
+    }
+
+    HostU3VCamera_Transactions(1U, HOST_U3V_CAMERA_READ_CMD_SIZE, HOST_U3V_CAMERA_PREFIX_SIZE + HOST_U3V_CAMERA_STRING_SIZE);
+    memset(pReadBfr, 0, HOST_U3V_CAMERA_STRING_SIZE);
+    strncpy((char *)pReadBfr, Strings[stringReg], HOST_U3V_CAMERA_STRING_SIZE - 1U);
+
+    return U3V_HOST_RESULT_SUCCESS;
+}
+
+
+void U3VHost_GetCtrlIfStats(T_U3VHostCtrlIfStats *pStats)
+{
+    if (pStats != NULL)
+    {
+        *pStats = hostU3VCamera.ctrlIfStats;
+    }
+}
+
+
+/*******************************************************************************
+* Local function definitions
+*******************************************************************************/
+
+/**
+ * Host camera Control IF transactions.
+ *
+ * Accounts blocking Control IF transactions, each a command and its
+ * acknowledge, to the statistics and to the virtual time.
+ * @param number transactions number
+ * @param cmdSize command packet size
+ * @param ackSize acknowledge packet size
+ */
+static void HostU3VCamera_Transactions(uint32_t number, uint32_t cmdSize, uint32_t ackSize)
+{
+    hostU3VCamera.ctrlIfStats.transactions += number;
+    hostU3VCamera.ctrlIfStats.bytesMoved += number * (cmdSize + ackSize);
+    hostU3VCamera.timeMs += number * hostU3VCamera.timing.transactionMs;
+}
+
+
+/**
+ * Host camera power up.
+ *
+ * Resets the registers to the startup preset.
+ */
+static void HostU3VCamera_PowerUp(void)
+{
+    static const uint32_t PresetRegVals[HOST_U3V_CAMERA_PRESETS_NUMBER] =
+    {
+        U3V_CAM_IMG_PRESET_DEFAULT_SET,
+        U3V_CAM_IMG_PRESET_USER_SET_0,
+        U3V_CAM_IMG_PRESET_USER_SET_1
+    };
+
+    hostU3VCamera.ctrlIfIsCreated = false;
+    hostU3VCamera.triggerMode = UINT32_C(0);
+    hostU3VCamera.presetSelector = PresetRegVals[hostU3VCamera.startupPreset];
+    HostU3VCamera_LoadPreset(hostU3VCamera.presetSelector);
+}
+
+
+/**
+ * Host camera load preset.
+ *
+ * Loads the registers of the preset selected by a UserSetSelector value, an
+ * unknown value loads nothing.
+ * @param presetRegVal
+ */
+static void HostU3VCamera_LoadPreset(uint32_t presetRegVal)
+{
+    const T_HostU3VCameraPreset *pPreset;
+
+    switch (presetRegVal)
+    {
+        case U3V_CAM_IMG_PRESET_DEFAULT_SET:
+            pPreset = &hostU3VCamera.presets[0];
+            break;
+
+        case U3V_CAM_IMG_PRESET_USER_SET_0:
+            pPreset = &hostU3VCamera.presets[1];
+            break;
+
+        case U3V_CAM_IMG_PRESET_USER_SET_1:
+            pPreset = &hostU3VCamera.presets[2];
+            break;
+
+        default:
+            return;
+    }
+
+    hostU3VCamera.pixelFormat = pPreset->pixelFormat;
+    hostU3VCamera.acquisitionMode = pPreset->acquisitionMode;
+    hostU3VCamera.width = pPreset->width;
+    hostU3VCamera.height = pPreset->height;
+}
+
+
+static inline bool HostU3VCamera_IsConnected(T_U3VHostHandle u3vObjHandle)
+{
+    return hostU3VCamera.isPluggedIn && (u3vObjHandle == HOST_U3V_CAMERA_HANDLE);
+}
@@ -0,0 +1,105 @@
+#pragma once
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "U3VCam_Host.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+
+/**
+ * Host camera image presets number.
+ *
+ * Default set, user set 0 and user set 1, indexed as T_U3VCamDriverImagePreset.
+ */
+#define HOST_U3V_CAMERA_PRESETS_NUMBER  UINT32_C(3)
+
+
+/*******************************************************************************
+* Type definitions
+*******************************************************************************/
+
+/**
+ * Host camera timing.
+ *
+ * Virtual time taken by the simulated camera, in ms. A Control Interface
+ * transaction is a command and its acknowledge.
+ */
+typedef struct
+{
+    uint32_t    transactionMs;      /* round trip of a register read or write */
+    uint32_t    presetLoadMs;       /* extra time of a UserSetLoad */
+    uint32_t    pixelFormatMs;      /* extra time of a pixel format change */
+    uint32_t    rebootMs;           /* from a device reset to the new attach */
+} T_HostU3VCameraTiming;
+
+/**
+ * Host camera image preset.
+ *
+ * Register values loaded by a preset.
+ */
+typedef struct
+{
+    uint32_t    pixelFormat;
+    uint32_t    acquisitionMode;
+    uint32_t    width;
+    uint32_t    height;
+} T_HostU3VCameraPreset;
+
+
+/*******************************************************************************
+* Function declarations
+*******************************************************************************/
+
+/**
+ * Host camera initialize.
+ *
+ * Detaches the camera, resets the virtual time to 0 and powers the camera up
+ * with the startup preset loaded.
+ * @param pTiming timing of the camera (copied)
+ * @param pPresets HOST_U3V_CAMERA_PRESETS_NUMBER presets (copied)
+ * @param startupPreset index of the preset loaded at power up
+ */
+void HostU3VCamera_Initialize(const T_HostU3VCameraTiming *pTiming, const T_HostU3VCameraPreset *pPresets,
+                              uint32_t startupPreset);
+
+/**
+ * Host camera attach.
+ *
+ * Plugs the camera in, the attach event is delivered once the bus is enabled.
+ */
+void HostU3VCamera_Attach(void);
+
+/**
+ * Host camera advance time.
+ *
+ * Advances the virtual time, as the period of the task that runs the driver,
+ * and delivers the attach of a rebooted camera when it is due.
+ * @param ms
+ */
+void HostU3VCamera_AdvanceMs(uint32_t ms);
+
+/**
+ * Host camera get time.
+ *
+ * @return uint32_t The virtual time in ms, also the FreeRTOS tick count.
+ */
+uint32_t HostU3VCamera_GetTimeMs(void);
+
+/**
+ * Host camera get preset loads number.
+ *
+ * @return uint32_t Number of UserSetLoad commands since initialization.
+ */
+uint32_t HostU3VCamera_GetPresetLoadsNumber(void);
+
+
+#ifdef __cplusplus
+}
+#endif //__cplusplus
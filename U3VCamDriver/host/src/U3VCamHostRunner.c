@@ -0,0 +1,890 @@
+#define _POSIX_C_SOURCE 200809L
+
+#include <fcntl.h>
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include "HostCache.h"
+#include "HostU3VCamera.h"
+#include "U3VCam_App.h"
+#include "U3VCam_BufPool.h"
+#include "U3VCam_PixelFormat.h"
+#include "U3VCam_WriteBehind.h"
+
+/**
+ * The host build runner of the U3VCamDriver modules: functional checks of the payload buffer pool and of its cache
+ * maintenance against the recording cache of HostCache.c, of the pixel format kernels against reference conversions, of
+ * the write-behind buffers against a file-backed block device, and of the U3V App bring-up and image preset switches
+ * against the simulated camera of HostU3VCamera.c, then, with --benchmark, the bring-up profiles, the pixels/s of each
+ * pixel format kernel on a full frame and the sustained throughput of the write-behind path to a file (a temporary one,
+ * or the file or block device given after --benchmark).
+ *
+ * The bring-up check fails when a cold start or a warm reconnect of the simulated camera takes longer than
+ * U3V_BRINGUP_COLD_START_BUDGET_MS or U3V_BRINGUP_WARM_RECONNECT_BUDGET_MS. The camera timing is that of a typical
+ * camera, so a failure is a regression of the number of transactions or of the steps taken by the App.
+ *
+ * The throughput is measured with a single thread which produces the payload blocks and runs the storage task when
+ * the buffers are full, as the application does with backpressure, so it is the rate at which frames become durable.
+ * The process exits with a non-zero status if a check fails.
+ */
+
+
+/*******************************************************************************
+* Local type definitions
+*******************************************************************************/
+
+typedef struct
+{
+    int         fd;
+    uint32_t    blockSize;
+    bool        sync;           /* each write is synced to the file before returning */
+    uint32_t    writes;
+} T_HostBlockFile;
+
+
+/*******************************************************************************
+* Constant & Variable declarations
+*******************************************************************************/
+
+#define HOST_BLOCK_SIZE                 UINT32_C(512)
+
+/* the image payload of an RGB8 640x480 frame, in blocks of U3V_PAYLD_BLOCK_MAX_SIZE */
+#define HOST_FRAME_SIZE                 ((size_t)(640U * 480U * 3U))
+
+static uint32_t checksNumber;
+
+static uint32_t failedChecksNumber;
+
+static uint8_t payloadBlock[U3V_PAYLD_BLOCK_MAX_SIZE];
+
+static uint8_t readBackFrame[HOST_FRAME_SIZE + HOST_BLOCK_SIZE];
+
+/* the sensor of the FLIR BFS-U3-16S2C-CS, 1440x1080 */
+#define HOST_IMAGE_WIDTH                ((size_t)1440)
+#define HOST_IMAGE_HEIGHT               ((size_t)1080)
+#define HOST_IMAGE_PIXELS               (HOST_IMAGE_WIDTH * HOST_IMAGE_HEIGHT)
+
+static uint8_t packed12pImage[(HOST_IMAGE_PIXELS * 3U) / 2U];
+
+static uint16_t unpacked16Image[HOST_IMAGE_PIXELS];
+
+static uint8_t bayer8Image[HOST_IMAGE_PIXELS];
+
+static uint8_t rgb8Image[HOST_IMAGE_PIXELS * 3U];
+
+static uint8_t referenceRgb8Image[HOST_IMAGE_PIXELS * 3U];
+
+static uint8_t yuv420Image[(HOST_IMAGE_PIXELS * 3U) / 2U];
+
+static uint8_t scratchRows[HOST_IMAGE_WIDTH * 3U];
+
+/* the period of the task that runs U3VCamDriver_Tasks */
+#define HOST_TASK_PERIOD_MS             UINT32_C(10)
+
+/* the time allowed to a bring-up before the runner gives up, well over the budgets */
+#define HOST_BRINGUP_TIMEOUT_MS         UINT32_C(60000)
+
+/* BayerRG8, the pixel format of the default set, which the App changes to U3V_CAM_CFG_PIXEL_FORMAT_SEL */
+#define HOST_PFNC_BAYER_RG8             UINT32_C(0x01080009)
+
+/* a camera with a 1 ms Control IF round trip, 200 ms to load a user set and 2 s to reboot */
+static const T_HostU3VCameraTiming hostCameraTiming = { .transactionMs = 1U, .presetLoadMs = 200U, .pixelFormatMs = 20U,
+                                                        .rebootMs = 2000U };
+
+/* the default set, user set 0 with the App configuration, and user set 1 with the App configuration at half size */
+static const T_HostU3VCameraPreset hostCameraPresets[HOST_U3V_CAMERA_PRESETS_NUMBER] =
+{
+    { .pixelFormat = HOST_PFNC_BAYER_RG8, .acquisitionMode = 0U,
+      .width = (uint32_t)HOST_IMAGE_WIDTH, .height = (uint32_t)HOST_IMAGE_HEIGHT },
+    { .pixelFormat = U3V_CAM_CFG_PIXEL_FORMAT_SEL, .acquisitionMode = U3V_CAM_CFG_ACQ_MODE_SEL,
+      .width = (uint32_t)HOST_IMAGE_WIDTH, .height = (uint32_t)HOST_IMAGE_HEIGHT },
+    { .pixelFormat = U3V_CAM_CFG_PIXEL_FORMAT_SEL, .acquisitionMode = U3V_CAM_CFG_ACQ_MODE_SEL,
+      .width = (uint32_t)HOST_IMAGE_WIDTH / 2U, .height = (uint32_t)HOST_IMAGE_HEIGHT / 2U },
+};
+
+static uint32_t budgetErrorsNumber;
+
+static uint32_t otherErrorsNumber;
+
+static T_U3VAppBringUpProfile coldStartProfile;
+
+static T_U3VAppBringUpProfile warmReconnectProfile;
+
+
+/*******************************************************************************
+* Local function definitions
+*******************************************************************************/
+
+static void check(bool condition, const char *description)
+{
+    checksNumber++;
+
+    if (!condition)
+    {
+        failedChecksNumber++;
+    }
+
+    printf("[%s] %s\n", condition ? "PASS" : "FAIL", description);
+}
+
+
+static double getTimeSeconds(void)
+{
+    struct timespec now;
+
+    clock_gettime(CLOCK_MONOTONIC, &now);
+
+    return (double)now.tv_sec + ((double)now.tv_nsec * 1e-9);
+}
+
+
+/**
+ * The T_U3VWriteBehindBlockWrite of the file-backed block device: a write at the LBA offset of the file, synced
+ * to the file when requested, so that a successful write is durable as the interface requires.
+ */
+static bool hostBlockFileWrite(uintptr_t context, uint32_t lba, const void *pData, uint32_t blockCount)
+{
+    T_HostBlockFile *pFile = (T_HostBlockFile *)context;
+    const size_t size = (size_t)blockCount * pFile->blockSize;
+
+    pFile->writes++;
+
+    if (pwrite(pFile->fd, pData, size, (off_t)lba * pFile->blockSize) != (ssize_t)size)
+    {
+        return false;
+    }
+
+    return (!pFile->sync || (fdatasync(pFile->fd) == 0));
+}
+
+
+static T_U3VWriteBehindBlockDevice hostBlockDevice(T_HostBlockFile *pFile, uint32_t lbaCount)
+{
+    T_U3VWriteBehindBlockDevice device =
+    {
+        .blockSize = pFile->blockSize,
+        .firstLba = 0U,
+        .lbaCount = lbaCount,
+        .write = hostBlockFileWrite,
+        .context = (uintptr_t)pFile
+    };
+
+    return device;
+}
+
+
+/**
+ * Fills the payload block with the bytes of the frame at this offset, a pattern which differs between frames.
+ */
+static void fillPayloadBlock(uint32_t frameId, size_t offset, size_t size)
+{
+    for (size_t idx = 0U; idx < size; idx++)
+    {
+        payloadBlock[idx] = (uint8_t)((frameId * 31U) + ((offset + idx) / 7U));
+    }
+}
+
+
+/**
+ * Pushes a frame of the given size in payload blocks, running the storage task while the buffers are full.
+ * @return true if every block was accepted
+ */
+static bool pushFrame(uint32_t frameId, size_t frameSize, bool fillPattern)
+{
+    T_U3VWriteBehindResult result;
+    size_t blockSize;
+    bool accepted = true;
+
+    while (U3VWriteBehind_BeginFrame(frameId) == U3V_WB_RESULT_NO_SPACE)
+    {
+        /* the previous frame has been rejected as a whole, drop its end */
+        (void)U3VWriteBehind_EndFrame();
+        U3VWriteBehind_Tasks();
+    }
+
+    for (size_t offset = 0U; offset < frameSize; offset += blockSize)
+    {
+        blockSize = ((frameSize - offset) < U3V_PAYLD_BLOCK_MAX_SIZE) ? (frameSize - offset) : U3V_PAYLD_BLOCK_MAX_SIZE;
+        if (fillPattern)
+        {
+            fillPayloadBlock(frameId, offset, blockSize);
+        }
+        while (!U3VWriteBehind_CanAccept(blockSize))
+        {
+            U3VWriteBehind_Tasks();
+        }
+        result = U3VWriteBehind_PushBlock(payloadBlock, blockSize);
+        accepted = accepted && (result == U3V_WB_RESULT_SUCCESS);
+    }
+
+    return ((U3VWriteBehind_EndFrame() == U3V_WB_RESULT_SUCCESS) && accepted);
+}
+
+
+/**
+ * Reads a durable frame back from the ring and compares it with the pattern it was written with.
+ */
+static bool isFrameStored(const T_HostBlockFile *pFile, uint32_t lbaCount, uint32_t frameId, size_t frameSize)
+{
+    uint32_t lba;
+    uint32_t blockCount;
+    uint32_t readCount;
+    size_t offset = 0U;
+
+    if ((U3VWriteBehind_GetFrameRange(frameId, &lba, &blockCount) != U3V_WB_RESULT_SUCCESS) ||
+        (((size_t)blockCount * pFile->blockSize) > sizeof(readBackFrame)))
+    {
+        return false;
+    }
+
+    while (blockCount > 0U)
+    {
+        readCount = ((lbaCount - lba) < blockCount) ? (lbaCount - lba) : blockCount;
+        if (pread(pFile->fd, &readBackFrame[offset], (size_t)readCount * pFile->blockSize,
+                  (off_t)lba * pFile->blockSize) != (ssize_t)((size_t)readCount * pFile->blockSize))
+        {
+            return false;
+        }
+        offset += (size_t)readCount * pFile->blockSize;
+        blockCount -= readCount;
+        lba = 0U;
+    }
+
+    for (size_t idx = 0U; idx < frameSize; idx++)
+    {
+        if (readBackFrame[idx] != (uint8_t)((frameId * 31U) + (idx / 7U)))
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+
+static uint32_t nextRandom(uint32_t *pState)
+{
+    /* xorshift32, so that the runs are reproducible */
+    *pState ^= *pState << 13;
+    *pState ^= *pState >> 17;
+    *pState ^= *pState << 5;
+
+    return *pState;
+}
+
+
+/**
+ * Fills a BayerRG8 image and its BayerRG12p packing with the samples of a single colour, which every demosaicing
+ * kernel shall reproduce exactly, borders included.
+ */
+static void fillUniformBayer(uint8_t red, uint8_t green, uint8_t blue)
+{
+    uint16_t sample[2];
+
+    for (size_t y = 0U; y < HOST_IMAGE_HEIGHT; y++)
+    {
+        for (size_t x = 0U; x < HOST_IMAGE_WIDTH; x += 2U)
+        {
+            bayer8Image[(y * HOST_IMAGE_WIDTH) + x] = ((y & 1U) == 0U) ? red : green;
+            bayer8Image[(y * HOST_IMAGE_WIDTH) + x + 1U] = ((y & 1U) == 0U) ? green : blue;
+            /* the 12-bit samples keep the 8-bit value in bits [11:4] */
+            sample[0] = (uint16_t)((bayer8Image[(y * HOST_IMAGE_WIDTH) + x] << 4) | 0x9U);
+            sample[1] = (uint16_t)((bayer8Image[(y * HOST_IMAGE_WIDTH) + x + 1U] << 4) | 0x6U);
+            packed12pImage[((y * HOST_IMAGE_WIDTH) + x) * 3U / 2U] = (uint8_t)sample[0];
+            packed12pImage[(((y * HOST_IMAGE_WIDTH) + x) * 3U / 2U) + 1U] = (uint8_t)((sample[0] >> 8) | (sample[1] << 4));
+            packed12pImage[(((y * HOST_IMAGE_WIDTH) + x) * 3U / 2U) + 2U] = (uint8_t)(sample[1] >> 4);
+        }
+    }
+}
+
+
+static bool isUniformRgb8Image(uint8_t red, uint8_t green, uint8_t blue)
+{
+    bool uniform = true;
+
+    for (size_t idx = 0U; idx < HOST_IMAGE_PIXELS; idx++)
+    {
+        uniform = (rgb8Image[idx * 3U] == red) && (rgb8Image[(idx * 3U) + 1U] == green) &&
+                  (rgb8Image[(idx * 3U) + 2U] == blue) && uniform;
+    }
+
+    return uniform;
+}
+
+
+static void checkPixelFormat(void)
+{
+    T_U3VPixFmtUnpackCtx unpackCtx = { 0 };
+    uint32_t randomState = 1U;
+    size_t srcOffset = 0U;
+    size_t unpacked = 0U;
+    size_t blockSize;
+    bool matches = true;
+    bool frameMatches;
+
+    for (size_t idx = 0U; idx < sizeof(packed12pImage); idx++)
+    {
+        packed12pImage[idx] = (uint8_t)nextRandom(&randomState);
+    }
+
+    /* payload blocks of varying sizes split the pixel pairs at every possible byte */
+    for (blockSize = 1U; srcOffset < sizeof(packed12pImage); blockSize = (blockSize % 97U) + 1U)
+    {
+        blockSize = (blockSize < (sizeof(packed12pImage) - srcOffset)) ? blockSize : (sizeof(packed12pImage) - srcOffset);
+        unpacked += U3VPixFmt_Unpack12pTo16Block(&unpackCtx, &packed12pImage[srcOffset], blockSize, &unpacked16Image[unpacked]);
+        srcOffset += blockSize;
+    }
+    for (size_t idx = 0U; idx < HOST_IMAGE_PIXELS; idx += 2U)
+    {
+        const uint8_t *pPair = &packed12pImage[(idx * 3U) / 2U];
+
+        matches = (unpacked16Image[idx] == (uint16_t)(pPair[0] | ((pPair[1] & 0x0FU) << 8))) &&
+                  (unpacked16Image[idx + 1U] == (uint16_t)((pPair[1] >> 4) | (pPair[2] << 4))) && matches;
+    }
+    check((unpacked == HOST_IMAGE_PIXELS) && matches, "the 12p unpack of payload blocks of 1 to 97 bytes is exact");
+
+    U3VPixFmt_Unpack12pTo8(packed12pImage, HOST_IMAGE_PIXELS, bayer8Image);
+    matches = true;
+    for (size_t idx = 0U; idx < HOST_IMAGE_PIXELS; idx++)
+    {
+        matches = (bayer8Image[idx] == (uint8_t)(unpacked16Image[idx] >> 4)) && matches;
+    }
+    check(matches, "the 12p to 8-bit conversion keeps the 8 most significant bits");
+
+    /* the 12p frame conversions are the 8-bit ones on the 8 most significant bits */
+    frameMatches = U3VPixFmt_BayerRG8ToRGB8Frame(bayer8Image, HOST_IMAGE_WIDTH, HOST_IMAGE_HEIGHT, true, referenceRgb8Image) &&
+                   U3VPixFmt_BayerRG12pToRGB8Frame(packed12pImage, HOST_IMAGE_WIDTH, HOST_IMAGE_HEIGHT, true, scratchRows, rgb8Image) &&
+                   (memcmp(rgb8Image, referenceRgb8Image, sizeof(rgb8Image)) == 0);
+    frameMatches = U3VPixFmt_BayerRG8ToRGB8Frame(bayer8Image, HOST_IMAGE_WIDTH, HOST_IMAGE_HEIGHT, false, referenceRgb8Image) &&
+                   U3VPixFmt_BayerRG12pToRGB8Frame(packed12pImage, HOST_IMAGE_WIDTH, HOST_IMAGE_HEIGHT, false, scratchRows, rgb8Image) &&
+                   (memcmp(rgb8Image, referenceRgb8Image, sizeof(rgb8Image)) == 0) && frameMatches;
+    check(frameMatches, "the BayerRG12p frames convert as their 8 most significant bits in BayerRG8");
+
+    fillUniformBayer(200U, 100U, 50U);
+    check(U3VPixFmt_BayerRG8ToRGB8Frame(bayer8Image, HOST_IMAGE_WIDTH, HOST_IMAGE_HEIGHT, false, rgb8Image) &&
+          isUniformRgb8Image(200U, 100U, 50U), "the nearest neighbour demosaicing of a uniform colour is exact");
+    check(U3VPixFmt_BayerRG8ToRGB8Frame(bayer8Image, HOST_IMAGE_WIDTH, HOST_IMAGE_HEIGHT, true, rgb8Image) &&
+          isUniformRgb8Image(200U, 100U, 50U), "the bilinear demosaicing of a uniform colour is exact, borders included");
+    check(U3VPixFmt_BayerRG12pToRGB8Frame(packed12pImage, HOST_IMAGE_WIDTH, HOST_IMAGE_HEIGHT, true, scratchRows, rgb8Image) &&
+          isUniformRgb8Image(200U, 100U, 50U), "the bilinear demosaicing of a uniform BayerRG12p colour is exact");
+
+    memset(rgb8Image, 0xFF, sizeof(rgb8Image));
+    memset(&rgb8Image[sizeof(rgb8Image) / 2U], 0x00, sizeof(rgb8Image) / 2U);
+    matches = U3VPixFmt_RGB8ToYUV420Frame(rgb8Image, HOST_IMAGE_WIDTH, HOST_IMAGE_HEIGHT, yuv420Image);
+    for (size_t idx = 0U; idx < HOST_IMAGE_PIXELS; idx++)
+    {
+        matches = (yuv420Image[idx] == ((idx < (HOST_IMAGE_PIXELS / 2U)) ? 235U : 16U)) && matches;
+    }
+    for (size_t idx = HOST_IMAGE_PIXELS; idx < sizeof(yuv420Image); idx++)
+    {
+        matches = (yuv420Image[idx] == 128U) && matches;
+    }
+    check(matches, "white and black convert to the limited range luma and neutral chroma");
+
+    check(!U3VPixFmt_RGB8ToYUV420Frame(rgb8Image, HOST_IMAGE_WIDTH, HOST_IMAGE_HEIGHT, NULL) &&
+          !U3VPixFmt_RGB8ToYUV420Frame(rgb8Image, HOST_IMAGE_WIDTH - 1U, HOST_IMAGE_HEIGHT, yuv420Image) &&
+          !U3VPixFmt_BayerRG12pToRGB8Frame(packed12pImage, HOST_IMAGE_WIDTH, HOST_IMAGE_HEIGHT, true, NULL, rgb8Image),
+          "the frame conversions refuse a missing buffer or an odd width");
+}
+
+
+static void checkBufPool(void)
+{
+    void *pBuffers[U3V_BUF_POOL_BLOCKS_NUMBER];
+    const T_HostCacheRecord *pRecord;
+    bool aligned = true;
+    bool disjoint = true;
+    uint8_t foreignBuffer[U3V_DCACHE_LINE_SIZE];
+
+    check((U3V_DCACHE_LINE_SIZE == HOST_CACHE_LINE_SIZE) && ((U3V_BUF_POOL_BLOCK_SIZE % HOST_CACHE_LINE_SIZE) == 0U) &&
+          (U3V_BUF_POOL_BLOCK_SIZE >= U3V_PAYLD_BLOCK_MAX_SIZE),
+          "the pool blocks are whole cache lines and hold a payload block");
+
+    for (uint32_t idx = 0U; idx < U3V_BUF_POOL_BLOCKS_NUMBER; idx++)
+    {
+        pBuffers[idx] = U3VBufPool_Alloc();
+        aligned = (pBuffers[idx] != NULL) && U3V_BUF_IS_DCACHE_ALIGNED(pBuffers[idx]) && aligned;
+        for (uint32_t prevIdx = 0U; prevIdx < idx; prevIdx++)
+        {
+            uintptr_t distance = ((uintptr_t)pBuffers[idx] > (uintptr_t)pBuffers[prevIdx]) ?
+                                 ((uintptr_t)pBuffers[idx] - (uintptr_t)pBuffers[prevIdx]) :
+                                 ((uintptr_t)pBuffers[prevIdx] - (uintptr_t)pBuffers[idx]);
+            disjoint = (distance >= U3V_BUF_POOL_BLOCK_SIZE) && disjoint;
+        }
+    }
+    check(aligned, "every pool buffer starts on a cache line");
+    check(disjoint, "the pool buffers do not overlap");
+    check((U3VBufPool_Alloc() == NULL) && (U3VBufPool_GetFreeBlocksNumber() == 0U), "an exhausted pool returns NULL");
+
+    U3VBufPool_Free(foreignBuffer);
+    check(U3VBufPool_GetFreeBlocksNumber() == 0U, "a buffer out of the pool is not freed");
+    U3VBufPool_Free(pBuffers[0]);
+    check((U3VBufPool_GetFreeBlocksNumber() == 1U) && (U3VBufPool_Alloc() == pBuffers[0]), "a freed buffer is reused");
+
+    /* the default configuration places the pool in cacheable SRAM */
+    check(U3VBufPool_IsCacheMaintenanceNeeded(pBuffers[0]) == !U3V_BUF_POOL_NONCACHEABLE,
+          "the pool buffers are maintained unless the pool is non-cacheable");
+
+    HostCache_Reset();
+    U3VBufPool_PrepareForDeviceWrite(pBuffers[0], U3V_PAYLD_BLOCK_MAX_SIZE);
+    pRecord = HostCache_GetRecord(0U);
+    check((HostCache_GetRecordsNumber() == 1U) && (pRecord->operation == HOST_CACHE_INVALIDATE) &&
+          (pRecord->address == (uintptr_t)pBuffers[0]) && (pRecord->size == (int32_t)U3V_PAYLD_BLOCK_MAX_SIZE),
+          "a transfer is prepared by invalidating the whole buffer");
+
+    HostCache_Reset();
+    U3VBufPool_CompleteDeviceWrite(pBuffers[0], 1000U);
+    pRecord = HostCache_GetRecord(0U);
+    check((HostCache_GetRecordsNumber() == 1U) && (pRecord->operation == HOST_CACHE_INVALIDATE) &&
+          (pRecord->address == (uintptr_t)pBuffers[0]) && (pRecord->size == 1024),
+          "a completed transfer invalidates the received bytes rounded up to whole lines");
+
+    HostCache_Reset();
+    U3VBufPool_PrepareForDeviceWrite(NULL, U3V_PAYLD_BLOCK_MAX_SIZE);
+    U3VBufPool_CompleteDeviceWrite(pBuffers[0], 0U);
+    check(HostCache_GetRecordsNumber() == 0U, "no maintenance is done without a buffer or received bytes");
+
+    HostCache_Reset();
+    for (size_t size = 1U; size <= U3V_PAYLD_BLOCK_MAX_SIZE; size += 7U)
+    {
+        U3VBufPool_CompleteDeviceWrite(pBuffers[1], size);
+    }
+    check((HostCache_GetRecordsNumber() > 0U) && (HostCache_GetMisalignedNumber() == 0U),
+          "the maintenance covers whole cache lines for every received size");
+
+    for (uint32_t idx = 0U; idx < U3V_BUF_POOL_BLOCKS_NUMBER; idx++)
+    {
+        U3VBufPool_Free(pBuffers[idx]);
+    }
+    check(U3VBufPool_GetFreeBlocksNumber() == U3V_BUF_POOL_BLOCKS_NUMBER, "all the buffers are returned to the pool");
+}
+
+
+static void checkWriteBehind(T_HostBlockFile *pFile)
+{
+    /* a ring of 4 frames: the oldest frames are overwritten */
+    const uint32_t lbaCount = (uint32_t)(4U * ((HOST_FRAME_SIZE + U3V_WRITE_BEHIND_BUFFER_SIZE) / HOST_BLOCK_SIZE));
+    T_U3VWriteBehindBlockDevice device = hostBlockDevice(pFile, lbaCount);
+    T_U3VWriteBehindBlockDevice badDevice = device;
+    T_U3VWriteBehindStats stats;
+    bool stored = true;
+    bool pushed = true;
+    bool onlyCleaned = true;
+
+    HostCache_Reset();
+    badDevice.blockSize = 384U;
+    check(U3VWriteBehind_Initialize(&badDevice) == U3V_WB_RESULT_INVALID_PARAMETER,
+          "a block size which does not divide the buffer size is refused");
+    check(U3VWriteBehind_Initialize(&device) == U3V_WB_RESULT_SUCCESS, "the file-backed block device is accepted");
+
+    for (uint32_t frameId = 1U; frameId <= 6U; frameId++)
+    {
+        pushed = pushFrame(frameId, HOST_FRAME_SIZE, true) && pushed;
+    }
+    U3VWriteBehind_Tasks();
+    for (uint32_t frameId = 4U; frameId <= 6U; frameId++)
+    {
+        stored = isFrameStored(pFile, lbaCount, frameId, HOST_FRAME_SIZE) && stored;
+    }
+    U3VWriteBehind_GetStats(&stats);
+    check(pushed, "every payload block of 6 frames is accepted with backpressure");
+    check(stats.bytesAccepted == (6U * HOST_FRAME_SIZE), "the accepted bytes are counted");
+    check(stats.framesDurable == 6U, "6 frames are durable");
+    check(stored, "the last 3 frames are read back from the ring");
+    check(!U3VWriteBehind_IsFrameDurable(1U) && (stats.framesOverwritten >= 2U),
+          "the frames overwritten by the ring are no longer durable");
+    for (uint32_t idx = 0U; HostCache_GetRecord(idx) != NULL; idx++)
+    {
+        onlyCleaned = (HostCache_GetRecord(idx)->operation == HOST_CACHE_CLEAN) && onlyCleaned;
+    }
+    check((HostCache_GetRecordsNumber() > 0U) && onlyCleaned && (HostCache_GetMisalignedNumber() == 0U),
+          "the buffers written to the device are cleaned in whole cache lines");
+
+    /* frames closed without their storage task run hold the frame slots */
+    U3VWriteBehind_Initialize(&device);
+    for (uint32_t frameId = 1U; frameId <= U3V_WRITE_BEHIND_FRAMES_NUMBER; frameId++)
+    {
+        U3VWriteBehind_BeginFrame(frameId);
+        U3VWriteBehind_EndFrame();
+    }
+    check(U3VWriteBehind_BeginFrame(100U) == U3V_WB_RESULT_NO_SPACE, "a frame is rejected when no frame slot is free");
+    check(U3VWriteBehind_PushBlock(payloadBlock, 1024U) == U3V_WB_RESULT_NO_SPACE,
+          "a block of a rejected frame is rejected for lack of space");
+    check(U3VWriteBehind_EndFrame() == U3V_WB_RESULT_NO_SPACE, "the end of a rejected frame is rejected for lack of space");
+    U3VWriteBehind_GetStats(&stats);
+    check((stats.framesRejected == 1U) && (stats.blocksRejected == 1U) && (stats.bytesAccepted == 0U),
+          "the rejected frame and its block are counted");
+    check(U3VWriteBehind_PushBlock(payloadBlock, 1024U) == U3V_WB_RESULT_INVALID_PARAMETER,
+          "a block out of a frame is an invalid parameter");
+    U3VWriteBehind_Tasks();
+    check(U3VWriteBehind_BeginFrame(101U) == U3V_WB_RESULT_SUCCESS, "a frame is accepted once the slots are durable");
+    check(U3VWriteBehind_PushBlock(payloadBlock, 1024U) == U3V_WB_RESULT_SUCCESS, "its blocks are accepted");
+}
+
+
+/**
+ * Measures the rate at which frames become durable on the file, with and without a sync after each write.
+ */
+static void benchmarkWriteBehind(T_HostBlockFile *pFile, bool sync)
+{
+    const uint32_t framesNumber = 128U;
+    /* a ring of 64 MiB */
+    const uint32_t lbaCount = (uint32_t)((64U * 1024U * 1024U) / HOST_BLOCK_SIZE);
+    T_U3VWriteBehindBlockDevice device = hostBlockDevice(pFile, lbaCount);
+    T_U3VWriteBehindStats stats;
+    double start;
+    double seconds;
+
+    pFile->sync = sync;
+    pFile->writes = 0U;
+    U3VWriteBehind_Initialize(&device);
+    memset(payloadBlock, 0x5A, sizeof(payloadBlock));
+
+    start = getTimeSeconds();
+    for (uint32_t frameId = 1U; frameId <= framesNumber; frameId++)
+    {
+        (void)pushFrame(frameId, HOST_FRAME_SIZE, false);
+    }
+    U3VWriteBehind_Tasks();
+    seconds = getTimeSeconds() - start;
+
+    U3VWriteBehind_GetStats(&stats);
+    printf("%-28s %8u %10u %10.1f %10.1f %12.1f\n", sync ? "fdatasync after each write" : "no sync (page cache)",
+           stats.framesDurable, pFile->writes, seconds * 1e3, (double)stats.blocksWritten * HOST_BLOCK_SIZE / seconds / 1e6,
+           (double)stats.framesDurable / seconds);
+}
+
+
+/**
+ * Measures the pixels/s of a full frame pixel format kernel, the best of several runs.
+ */
+static double measurePixelsPerSecond(int kernel)
+{
+    const uint32_t runsNumber = 10U;
+    T_U3VPixFmtUnpackCtx unpackCtx;
+    double bestSeconds = 0.0;
+    double start;
+    double seconds;
+
+    for (uint32_t run = 0U; run < runsNumber; run++)
+    {
+        start = getTimeSeconds();
+        switch (kernel)
+        {
+            case 0:
+                memset(&unpackCtx, 0, sizeof(unpackCtx));
+                for (size_t offset = 0U; offset < sizeof(packed12pImage); offset += U3V_PAYLD_BLOCK_MAX_SIZE)
+                {
+                    size_t size = sizeof(packed12pImage) - offset;
+
+                    size = (size < U3V_PAYLD_BLOCK_MAX_SIZE) ? size : U3V_PAYLD_BLOCK_MAX_SIZE;
+                    (void)U3VPixFmt_Unpack12pTo16Block(&unpackCtx, &packed12pImage[offset], size,
+                                                       &unpacked16Image[(offset * 2U) / 3U]);
+                }
+                break;
+            case 1:
+                U3VPixFmt_Unpack12pTo8(packed12pImage, HOST_IMAGE_PIXELS, bayer8Image);
+                break;
+            case 2:
+            case 3:
+                (void)U3VPixFmt_BayerRG8ToRGB8Frame(bayer8Image, HOST_IMAGE_WIDTH, HOST_IMAGE_HEIGHT, (kernel == 3), rgb8Image);
+                break;
+            case 4:
+            case 5:
+                (void)U3VPixFmt_BayerRG12pToRGB8Frame(packed12pImage, HOST_IMAGE_WIDTH, HOST_IMAGE_HEIGHT, (kernel == 5),
+                                                      scratchRows, rgb8Image);
+                break;
+            default:
+                (void)U3VPixFmt_RGB8ToYUV420Frame(rgb8Image, HOST_IMAGE_WIDTH, HOST_IMAGE_HEIGHT, yuv420Image);
+                break;
+        }
+        seconds = getTimeSeconds() - start;
+        bestSeconds = ((run == 0U) || (seconds < bestSeconds)) ? seconds : bestSeconds;
+    }
+
+    return (double)HOST_IMAGE_PIXELS / bestSeconds;
+}
+
+
+static void hostErrorCallback(int errorId)
+{
+    if (errorId == (int)U3V_DRV_ERR_BRINGUP_BUDGET_EXCEEDED)
+    {
+        budgetErrorsNumber++;
+    }
+    else
+    {
+        otherErrorsNumber++;
+    }
+}
+
+
+/**
+ * Runs the driver task with its period until the camera is ready for image acquisition, at least once.
+ */
+static bool runDriverUntilReady(void)
+{
+    const uint32_t startMs = HostU3VCamera_GetTimeMs();
+
+    do
+    {
+        U3VCamDriver_Tasks();
+        HostU3VCamera_AdvanceMs(HOST_TASK_PERIOD_MS);
+    } while ((U3VCamDriver_GetCamState() != U3V_CAM_DRV_CAM_READY_TO_ACQ_IMG) &&
+             ((HostU3VCamera_GetTimeMs() - startMs) < HOST_BRINGUP_TIMEOUT_MS));
+
+    return (U3VCamDriver_GetCamState() == U3V_CAM_DRV_CAM_READY_TO_ACQ_IMG);
+}
+
+
+/**
+ * Checks that the states of a profile account for its whole time and for all the Control IF traffic of the camera
+ * since the given sample.
+ */
+static bool isProfileConsistent(const T_U3VAppBringUpProfile *pProfile, const T_U3VHostCtrlIfStats *pStartStats)
+{
+    T_U3VHostCtrlIfStats stats;
+    uint32_t durationMs = 0U;
+    uint32_t transactions = 0U;
+    uint32_t bytes = 0U;
+
+    for (uint32_t state = 0U; state <= (uint32_t)U3V_APP_STATE_ERROR; state++)
+    {
+        durationMs += pProfile->states[state].durationMs;
+        transactions += pProfile->states[state].ctrlIfTransactions;
+        bytes += pProfile->states[state].ctrlIfBytes;
+    }
+    U3VHost_GetCtrlIfStats(&stats);
+
+    return (durationMs == pProfile->totalDurationMs) && (transactions == (stats.transactions - pStartStats->transactions)) &&
+           (bytes == (stats.bytesMoved - pStartStats->bytesMoved));
+}
+
+
+/**
+ * Brings up the simulated camera with the driver from power up: a cold start to the startup user set, then a warm
+ * reconnect after a camera software reset, both within their budgets, then a cold start of a camera too slow for
+ * its budget.
+ */
+static void checkBringUp(void)
+{
+    const T_HostU3VCameraTiming slowCameraTiming = { .transactionMs = 1U, .presetLoadMs = U3V_BRINGUP_COLD_START_BUDGET_MS,
+                                                     .pixelFormatMs = 20U, .rebootMs = 2000U };
+    T_U3VHostCtrlIfStats startStats;
+    bool ready;
+
+    HostU3VCamera_Initialize(&hostCameraTiming, hostCameraPresets, (uint32_t)U3V_CAM_DRV_IMG_PRESET_DEFAULT);
+    U3VCamDriver_Initialize();
+    (void)U3VCamDriver_SetErrorCallback(hostErrorCallback);
+    budgetErrorsNumber = 0U;
+    otherErrorsNumber = 0U;
+
+    U3VHost_GetCtrlIfStats(&startStats);
+    HostU3VCamera_Attach();
+    ready = runDriverUntilReady();
+    (void)U3VCamDriver_GetBringUpProfile(&coldStartProfile);
+    check(ready && coldStartProfile.isComplete && !coldStartProfile.isWarmReconnect && (otherErrorsNumber == 0U),
+          "a cold start brings the camera up to ready for image acquisition");
+    check(isProfileConsistent(&coldStartProfile, &startStats),
+          "the cold start profile states add up to its time and to the Control IF traffic of the camera");
+    /* the preset is read, selected, loaded and read back, then its 3 registers are cached */
+    check((HostU3VCamera_GetPresetLoadsNumber() == 1U) &&
+          (coldStartProfile.states[U3V_APP_STATE_SETUP_IMG_PRESET].ctrlIfTransactions == 7U),
+          "the cold start loads the requested user set once, reads it back and caches it");
+    check((coldStartProfile.totalDurationMs <= U3V_BRINGUP_COLD_START_BUDGET_MS) && (budgetErrorsNumber == 0U),
+          "the cold start is within U3V_BRINGUP_COLD_START_BUDGET_MS");
+
+    /* the device reset is issued before the bring-up starts, so its traffic is not part of the profile */
+    (void)U3VCamDriver_CamSwReset();
+    U3VCamDriver_Tasks();
+    U3VHost_GetCtrlIfStats(&startStats);
+    ready = runDriverUntilReady();
+    (void)U3VCamDriver_GetBringUpProfile(&warmReconnectProfile);
+    check(ready && warmReconnectProfile.isComplete && warmReconnectProfile.isWarmReconnect && (otherErrorsNumber == 0U),
+          "a camera software reset is followed by a warm reconnect");
+    check(isProfileConsistent(&warmReconnectProfile, &startStats),
+          "the warm reconnect profile states add up to its time and to the Control IF traffic of the camera");
+    check((warmReconnectProfile.totalDurationMs <= U3V_BRINGUP_WARM_RECONNECT_BUDGET_MS) && (budgetErrorsNumber == 0U),
+          "the warm reconnect is within U3V_BRINGUP_WARM_RECONNECT_BUDGET_MS");
+
+    HostU3VCamera_Initialize(&slowCameraTiming, hostCameraPresets, (uint32_t)U3V_CAM_DRV_IMG_PRESET_DEFAULT);
+    U3VCamDriver_Initialize();
+    (void)U3VCamDriver_SetErrorCallback(hostErrorCallback);
+    budgetErrorsNumber = 0U;
+    HostU3VCamera_Attach();
+    ready = runDriverUntilReady();
+    check(ready && (budgetErrorsNumber == 1U),
+          "a cold start over its budget reports U3V_DRV_ERR_BRINGUP_BUDGET_EXCEEDED and completes");
+}
+
+
+/**
+ * Switches the image preset at runtime and runs the driver until the camera is ready again.
+ * @return the Control IF transactions of the switch, UINT32_MAX if the camera is not ready
+ */
+static uint32_t switchImgPreset(T_U3VCamDriverImagePreset preset)
+{
+    T_U3VHostCtrlIfStats startStats;
+    T_U3VHostCtrlIfStats stats;
+
+    U3VHost_GetCtrlIfStats(&startStats);
+    if ((U3VCamDriver_RequestImagePreset(preset) != U3V_CAM_DRV_OK) || !runDriverUntilReady() ||
+        (U3VCamDriver_GetCurrImagePreset() != preset))
+    {
+        return UINT32_MAX;
+    }
+    U3VHost_GetCtrlIfStats(&stats);
+
+    return stats.transactions - startStats.transactions;
+}
+
+
+/**
+ * Switches between the user sets at runtime: the first switch to a preset reads back its registers, later switches,
+ * including the first one back to the preset loaded at connection setup, use the cached values. A request back to
+ * the loaded preset cancels a pending switch.
+ */
+static void checkImgPresetSwitch(void)
+{
+    uint32_t firstSwitchTransactions;
+    uint32_t switchBackTransactions;
+    uint32_t cachedSwitchTransactions;
+    uint32_t presetLoads;
+    bool ready;
+
+    HostU3VCamera_Initialize(&hostCameraTiming, hostCameraPresets, (uint32_t)U3V_CAM_DRV_IMG_PRESET_DEFAULT);
+    U3VCamDriver_Initialize();
+    (void)U3VCamDriver_SetErrorCallback(hostErrorCallback);
+    otherErrorsNumber = 0U;
+    HostU3VCamera_Attach();
+    ready = runDriverUntilReady();
+
+    firstSwitchTransactions = switchImgPreset(U3V_CAM_DRV_IMG_PRESET_USER_SET_1);
+    switchBackTransactions = switchImgPreset(U3V_CAM_DRV_IMG_PRESET_USER_SET_0);
+    cachedSwitchTransactions = switchImgPreset(U3V_CAM_DRV_IMG_PRESET_USER_SET_1);
+    check(ready && (firstSwitchTransactions != UINT32_MAX) && (switchBackTransactions != UINT32_MAX) &&
+          (cachedSwitchTransactions != UINT32_MAX) && (otherErrorsNumber == 0U),
+          "the camera switches between the user sets at runtime");
+    check(cachedSwitchTransactions < firstSwitchTransactions,
+          "a switch to a cached preset does not read back its registers");
+    check(switchBackTransactions == cachedSwitchTransactions,
+          "the preset loaded at connection setup is cached for the first switch back to it");
+
+    presetLoads = HostU3VCamera_GetPresetLoadsNumber();
+    (void)U3VCamDriver_RequestImagePreset(U3V_CAM_DRV_IMG_PRESET_USER_SET_0);
+    (void)U3VCamDriver_RequestImagePreset(U3V_CAM_DRV_IMG_PRESET_USER_SET_1);
+    U3VCamDriver_Tasks();
+    U3VCamDriver_Tasks();
+    check((U3VCamDriver_GetCamState() == U3V_CAM_DRV_CAM_READY_TO_ACQ_IMG) &&
+          (HostU3VCamera_GetPresetLoadsNumber() == presetLoads) &&
+          (U3VCamDriver_GetCurrImagePreset() == U3V_CAM_DRV_IMG_PRESET_USER_SET_1),
+          "a request back to the loaded preset cancels the pending switch");
+}
+
+
+static void printBringUpProfile(const char *title, const T_U3VAppBringUpProfile *pProfile)
+{
+    static const char *const stateNames[U3V_APP_STATE_ERROR + 1] = {
+        [U3V_APP_STATE_OPEN_DEVICE]                     = "OPEN_DEVICE",
+        [U3V_APP_STATE_SETUP_U3V_CONTROL_IF]            = "SETUP_U3V_CONTROL_IF",
+        [U3V_APP_STATE_READ_DEVICE_TEXT_DESCR]          = "READ_DEVICE_TEXT_DESCR",
+        [U3V_APP_STATE_GET_STREAM_CAPABILITIES]         = "GET_STREAM_CAPABILITIES",
+        [U3V_APP_STATE_SETUP_IMG_PRESET]                = "SETUP_IMG_PRESET",
+        [U3V_APP_STATE_SETUP_PIXEL_FORMAT]              = "SETUP_PIXEL_FORMAT",
+        [U3V_APP_STATE_SETUP_ACQUISITION_MODE]          = "SETUP_ACQUISITION_MODE",
+        [U3V_APP_STATE_SETUP_U3V_STREAM_IF]             = "SETUP_U3V_STREAM_IF",
+        [U3V_APP_STATE_GET_CAM_TEMPERATURE]             = "GET_CAM_TEMPERATURE",
+        [U3V_APP_STATE_SWITCH_IMG_PRESET]               = "SWITCH_IMG_PRESET",
+        [U3V_APP_STATE_SETUP_TRIGGER_MODE]              = "SETUP_TRIGGER_MODE",
+        [U3V_APP_STATE_ERROR]                           = "ERROR",
+    };
+
+    printf("\n%s, %u ms\n", title, pProfile->totalDurationMs);
+    printf("%-28s %8s %8s %14s %10s\n", "state", "visits", "ms", "transactions", "bytes");
+    for (uint32_t state = 0U; state <= (uint32_t)U3V_APP_STATE_ERROR; state++)
+    {
+        const T_U3VAppStateProfile *pState = &pProfile->states[state];
+
+        if (pState->visits > 0U)
+        {
+            printf("%-28s %8u %8u %14u %10u\n", (stateNames[state] != NULL) ? stateNames[state] : "?", pState->visits,
+                   pState->durationMs, pState->ctrlIfTransactions, pState->ctrlIfBytes);
+        }
+    }
+}
+
+
+static void benchmarkPixelFormat(void)
+{
+    static const char *const kernelNames[] = {
+        "Mono12p unpack, payload blocks",
+        "BayerRG12p to 8-bit",
+        "BayerRG8 to RGB8 nearest",
+        "BayerRG8 to RGB8 bilinear",
+        "BayerRG12p to RGB8 nearest",
+        "BayerRG12p to RGB8 bilinear",
+        "RGB8 to YUV420",
+    };
+    uint32_t randomState = 1U;
+
+    for (size_t idx = 0U; idx < sizeof(packed12pImage); idx++)
+    {
+        packed12pImage[idx] = (uint8_t)nextRandom(&randomState);
+    }
+    U3VPixFmt_Unpack12pTo8(packed12pImage, HOST_IMAGE_PIXELS, bayer8Image);
+    (void)U3VPixFmt_BayerRG8ToRGB8Frame(bayer8Image, HOST_IMAGE_WIDTH, HOST_IMAGE_HEIGHT, true, rgb8Image);
+
+    printf("\nPixel format kernels, %ux%u frames\n", (unsigned)HOST_IMAGE_WIDTH, (unsigned)HOST_IMAGE_HEIGHT);
+    printf("%-32s %12s %10s\n", "kernel", "Mpixels/s", "frames/s");
+    for (int kernel = 0; kernel < (int)(sizeof(kernelNames) / sizeof(kernelNames[0])); kernel++)
+    {
+        double pixelsPerSecond = measurePixelsPerSecond(kernel);
+
+        printf("%-32s %12.1f %10.1f\n", kernelNames[kernel], pixelsPerSecond / 1e6, pixelsPerSecond / (double)HOST_IMAGE_PIXELS);
+    }
+}
+
+
+int main(int argc, char **argv)
+{
+    const bool benchmark = (argc > 1) && (strcmp(argv[1], "--benchmark") == 0);
+    const char *path = (benchmark && (argc > 2)) ? argv[2] : NULL;
+    char tempPath[] = "/tmp/U3VCamHostRunnerXXXXXX";
+    T_HostBlockFile file = { .fd = -1, .blockSize = HOST_BLOCK_SIZE, .sync = false, .writes = 0U };
+
+    file.fd = (path != NULL) ? open(path, O_RDWR | O_CREAT, 0644) : mkstemp(tempPath);
+    if (file.fd < 0)
+    {
+        perror("block device file");
+        return 1;
+    }
+    if (path == NULL)
+    {
+        unlink(tempPath);
+    }
+
+    checkBufPool();
+    checkPixelFormat();
+    checkWriteBehind(&file);
+    checkBringUp();
+    checkImgPresetSwitch();
+
+    printf("\n%u checks, %u failed\n", checksNumber, failedChecksNumber);
+
+    if (benchmark)
+    {
+        printBringUpProfile("Bring-up of the simulated camera, cold start", &coldStartProfile);
+        printBringUpProfile("Bring-up of the simulated camera, warm reconnect", &warmReconnectProfile);
+        benchmarkPixelFormat();
+        printf("\nWrite-behind to %s, %u x %u byte buffers, %u byte frames\n", (path != NULL) ? path : "a temporary file",
+               U3V_WRITE_BEHIND_BUFFERS_NUMBER, (unsigned)U3V_WRITE_BEHIND_BUFFER_SIZE, (unsigned)HOST_FRAME_SIZE);
+        printf("%-28s %8s %10s %10s %10s %12s\n", "device writes", "frames", "writes", "ms", "MB/s", "frames/s");
+        benchmarkWriteBehind(&file, false);
+        benchmarkWriteBehind(&file, true);
+    }
+
+    close(file.fd);
+
+    return (failedChecksNumber == 0U) ? 0 : 1;
+}
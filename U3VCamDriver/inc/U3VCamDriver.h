@@ -57,6 +57,18 @@ typedef enum
     U3V_CAM_DRV_IMG_PRESET_USER_SET_1
 } T_U3VCamDriverImagePreset;
 
+/**
+ * U3V Camera image acquisition trigger source.
+ * 
+ * Enum to specify the source of the trigger that starts the exposure of a
+ * frame, when the driver is armed for triggered acquisition.
+ */
+typedef enum
+{
+    U3V_CAM_DRV_TRIGGER_SRC_SOFTWARE,
+    U3V_CAM_DRV_TRIGGER_SRC_LINE0
+} T_U3VCamDriverTriggerSource;
+
 /**
  * U3V Camera text descriptor text datatype.
  * 
@@ -89,12 +101,17 @@ typedef enum
  * @note The 'payload data' packets arrive between the 
  * 'leader' and 'trailer' packets, carrying actual image
  * pixel data.
+ * @note The 'trailer data incomplete' event replaces the
+ * 'trailer' event when less image payload than expected
+ * has been received (truncated payload blocks). The image
+ * is incomplete and shall be discarded by the app.
  */
 typedef enum
 {
     U3V_CAM_DRV_IMG_LEADER_DATA = 1,
     U3V_CAM_DRV_IMG_PAYLOAD_DATA,
     U3V_CAM_DRV_IMG_TRAILER_DATA,
+    U3V_CAM_DRV_IMG_TRAILER_DATA_INCOMPLETE,
 } T_U3VCamDriverImageAcqPayloadEvent;
 
 /**
@@ -122,6 +139,11 @@ typedef enum
  * 		    	imageRequested = false;
  * 		    	break;
  *  
+ * 		    case U3V_CAM_DRV_IMG_TRAILER_DATA_INCOMPLETE:
+ *              // trailer packet received, image payload truncated, discard image
+ * 		    	imageRequested = false;
+ * 		    	break;
+ *  
  * 		    case U3V_CAM_DRV_IMG_PAYLOAD_DATA:
  * 		    	if (true == DRV_USART_WriteBuffer(usrtDrv, imageData, blockSize))
  * 		    	{
@@ -181,11 +203,15 @@ void U3VCamDriver_Tasks(void);
  * least the size of the image payload block size, which is defined  with the 
  * U3V_PAYLD_BLOCK_MAX_SIZE macro (is local). If the buffer size is allocated in 
  * runtime, the function U3VCamDriver_GetImagePayldMaxBlockSize may be used.
+ * The buffer is written by the USB DMA, so it must be aligned to a data cache
+ * line (U3V_DCACHE_LINE_SIZE), preferably allocated with U3VBufPool_Alloc 
+ * (U3VCam_BufPool.h). Cache maintenance is done by the driver for every block,
+ * unless the buffer is located in non-cacheable memory.
  * @param callback Callback to the app software to notify the app that an image 
  * payload block has been received.
  * @param imgDataBfr Buffer address where image payload block will be copied.
  * @return T_U3VCamDriverStatus Status of the driver that indicates the 
- * operability of the driver.
+ * operability of the driver. U3V_CAM_DRV_ERROR if the buffer is not aligned.
  */
 T_U3VCamDriverStatus U3VCamDriver_SetImagePayldTransfParams(T_U3VCamDriverPayloadEventCallback callback, void *imgDataBfr);
 
@@ -244,9 +270,12 @@ void U3VCamDriver_CancelImageAcqRequest(void);
  * ready state, implying that it is ready to start an image acquisition. After 
  * an image is requested, the state switches to U3V_CAM_DRV_CAM_IN_IMG_TRANSF 
  * until the image is fully transferred. The state U3V_CAM_DRV_CAM_FAILURE 
- * implies that there was a failure detected during the configuration time 
- * (after the USB handshake). In that case, a power-reset of the camera supply 
- * can be a typical solution to the problem.
+ * implies that a step failed after the USB handshake. The driver then retries
+ * with a warm reconnect (camera software reset) up to 
+ * U3V_APP_RECOVERY_MAX_RETRIES times, a failed or stalled image transfer is 
+ * recovered without leaving U3V_CAM_DRV_CAM_IN_IMG_TRANSF. If the state stays
+ * U3V_CAM_DRV_CAM_FAILURE after the retries, a power-reset of the camera 
+ * supply can be a typical solution to the problem.
  */
 T_U3VCamDriverCamState U3VCamDriver_GetCamState(void);
 
@@ -306,10 +335,14 @@ T_U3VCamDriverStatus U3VCamDriver_CamSwReset(void);
  * @param presetRequest image sensor config set selection (enum).
  * @return T_U3VCamDriverStatus Status of the driver that indicates the 
  * operability of the driver.
- * @warning A requested preset will be applied during camera boot time and
- * not while the camera is in ready for image acquition state, therefore it is
- * recommended to call this function prior to powering on the camera, else the 
- * selected set will be applied in the next session.
+ * @note A preset requested while the camera is connected is applied the next
+ * time the driver is ready for image acquisition, before any pending image 
+ * acquisition request. The switch is differential: only the setup steps whose
+ * registers (pixel format, acquisition mode, payload size) were changed by the
+ * preset are repeated, so switching between presets with the same image 
+ * format costs just the preset select and load writes. Requesting the preset 
+ * that is already loaded cancels a switch that has not been applied yet.
+ * @return U3V_CAM_DRV_ERROR if the preset value is invalid.
  */
 T_U3VCamDriverStatus U3VCamDriver_RequestImagePreset(T_U3VCamDriverImagePreset presetRequest);
 
@@ -321,9 +354,8 @@ T_U3VCamDriverStatus U3VCamDriver_RequestImagePreset(T_U3VCamDriverImagePreset p
  * @note It may be (optionally) used prior to U3VCamDriver_RequestImagePreset 
  * to avoid unecessary requesting an already active set.
  * @warning It returns the last requested value and not the current preset of 
- * the camera, which may differ if the request for a new image preset is placed
- * while the camera is already power on. The requested preset is applied during 
- * configuration time after a camera power reset.
+ * the camera, which may differ until the requested preset has been applied 
+ * (see U3VCamDriver_RequestImagePreset).
  * @return T_U3VCamDriverImagePreset 
  */
 T_U3VCamDriverImagePreset U3VCamDriver_GetCurrImagePreset(void);
@@ -344,6 +376,67 @@ T_U3VCamDriverImagePreset U3VCamDriver_GetCurrImagePreset(void);
  */
 size_t U3VCamDriver_GetImagePayldMaxBlockSize(void);
 
+/**
+ * Arm the triggered image acquisition.
+ * 
+ * This function requests the pre-armed acquisition mode. When the driver is 
+ * ready for image acquisition, it enables the camera trigger mode with the 
+ * selected source, enables the stream interface, starts the acquisition and 
+ * queues the first payload transfer, so a trigger produces a frame without 
+ * waiting for a U3VCamDriver_Tasks cycle. The leader block is delivered to 
+ * the payload callback as with U3VCamDriver_RequestNewImagePayloadBlock, 
+ * following blocks are requested the same way. After each trailer the driver
+ * re-arms automatically until U3VCamDriver_DisarmTrigger is called.
+ * @param source trigger source
+ * @return T_U3VCamDriverStatus U3V_CAM_DRV_ERROR if the transfer parameters
+ * are not set, or the camera model does not support triggering.
+ * @note While armed, the camera state is U3V_CAM_DRV_CAM_IN_IMG_TRANSF.
+ */
+T_U3VCamDriverStatus U3VCamDriver_ArmTrigger(T_U3VCamDriverTriggerSource source);
+
+/**
+ * Disarm the triggered image acquisition.
+ * 
+ * This function requests U3VCamDriver_Tasks to stop a pending armed 
+ * acquisition (if no frame transfer is in progress) and to disable the camera
+ * trigger mode. A frame in transfer is completed before disarming.
+ * @return T_U3VCamDriverStatus
+ */
+T_U3VCamDriverStatus U3VCamDriver_DisarmTrigger(void);
+
+/**
+ * Issue a software trigger.
+ * 
+ * This function writes the camera software trigger register directly from the
+ * caller context and timestamps the trigger for the latency measurement.
+ * @return T_U3VCamDriverStatus U3V_CAM_DRV_ERROR if the driver is not armed 
+ * with the software trigger source or the write fails.
+ * @warning Blocking call (Control Interface transaction), do not call from an
+ * interrupt.
+ */
+T_U3VCamDriverStatus U3VCamDriver_SoftwareTrigger(void);
+
+/**
+ * Notify a hardware trigger.
+ * 
+ * This function shall be called from the interrupt of the GPIO that drives the
+ * camera trigger line (or right after driving it), to timestamp the trigger
+ * for the latency measurement. It is ignored unless the trigger is armed with
+ * the U3V_CAM_DRV_TRIGGER_SRC_LINE0 source and no frame is in transfer.
+ * @note ISR safe.
+ */
+void U3VCamDriver_NotifyHwTrigger(void);
+
+/**
+ * Get the last trigger to leader latency.
+ * 
+ * @param latencyUs time in microseconds from the last trigger to the reception
+ * of the leader block of the triggered frame (see U3V_GET_TIMESTAMP_US).
+ * @return T_U3VCamDriverStatus U3V_CAM_DRV_ERROR if no triggered frame has 
+ * been received yet.
+ */
+T_U3VCamDriverStatus U3VCamDriver_GetTriggerLatency(uint32_t *latencyUs);
+
 
 #ifdef __cplusplus
 }
@@ -45,6 +45,9 @@ typedef enum
     U3V_APP_STATE_READY_TO_START_IMG_ACQUISITION,
     U3V_APP_STATE_WAIT_TO_ACQUIRE_IMAGE,
     U3V_APP_STATE_STOP_IMAGE_ACQ,
+    U3V_APP_STATE_SWITCH_IMG_PRESET,
+    U3V_APP_STATE_SETUP_TRIGGER_MODE,
+    U3V_APP_STATE_RECOVER_STREAM_IF,
     U3V_APP_STATE_ERROR
 } T_U3VAppState;
 
@@ -73,6 +76,21 @@ typedef struct
 	uint8_t     serialNumber[U3V_REG_SERIAL_NUMBER_SIZE];
 } T_U3VAppDevTextDescr;
 
+/**
+ * U3V App image config preset cache entry struct.
+ * 
+ * Holds the camera register values observed right after a preset was loaded,
+ * so that a later switch to the same preset can decide which configuration
+ * steps must be repeated without reading them back from the camera.
+ */
+typedef struct
+{
+    bool                        isValid;
+    uint32_t                    pixelFormat;
+    uint32_t                    acquisitionMode;
+    uint32_t                    payloadSize;
+} T_U3VAppImagePresetCache;
+
 /**
  * U3V App image config preset load struct.
  * 
@@ -81,8 +99,130 @@ typedef struct
 {
     uint32_t                    regVal;
     T_U3VCamDriverImagePreset   reqstdPreset;
+    bool                        switchPending;
+    T_U3VAppImagePresetCache    cache[U3V_CAM_DRV_IMG_PRESET_USER_SET_1 + 1];
 } T_U3VAppImagePresetLoad;
 
+/**
+ * U3V App triggered acquisition struct.
+ * 
+ */
+typedef struct
+{
+    volatile bool                   armRequested;
+    volatile bool                   disarmRequested;
+    bool                            isArmed;
+    T_U3VCamDriverTriggerSource     source;
+    volatile bool                   isTriggered;
+    volatile uint32_t               triggerTimeUs;
+    bool                            latencyIsValid;
+    uint32_t                        lastLatencyUs;
+} T_U3VAppTrigger;
+
+/**
+ * U3V App state profile struct.
+ * 
+ * Time spent and Control Interface traffic issued in an App state during the
+ * bring-up of a device. States visited more than once are accumulated.
+ */
+typedef struct
+{
+    uint32_t                    visits;
+    uint32_t                    durationMs;
+    uint32_t                    ctrlIfTransactions;
+    uint32_t                    ctrlIfBytes;
+} T_U3VAppStateProfile;
+
+/**
+ * U3V App bring-up profile struct.
+ * 
+ * Profile of the last device bring-up, from device attach to ready for image
+ * acquisition.
+ */
+typedef struct
+{
+    bool                        isComplete;
+    bool                        isWarmReconnect;
+    uint32_t                    totalDurationMs;
+    T_U3VAppStateProfile        states[U3V_APP_STATE_ERROR + 1];
+} T_U3VAppBringUpProfile;
+
+/**
+ * U3V App bring-up profiler struct.
+ * 
+ */
+typedef struct
+{
+    bool                        isActive;
+    uint32_t                    bringUpCount;
+    uint32_t                    startMs;
+    uint32_t                    stateEntryMs;
+    T_U3VHostCtrlIfStats        stateEntryStats;
+    T_U3VAppBringUpProfile      lastProfile;
+} T_U3VAppProfiler;
+
+/**
+ * U3V App fault type.
+ * 
+ * Faults detected by the U3V App and handled by its recovery paths.
+ */
+typedef enum
+{
+    U3V_APP_FAULT_STREAM_STALL,         /* stalled image payload transfer: pipe halt clear and stream re-arm */
+    U3V_APP_FAULT_STREAM_TRANSFER,      /* failed image payload transfer: stream re-arm */
+    U3V_APP_FAULT_PAYLOAD_TRUNCATED,    /* image shorter than the payload size: frame dropped */
+    U3V_APP_FAULT_STEP_FAIL,            /* failed App step (e.g. Control IF NACK or timeout): warm reconnect */
+    U3V_APP_FAULT_DETACH,               /* device detached while connected: new bring-up on attach */
+    U3V_APP_FAULT_TYPES_NUMBER
+} T_U3VAppFaultType;
+
+/**
+ * U3V App fault recovery statistics struct.
+ * 
+ * Statistics of one fault type since power up. The mean time to recover is 
+ * totalRecoveryMs / recoveries.
+ */
+typedef struct
+{
+    uint32_t                    faults;
+    uint32_t                    recoveries;
+    uint32_t                    framesLost;
+    uint32_t                    totalRecoveryMs;
+    uint32_t                    maxRecoveryMs;
+} T_U3VAppFaultStats;
+
+/**
+ * U3V App recovery statistics struct.
+ * 
+ */
+typedef struct
+{
+    T_U3VAppFaultStats          fault[U3V_APP_FAULT_TYPES_NUMBER];
+} T_U3VAppRecoveryStats;
+
+/**
+ * U3V App recovery struct.
+ * 
+ * A recovery starts on the first detected fault and completes when the App is
+ * ready for image acquisition again.
+ */
+typedef struct
+{
+    bool                        isActive;
+    T_U3VAppFaultType           activeFault;
+    uint32_t                    startMs;
+    uint32_t                    retries;
+    bool                        retriesExhausted;
+    T_U3VAppState               failedState;
+    volatile bool               streamFault;
+    volatile T_U3VHostResult    streamFaultResult;
+    bool                        haltClearRequested;
+    uint32_t                    haltClearReqMs;
+    volatile bool               haltClearDone;
+    uint32_t                    frameBytes;
+    T_U3VAppRecoveryStats       stats;
+} T_U3VAppRecovery;
+
 /**
  * U3V App data struct.
  * 
@@ -108,6 +248,9 @@ typedef struct
     T_U3VCamDriverPayloadEventCallback  appImgEvtCbk;
     T_U3VCamDriverErrorCallback         appErrorCbk;
     void                                *appImgDataBfr;
+    T_U3VAppTrigger                     trigger;
+    T_U3VAppProfiler                    profiler;
+    T_U3VAppRecovery                    recovery;
 } T_U3VAppData;
 
 /**
@@ -134,7 +277,12 @@ typedef enum
     U3V_DRV_ERR_START_IMG_ACQ_FAIL,
     U3V_DRV_ERR_START_IMG_TRANSF_FAIL,
     U3V_DRV_ERR_IMG_TRANSF_STATE_FAIL,
-    U3V_DRV_ERR_STOP_IMG_ACQ_FAIL
+    U3V_DRV_ERR_STOP_IMG_ACQ_FAIL,
+    U3V_DRV_ERR_BRINGUP_BUDGET_EXCEEDED,
+    U3V_DRV_ERR_SETUP_TRIGGER_FAIL,
+    U3V_DRV_ERR_ARM_TRIGGER_FAIL,
+    U3V_DRV_ERR_RECOVER_STREAM_IF_FAIL,
+    U3V_DRV_ERR_RECOVERY_RETRIES_EXHAUSTED
 } T_U3VCamDriverErrorID;
 
 /**
@@ -144,6 +292,31 @@ typedef enum
  */
 T_U3VCamDriverStatus U3VCamDriver_SetErrorCallback(T_U3VCamDriverErrorCallback callback);
 
+/**
+ * Get the profile of the last camera bring-up.
+ * 
+ * The profile holds, for every App state, the time spent and the Control
+ * Interface transactions and bytes issued from device attach until the 
+ * driver was ready for image acquisition, to find which states dominate the
+ * cold start or warm reconnect time.
+ * @param pProfile destination of the profile copy
+ * @return The driver status, which indicates failure if not U3V_CAM_DRV_OK
+ * @note pProfile->isComplete is false while a bring-up is in progress or if
+ * no device has been attached yet.
+ */
+T_U3VCamDriverStatus U3VCamDriver_GetBringUpProfile(T_U3VAppBringUpProfile *pProfile);
+
+/**
+ * Get the fault recovery statistics.
+ * 
+ * For every fault type, the number of faults detected, of completed 
+ * recoveries, the image frames lost and the time to recover (from fault 
+ * detection until the driver was ready for image acquisition again).
+ * @param pStats destination of the statistics copy
+ * @return The driver status, which indicates failure if not U3V_CAM_DRV_OK
+ */
+T_U3VCamDriverStatus U3VCamDriver_GetRecoveryStats(T_U3VAppRecoveryStats *pStats);
+
 
 #ifdef __cplusplus
 }
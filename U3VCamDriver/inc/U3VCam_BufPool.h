@@ -0,0 +1,98 @@
+#pragma once
+
+#include "U3VCam_Config.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+
+/**
+ * U3V buffer pool block size.
+ *
+ * Size in bytes of each pool buffer, U3V_PAYLD_BLOCK_MAX_SIZE rounded up to a
+ * whole number of data cache lines.
+ */
+#define U3V_BUF_POOL_BLOCK_SIZE     (((U3V_PAYLD_BLOCK_MAX_SIZE + U3V_DCACHE_LINE_SIZE - 1U) / U3V_DCACHE_LINE_SIZE) * U3V_DCACHE_LINE_SIZE)
+
+/**
+ * U3V buffer alignment check.
+ *
+ * True when the address is aligned to a data cache line boundary.
+ */
+#define U3V_BUF_IS_DCACHE_ALIGNED(addr)     ((((uintptr_t)(addr)) & (U3V_DCACHE_LINE_SIZE - 1U)) == 0U)
+
+
+/*******************************************************************************
+* Function declarations
+*******************************************************************************/
+
+/**
+ * U3V buffer pool allocate.
+ *
+ * Allocates an image payload buffer from the static pool. The buffer is
+ * aligned to a data cache line and U3V_BUF_POOL_BLOCK_SIZE long, so it may be
+ * passed to U3VCamDriver_SetImagePayldTransfParams.
+ * @return void* Pointer to the buffer or NULL if the pool is exhausted.
+ * @note Not reentrant, call from a single task context.
+ */
+void *U3VBufPool_Alloc(void);
+
+/**
+ * U3V buffer pool free.
+ *
+ * Returns a buffer previously allocated with U3VBufPool_Alloc to the pool.
+ * @param pBuffer
+ * @note Pointers that do not belong to the pool are ignored.
+ */
+void U3VBufPool_Free(void *pBuffer);
+
+/**
+ * U3V buffer pool get free blocks number.
+ *
+ * @return uint32_t Number of pool buffers available for allocation.
+ */
+uint32_t U3VBufPool_GetFreeBlocksNumber(void);
+
+/**
+ * U3V buffer cache maintenance check.
+ *
+ * Checks if a buffer is located in cacheable memory, so that cache
+ * maintenance is needed around the DMA transfers writing to it. Pool buffers
+ * placed in a non-cacheable section and buffers in DTCM need no maintenance.
+ * @param pBuffer
+ * @return true if cache maintenance is needed
+ */
+bool U3VBufPool_IsCacheMaintenanceNeeded(const void *pBuffer);
+
+/**
+ * U3V buffer prepare for device write.
+ *
+ * Shall be called before a USB IN (device to host) transfer is queued on the
+ * buffer. Invalidates the cache lines of the buffer, so that no dirty line is
+ * evicted over the data written by the DMA during the transfer.
+ * @param pBuffer line aligned buffer
+ * @param size size of the transfer in bytes
+ */
+void U3VBufPool_PrepareForDeviceWrite(void *pBuffer, size_t size);
+
+/**
+ * U3V buffer complete device write.
+ *
+ * Shall be called when a USB IN transfer on the buffer is complete, before the
+ * CPU reads the received data. Invalidates the cache lines of the received
+ * bytes, dropping lines that were speculatively refilled during the transfer.
+ * @param pBuffer line aligned buffer
+ * @param size received size in bytes
+ */
+void U3VBufPool_CompleteDeviceWrite(void *pBuffer, size_t size);
+
+
+#ifdef __cplusplus
+}
+#endif //__cplusplus
+
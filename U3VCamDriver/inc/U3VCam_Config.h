@@ -36,6 +36,10 @@ extern "C" {
  * for the get/set of values on registers, check manifest document for each.
  * When no conversion is necessary simpy use 1:1 conversion macros, this means
  * that the integer value will be assigned as a full 32bit value on register.
+ * @note U3V_CAM_CFG_PIXEL_FORMAT_SEL may be set to a raw format (e.g. 
+ * U3V_PFNC_BayerRG8 or U3V_PFNC_BayerRG12p) to reduce the image payload size
+ * to 1/3 or 1/2 of RGB8, when the conversion is done on the MCU with the
+ * kernels provided by U3VCam_PixelFormat.h.
  */
 /*******************************************************************************
  * FLIR Chameleon3 CM3-U3-13S2C-CS
@@ -52,6 +56,9 @@ extern "C" {
     #define U3V_CAM_CFG_ACQ_STOP_REG_ADR            (UINT64_C(0x0614))          /* AcquisitionStop_Reg */
     #define U3V_CAM_CFG_PIXEL_FORMAT_REG_ADR        (UINT64_C(0x4070))          /* ColorCodingID_Reg */
     #define U3V_CAM_CFG_PAYLOAD_SIZE_REG_ADR        (UINT64_C(0x5410))          /* PayloadSizeVal_Reg */
+    #define U3V_CAM_CFG_TRIGGER_MODE_REG_ADR        (UINT64_C(0x0830))          /* TriggerMode_Reg (IIDC TRIGGER_MODE) */
+    #define U3V_CAM_CFG_TRIGGER_SOFTWARE_REG_ADR    (UINT64_C(0x062C))          /* SoftwareTrigger_Reg (IIDC SOFTWARE_TRIGGER) */
+    #define U3V_CAM_CFG_TRIGGER_SUPPORTED           (true)                      /* trigger registers are mapped */
     #define U3V_CAM_CFG_ACQ_MODE_SEL                (UINT32_C(0x1))             /* 0 = CONTINUOUS / 1 = SINGLE_FRAME / 2 = MULTI_FRAME */
     #define U3V_CAM_CFG_PIXEL_FORMAT_SEL            (UINT32_C(0x4))             /* 4 = 0x02180014 = U3V_PFNC_RGB8 in PixelFormatCtrlVal_Int formula */
     #define U3V_DEVICE_RESET_CMD                    (UINT32_C(0x1))             /* 1 = reset true */
@@ -59,6 +66,10 @@ extern "C" {
     #define U3V_ACQUISITION_STOP_CMD                (UINT32_C(0x0))             /* 0 = acq stop true */
     #define U3V_SI_CTRL_ENABLE_CMD                  (UINT32_C(0x1))             /* 1 = SI control enable true */
     #define U3V_SI_CTRL_DISABLE_CMD                 (UINT32_C(0x0))             /* 1 = SI control disable true */
+    #define U3V_TRIGGER_MODE_CMD(enable, source)    ((((enable) & 0x1) << 25) | (((source) & 0x7) << 21)) /* ON_OFF bit 25, source bits 21 to 23, mode 0, polarity low */
+    #define U3V_TRIGGER_SOFTWARE_CMD                (UINT32_C(0x1))             /* 1 = software trigger */
+    #define U3V_CAM_TRIGGER_SOURCE_LINE0            (UINT32_C(0x0))             /* TriggerSource: Line0 / GPIO0 (0) */
+    #define U3V_CAM_TRIGGER_SOURCE_SOFTWARE         (UINT32_C(0x7))             /* TriggerSource: Software (7) */
     #define U3V_CAM_IMG_PRESET_DEFAULT_SET          (UINT32_C(0x0))             /* UserSetSelector: Default set (0) */
     #define U3V_CAM_IMG_PRESET_USER_SET_0           (UINT32_C(0x1))             /* UserSetSelector: User set 0 (1) */
     #define U3V_CAM_IMG_PRESET_USER_SET_1           (UINT32_C(0x2))             /* UserSetSelector: User set 1 (2) */
@@ -76,6 +87,8 @@ extern "C" {
     #define U3V_GET_PIXEL_FORMAT_CONV(val)          ((val & 0xFF000000) >> 24)  /* value is stored on high byte (bits 24 to 31) */
     #define U3V_SET_PIXEL_FORMAT_CONV(val)          ((val & 0x000000FF) << 24)  /* value is stored on high byte (bits 24 to 31) */
     #define U3V_GET_TEMPERATURE_CONV(val)           (((float)(val & 0x00000FFF) / 10.0F) - 273.15F) /* convert Kelvin to Celsius (from unsigned int input) */
+    #define U3V_SET_TRIGGER_MODE_CONV(val)          (val)                       /* no conversion, see U3V_TRIGGER_MODE_CMD */
+    #define U3V_SET_TRIGGER_SOFTWARE_CONV(val)      ((val & 0x00000001) << 31)  /* bit 31 */
 /*******************************************************************************
  * FLIR Blackfly S BFS-U3-16S2C-CS
  ******************************************************************************/
@@ -91,6 +104,9 @@ extern "C" {
     #define U3V_CAM_CFG_ACQ_STOP_REG_ADR            (UINT64_C(0x000C0024))      /* AcquisitionStop_Val */
     #define U3V_CAM_CFG_PIXEL_FORMAT_REG_ADR        (UINT64_C(0x00086008))      /* PixelFormat_Val */
     #define U3V_CAM_CFG_PAYLOAD_SIZE_REG_ADR        (UINT64_C(0x20002008))      /* PayloadSize_Val */
+    #define U3V_CAM_CFG_TRIGGER_MODE_REG_ADR        (UINT64_C(0x0))             /* TriggerMode_Val - N/A, not mapped yet */
+    #define U3V_CAM_CFG_TRIGGER_SOFTWARE_REG_ADR    (UINT64_C(0x0))             /* TriggerSoftware_Val - N/A, not mapped yet */
+    #define U3V_CAM_CFG_TRIGGER_SUPPORTED           (false)                     /* trigger registers are not mapped */
     #define U3V_CAM_CFG_ACQ_MODE_SEL                (UINT32_C(0x1))             /* 0 = CONTINUOUS / 1 = SINGLE_FRAME / 2 = MULTI_FRAME */
     #define U3V_CAM_CFG_PIXEL_FORMAT_SEL            (UINT32_C(0x02180014))      /* 0x02180014 = U3V_PFNC_RGB8 */
     #define U3V_DEVICE_RESET_CMD                    (UINT32_C(0x1))             /* 1 = reset true */
@@ -98,6 +114,10 @@ extern "C" {
     #define U3V_ACQUISITION_STOP_CMD                (UINT32_C(0x1))             /* 1 = acq stop true */
     #define U3V_SI_CTRL_ENABLE_CMD                  (UINT32_C(0x1))             /* 1 = SI control enable true */
     #define U3V_SI_CTRL_DISABLE_CMD                 (UINT32_C(0x0))             /* 1 = SI control disable true */
+    #define U3V_TRIGGER_MODE_CMD(enable, source)    (UINT32_C(0x0))             /* N/A */
+    #define U3V_TRIGGER_SOFTWARE_CMD                (UINT32_C(0x0))             /* N/A */
+    #define U3V_CAM_TRIGGER_SOURCE_LINE0            (UINT32_C(0x0))             /* N/A */
+    #define U3V_CAM_TRIGGER_SOURCE_SOFTWARE         (UINT32_C(0x0))             /* N/A */
     #define U3V_CAM_IMG_PRESET_DEFAULT_SET          (UINT32_C(0x0))             /* UserSetSelector: Default set (0) */
     #define U3V_CAM_IMG_PRESET_USER_SET_0           (UINT32_C(0x1F))            /* UserSetSelector: User set 0 (31) */
     #define U3V_CAM_IMG_PRESET_USER_SET_1           (UINT32_C(0x1E))            /* UserSetSelector: User set 1 (30) */
@@ -115,6 +135,8 @@ extern "C" {
     #define U3V_GET_PIXEL_FORMAT_CONV(val)          (val)                       /* no conversion */
     #define U3V_SET_PIXEL_FORMAT_CONV(val)          (val)                       /* no conversion */
     #define U3V_GET_TEMPERATURE_CONV(val)           (((float)(val & 0x0000FFFF) / 10.0F)) /* Celsius (from unsigned int input) */
+    #define U3V_SET_TRIGGER_MODE_CONV(val)          (val)                       /* N/A */
+    #define U3V_SET_TRIGGER_SOFTWARE_CONV(val)      (val)                       /* N/A */
 /******************************************************************************/
 #else
     #error "Invalid USB3 Vision camera model selected"
@@ -164,6 +186,34 @@ extern "C" {
  */
 #define U3V_HOST_CTRL_IF_WAIT_FOR_ACK_DELAY_MS      UINT32_C(10)
 
+/**
+ * U3V Host fault injection enable.
+ * 
+ * When true, U3VHost_InjectFault is available to the application to inject 
+ * faults (dropped Control Interface acknowledge, truncated or stalled image 
+ * payload transfer, device detach) on the transfer events of the U3V Host, to
+ * exercise the recovery paths of the U3V App.
+ * @warning Keep false on flight builds.
+ */
+#define U3V_HOST_FAULT_INJECTION_ENABLE             (false)
+
+/**
+ * U3V App recovery max retries.
+ * 
+ * Number of consecutive warm reconnect attempts (camera software reset and 
+ * new bring-up) made by the U3V App after a failed step, before it stays in 
+ * the error state. The counter is cleared by a successful recovery.
+ */
+#define U3V_APP_RECOVERY_MAX_RETRIES                UINT32_C(3)
+
+/**
+ * U3V App stream pipe halt clear timeout (ms).
+ * 
+ * Max time to wait for the completion of the Stream Interface pipe halt clear
+ * request when recovering from a stalled image payload transfer.
+ */
+#define U3V_APP_RECOVERY_HALT_CLEAR_TIMEOUT_MS      UINT32_C(500)
+
 /**
  * U3V Host image payload data block max size.
  * 
@@ -238,6 +288,124 @@ extern "C" {
  */
 #define U3V_CTRL_IF_ACK_BUFFER_MAX_SIZE             ((size_t)76)
 
+/**
+ * U3V App timestamp source (ms).
+ * 
+ * Millisecond time source used for profiling the App states. By default uses 
+ * the FreeRTOS tick count, it can be predefined to use a higher resolution 
+ * timer (or a fake clock when building the driver for a host).
+ */
+#ifndef U3V_GET_TIMESTAMP_MS
+    #define U3V_GET_TIMESTAMP_MS()                  ((uint32_t)(xTaskGetTickCount() * portTICK_PERIOD_MS))
+#endif
+
+/**
+ * U3V App trigger timestamp source (us).
+ * 
+ * Microsecond time source used for the trigger to leader latency measurement.
+ * It is also called from interrupt context (U3VCamDriver_NotifyHwTrigger). By 
+ * default uses the FreeRTOS tick count (tick resolution), predefine it to read
+ * a free running hardware timer for a meaningful measurement.
+ */
+#ifndef U3V_GET_TIMESTAMP_US
+    #define U3V_GET_TIMESTAMP_US()                  ((uint32_t)(xTaskGetTickCountFromISR() * portTICK_PERIOD_MS * UINT32_C(1000)))
+#endif
+
+/**
+ * U3V App bring-up time budgets (ms).
+ * 
+ * Maximum time from device attach to ready for image acquisition, for the 
+ * first connection after initialization (cold start) and for any following
+ * connection (warm reconnect, e.g. after a camera sw reset). When exceeded, 
+ * the U3V_DRV_ERR_BRINGUP_BUDGET_EXCEEDED error is reported, the driver keeps
+ * operating normally. Use 0 to disable the check.
+ */
+#define U3V_BRINGUP_COLD_START_BUDGET_MS            UINT32_C(5000)
+#define U3V_BRINGUP_WARM_RECONNECT_BUDGET_MS        UINT32_C(3000)
+
+/**
+ * U3V Host data cache line size.
+ * 
+ * Size in bytes of a line of the MCU data cache (Cortex-M7: 32 bytes). Buffers
+ * written by the USB DMA must start on a line boundary and occupy whole lines,
+ * otherwise cache maintenance on them may corrupt neighbouring data.
+ */
+#define U3V_DCACHE_LINE_SIZE                        ((size_t)32)
+
+/**
+ * U3V Host image payload buffer pool blocks number.
+ * 
+ * Number of statically allocated image payload buffers (U3VCam_BufPool), each
+ * one U3V_PAYLD_BLOCK_MAX_SIZE long (rounded up to U3V_DCACHE_LINE_SIZE). The
+ * same buffer holds the leader, payload and trailer blocks of an image.
+ */
+#define U3V_BUF_POOL_BLOCKS_NUMBER                  UINT32_C(2)
+
+/**
+ * U3V Host image payload buffer pool memory section attribute.
+ * 
+ * Attribute used to place the buffer pool in a specific memory region (e.g. 
+ * __attribute__((section(".ram_nocache"))) for an MPU non-cacheable region). 
+ * Leave empty to place the pool in the default (cacheable) SRAM.
+ * @warning The section must exist in the linker script.
+ */
+#define U3V_BUF_POOL_SECTION_ATTR
+
+/**
+ * U3V Host image payload buffer pool non-cacheable region flag.
+ * 
+ * Set to true only if U3V_BUF_POOL_SECTION_ATTR places the pool in a region 
+ * that is not cached (MPU non-cacheable region or TCM), so that no cache 
+ * maintenance is done on pool buffers.
+ */
+#define U3V_BUF_POOL_NONCACHEABLE                   (false)
+
+/**
+ * U3V Host data TCM address range.
+ * 
+ * Base address and size in bytes of the data tightly coupled memory (DTCM). 
+ * Buffers located in DTCM bypass the data cache and need no maintenance.
+ * @note Set size to 0 when the DTCM is disabled (GPNVM TCM configuration). The
+ *       size is also tested by the preprocessor, so it shall be an integer
+ *       constant without casts.
+ */
+#define U3V_DTCM_BASE_ADDR                          ((uintptr_t)0x20000000)
+#define U3V_DTCM_SIZE                               UINT32_C(0)
+
+/**
+ * U3V Host data cache maintenance functions.
+ * 
+ * Clean and invalidate by address operations used on image payload buffers. By 
+ * default these map to the device cache macros of the MCU, they can be 
+ * predefined (e.g. to recording fakes when building the driver for a host).
+ */
+#ifndef U3V_DCACHE_CLEAN_BY_ADDR
+    #define U3V_DCACHE_CLEAN_BY_ADDR(addr, size)        DCACHE_CLEAN_BY_ADDR((uint32_t *)(addr), (int32_t)(size))
+#endif
+#ifndef U3V_DCACHE_INVALIDATE_BY_ADDR
+    #define U3V_DCACHE_INVALIDATE_BY_ADDR(addr, size)   DCACHE_INVALIDATE_BY_ADDR((uint32_t *)(addr), (int32_t)(size))
+#endif
+
+/**
+ * U3V write-behind buffers number and size.
+ *
+ * Staging buffers (U3VCam_WriteBehind) between the image payload callback and
+ * the storage block device. Each buffer is written to the device with a single
+ * write when full (or at the end of a frame), so the size sets the write size.
+ * The size must be a multiple of the device block size and of
+ * U3V_DCACHE_LINE_SIZE, and at least U3V_PAYLD_BLOCK_MAX_SIZE.
+ */
+#define U3V_WRITE_BEHIND_BUFFERS_NUMBER             UINT32_C(3)
+#define U3V_WRITE_BEHIND_BUFFER_SIZE                ((size_t)0x8000)   /* 32768 */
+
+/**
+ * U3V write-behind tracked frames number.
+ *
+ * Number of frames whose durability is tracked, a new frame can only be opened
+ * when the oldest tracked frame has been written to the device.
+ */
+#define U3V_WRITE_BEHIND_FRAMES_NUMBER              UINT32_C(8)
+
 
 
 #ifdef __cplusplus
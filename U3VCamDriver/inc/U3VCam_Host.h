@@ -62,7 +62,7 @@ typedef struct U3V_PACKED
     void            *data;
 } T_U3VSiGenericPacket;
 
-U3V_STATIC_ASSERT((sizeof(T_U3VSiGenericPacket) == 20), "Packing error for T_U3VSiGenericPacket");
+U3V_STATIC_ASSERT((offsetof(T_U3VSiGenericPacket, data) == 16), "Packing error for T_U3VSiGenericPacket");
 
 /**
  * U3V Host result.
@@ -96,6 +96,8 @@ typedef enum
     U3V_MEM_REG_INT_DEVICE_RESET,
     U3V_MEM_REG_INT_PAYLOAD_SIZE,
     U3V_MEM_REG_INT_PIXEL_FORMAT,
+    U3V_MEM_REG_INT_TRIGGER_MODE,
+    U3V_MEM_REG_INT_TRIGGER_SOFTWARE,
 } T_U3VMemRegInteger;
 
 /**
@@ -146,6 +148,7 @@ typedef enum
     U3V_HOST_EVENT_READ_COMPLETE = 1,
     U3V_HOST_EVENT_WRITE_COMPLETE,
     U3V_HOST_EVENT_IMG_PLD_RECEIVED,
+    U3V_HOST_EVENT_STREAM_HALT_CLEARED,
 } T_U3VHostEvent;
 
 /**
@@ -170,6 +173,34 @@ typedef struct
     uint32_t    transferAlignment;
 } T_U3VDeviceInfo;
 
+/**
+ * U3V Host Control Interface statistics.
+ * 
+ * Counters of the Control Interface traffic since power up, never reset. 
+ * Differences between two samples give the traffic of an operation.
+ */
+typedef struct
+{
+    uint32_t    transactions;   /* commands (CMD) sent */
+    uint32_t    bytesMoved;     /* command and acknowledge (ACK) bytes transferred */
+} T_U3VHostCtrlIfStats;
+
+#if (U3V_HOST_FAULT_INJECTION_ENABLE == true)
+/**
+ * U3V Host injected fault.
+ * 
+ * Faults applied by the U3V Host on the next matching transfer event.
+ */
+typedef enum
+{
+    U3V_HOST_FAULT_NONE,
+    U3V_HOST_FAULT_DROP_ACK,            /* Control IF acknowledge is not delivered, the request times out */
+    U3V_HOST_FAULT_TRUNCATE_PAYLOAD,    /* image payload block is delivered with half of its length */
+    U3V_HOST_FAULT_STALL_PIPE,          /* image payload transfer completes as stalled */
+    U3V_HOST_FAULT_DETACH               /* after an image block, the host task closes the interfaces and re-assigns them */
+} T_U3VHostFault;
+#endif
+
 /**
  * U3V Host attach event handler.
  * 
@@ -350,6 +381,18 @@ T_U3VHostResult U3VHost_StreamIfControl(T_U3VHostHandle u3vObjHandle, bool enabl
  */
 T_U3VHostResult U3VHost_StartImgPayldTransfer(T_U3VHostHandle u3vObjHandle, void *imgBfr, size_t size);
 
+/**
+ * U3V Host clear Stream interface halt.
+ * 
+ * This function shall be called by the application to clear the halt condition
+ * of the Stream interface bulk IN endpoint after a stalled image payload 
+ * transfer. Completion is reported with the U3V_HOST_EVENT_STREAM_HALT_CLEARED
+ * event, whose result field holds the request result.
+ * @param u3vObjHandle 
+ * @return T_U3VHostResult 
+ */
+T_U3VHostResult U3VHost_StreamIfClearHalt(T_U3VHostHandle u3vObjHandle);
+
 /**
  * U3V Host Control Interface create function.
  * 
@@ -436,6 +479,31 @@ T_U3VHostResult U3VHost_ReadMemRegFloatValue(T_U3VHostHandle u3vObjHandle, T_U3V
  */
 T_U3VHostResult U3VHost_ReadMemRegStringValue(T_U3VHostHandle u3vObjHandle, T_U3VMemRegString stringReg, void *pReadBfr);
 
+/**
+ * U3V Host get Control Interface statistics.
+ * 
+ * This function may be used by the application to sample the Control Interface
+ * traffic counters, e.g. for profiling the device setup.
+ * @param pStats 
+ */
+void U3VHost_GetCtrlIfStats(T_U3VHostCtrlIfStats *pStats);
+
+#if (U3V_HOST_FAULT_INJECTION_ENABLE == true)
+/**
+ * U3V Host inject fault.
+ * 
+ * Arms a single fault, applied on the transfer event that matches the fault 
+ * type after skipEvents matching events have passed. Arming a new fault 
+ * replaces a pending one, U3V_HOST_FAULT_NONE disarms it.
+ * @param u3vObjHandle 
+ * @param fault 
+ * @param skipEvents 
+ * @return T_U3VHostResult 
+ * @note Only available when U3V_HOST_FAULT_INJECTION_ENABLE is true.
+ */
+T_U3VHostResult U3VHost_InjectFault(T_U3VHostHandle u3vObjHandle, T_U3VHostFault fault, uint32_t skipEvents);
+#endif
+
 
 #ifdef __cplusplus
 }
@@ -191,6 +191,7 @@ typedef struct
     USB_HOST_DEVICE_INTERFACE_HANDLE    ifHandle;
     USB_HOST_PIPE_HANDLE                bulkInPipeHandle;
     USB_HOST_PIPE_HANDLE                bulkOutPipeHandle;
+    uint8_t                             bulkInEpAddr;
 } T_U3VHostInterfHandle;
 
 /**
@@ -235,6 +236,11 @@ typedef struct
     T_U3VHostDetachEventHandler         detachEventHandler;
     bool                                hostRequestDone;
     USB_HOST_RESULT                     hostRequestResult;
+#if (U3V_HOST_FAULT_INJECTION_ENABLE == true)
+    T_U3VHostFault                      injFault;
+    uint32_t                            injFaultSkipEvents;
+    volatile bool                       injDetachPending;
+#endif
 } T_U3VHostInstanceObj;
 
 /**
@@ -0,0 +1,151 @@
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+
+/*******************************************************************************
+* Type definitions
+*******************************************************************************/
+
+/**
+ * U3V pixel format 12-bit packed stream unpack context.
+ *
+ * Holds the bytes of a 12p pixel pair that was split between two consecutive
+ * image payload blocks, so that blocks of any size can be unpacked as they
+ * arrive. Clear it (zero init) at the start of each image (leader block).
+ */
+typedef struct
+{
+    uint8_t     carry[2];
+    uint8_t     carryLen;
+} T_U3VPixFmtUnpackCtx;
+
+
+/*******************************************************************************
+* Function declarations
+*******************************************************************************/
+
+/**
+ * U3V pixel format 12-bit packed to 16-bit unpack, for payload blocks.
+ *
+ * Unpacks a block of Mono12p / Bayer**12p data (PFNC LSB packing, 2 pixels in
+ * 3 bytes) to one 12-bit value per uint16_t. Blocks may end in the middle of a
+ * pixel pair, the remaining bytes are kept in the context and completed by
+ * the next block. Bulk data is unpacked 8 pixels (three 32-bit words) at a
+ * time.
+ * @param pCtx unpack context of the current image
+ * @param src packed block
+ * @param srcSize size of the packed block in bytes
+ * @param dst destination of the unpacked pixels, must hold at least
+ * ((srcSize + 2) * 2 / 3) pixels
+ * @return size_t Number of pixels written to dst
+ */
+size_t U3VPixFmt_Unpack12pTo16Block(T_U3VPixFmtUnpackCtx *pCtx, const uint8_t *src, size_t srcSize, uint16_t *dst);
+
+/**
+ * U3V pixel format 12-bit packed to 8-bit conversion.
+ *
+ * Converts a line of Mono12p / Bayer**12p data to 8 bits per pixel, keeping
+ * the 8 most significant bits of each pixel.
+ * @param src packed pixels, (nPixels * 3 / 2) bytes
+ * @param nPixels number of pixels, must be even
+ * @param dst destination, nPixels bytes
+ */
+void U3VPixFmt_Unpack12pTo8(const uint8_t *src, size_t nPixels, uint8_t *dst);
+
+/**
+ * U3V pixel format BayerRG8 to RGB8 nearest neighbour, row pair kernel.
+ *
+ * Converts an even (R G R G...) and the following odd (G B G B...) Bayer row
+ * to two RGB8 rows. Every 2x2 cell gets its own red and blue sample and the
+ * average of its two green samples.
+ * @param srcRow0 even Bayer row
+ * @param srcRow1 odd Bayer row
+ * @param width row width in pixels, must be even
+ * @param dstRow0 RGB8 destination of the even row, (width * 3) bytes
+ * @param dstRow1 RGB8 destination of the odd row, (width * 3) bytes
+ */
+void U3VPixFmt_BayerRG8ToRGB8NearestRowPair(const uint8_t *srcRow0, const uint8_t *srcRow1, size_t width, uint8_t *dstRow0, uint8_t *dstRow1);
+
+/**
+ * U3V pixel format BayerRG8 to RGB8 bilinear, line kernel.
+ *
+ * Converts one Bayer row to an RGB8 row, interpolating the missing colours
+ * from the neighbouring row above and below. At the image borders pass the
+ * mirrored row (row 1 as the row above row 0, row h-2 as the row below row
+ * h-1), the left and right borders are mirrored internally.
+ * @param srcPrev Bayer row above
+ * @param srcCurr Bayer row to convert
+ * @param srcNext Bayer row below
+ * @param width row width in pixels, must be even and at least 2
+ * @param evenRow true if srcCurr is an even (R G) row
+ * @param dst RGB8 destination, (width * 3) bytes
+ */
+void U3VPixFmt_BayerRG8ToRGB8BilinearLine(const uint8_t *srcPrev, const uint8_t *srcCurr, const uint8_t *srcNext, size_t width, bool evenRow, uint8_t *dst);
+
+/**
+ * U3V pixel format RGB8 to YUV420 (I420), row pair kernel.
+ *
+ * Converts two RGB8 rows to two luma rows and one row of each subsampled
+ * chroma plane (BT.601, limited range). Each chroma sample is computed from
+ * the average colour of its 2x2 cell.
+ * @param srcRow0 RGB8 even row
+ * @param srcRow1 RGB8 odd row
+ * @param width row width in pixels, must be even
+ * @param dstY0 luma destination of the even row, width bytes
+ * @param dstY1 luma destination of the odd row, width bytes
+ * @param dstU Cb destination, (width / 2) bytes
+ * @param dstV Cr destination, (width / 2) bytes
+ */
+void U3VPixFmt_RGB8ToYUV420RowPair(const uint8_t *srcRow0, const uint8_t *srcRow1, size_t width, uint8_t *dstY0, uint8_t *dstY1, uint8_t *dstU, uint8_t *dstV);
+
+/**
+ * U3V pixel format BayerRG8 to RGB8, full frame.
+ *
+ * @param src Bayer frame, (width * height) bytes
+ * @param width frame width, must be even and at least 2
+ * @param height frame height, must be even and at least 2
+ * @param bilinear true for bilinear interpolation, false for nearest neighbour
+ * @param dst RGB8 frame, (width * height * 3) bytes, must not overlap src
+ * @return true on success, false on invalid parameters
+ */
+bool U3VPixFmt_BayerRG8ToRGB8Frame(const uint8_t *src, size_t width, size_t height, bool bilinear, uint8_t *dst);
+
+/**
+ * U3V pixel format BayerRG12p to RGB8, full frame.
+ *
+ * Converts the packed frame to 8 bits per pixel row by row, only three
+ * unpacked rows are kept in the scratch buffer at a time.
+ * @param src BayerRG12p frame, (width * height * 3 / 2) bytes
+ * @param width frame width, must be even and at least 2
+ * @param height frame height, must be even and at least 2
+ * @param bilinear true for bilinear interpolation, false for nearest neighbour
+ * @param scratch scratch buffer, (width * 3) bytes
+ * @param dst RGB8 frame, (width * height * 3) bytes, must not overlap src
+ * @return true on success, false on invalid parameters
+ */
+bool U3VPixFmt_BayerRG12pToRGB8Frame(const uint8_t *src, size_t width, size_t height, bool bilinear, uint8_t *scratch, uint8_t *dst);
+
+/**
+ * U3V pixel format RGB8 to YUV420 (I420), full frame.
+ *
+ * @param src RGB8 frame, (width * height * 3) bytes
+ * @param width frame width, must be even
+ * @param height frame height, must be even
+ * @param dst I420 frame, Y plane followed by U and V planes,
+ * (width * height * 3 / 2) bytes
+ * @return true on success, false on invalid parameters
+ */
+bool U3VPixFmt_RGB8ToYUV420Frame(const uint8_t *src, size_t width, size_t height, uint8_t *dst);
+
+
+#ifdef __cplusplus
+}
+#endif //__cplusplus
+
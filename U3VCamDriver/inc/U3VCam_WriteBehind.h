@@ -0,0 +1,179 @@
+#pragma once
+
+#include "U3VCam_Config.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+
+/*******************************************************************************
+* Type definitions
+*******************************************************************************/
+
+/**
+ * U3V write-behind result.
+ *
+ */
+typedef enum
+{
+    U3V_WB_RESULT_NO_SPACE          = -3,
+    U3V_WB_RESULT_INVALID_PARAMETER = -2,
+    U3V_WB_RESULT_FAILURE           = -1,
+    U3V_WB_RESULT_SUCCESS           =  1
+} T_U3VWriteBehindResult;
+
+/**
+ * U3V write-behind block device write function.
+ *
+ * Writes blockCount blocks starting at lba. Returns true when the data is
+ * durable on the device (a write that is only cached by the device driver
+ * shall be synced before returning).
+ */
+typedef bool (*T_U3VWriteBehindBlockWrite)(uintptr_t context, uint32_t lba, const void *pData, uint32_t blockCount);
+
+/**
+ * U3V write-behind block device interface.
+ *
+ * The image data is written as a ring over the region [firstLba, firstLba +
+ * lbaCount) of the device, wrapping around when the end is reached.
+ * @note blockSize shall divide U3V_WRITE_BEHIND_BUFFER_SIZE.
+ */
+typedef struct
+{
+    uint32_t                        blockSize;
+    uint32_t                        firstLba;
+    uint32_t                        lbaCount;
+    T_U3VWriteBehindBlockWrite      write;
+    uintptr_t                       context;
+} T_U3VWriteBehindBlockDevice;
+
+/**
+ * U3V write-behind statistics.
+ *
+ */
+typedef struct
+{
+    uint32_t    bytesAccepted;      /* payload bytes copied to the buffers */
+    uint32_t    blocksWritten;      /* device blocks written (durable) */
+    uint32_t    blocksRejected;     /* payload blocks rejected for lack of space */
+    uint32_t    writeErrors;        /* failed device writes (retried) */
+    uint32_t    framesDurable;      /* frames completely written */
+    uint32_t    framesIncomplete;   /* frames closed with rejected blocks */
+    uint32_t    framesRejected;     /* frames rejected for lack of frame slots */
+    uint32_t    framesOverwritten;  /* durable frames overwritten by the ring */
+} T_U3VWriteBehindStats;
+
+
+/*******************************************************************************
+* Function declarations
+*******************************************************************************/
+
+/**
+ * U3V write-behind initialize.
+ *
+ * Sets up the block device and resets all buffers, frames and statistics.
+ * Shall be called before any other write-behind function.
+ * @param pBlockDevice block device interface (copied)
+ * @return T_U3VWriteBehindResult
+ */
+T_U3VWriteBehindResult U3VWriteBehind_Initialize(const T_U3VWriteBehindBlockDevice *pBlockDevice);
+
+/**
+ * U3V write-behind begin frame.
+ *
+ * Opens a new frame, to be called on the image leader block. The frame data
+ * starts on a new buffer, therefore on a block boundary of the device.
+ * @param frameId application frame identifier (e.g. leader block ID)
+ * @return T_U3VWriteBehindResult U3V_WB_RESULT_NO_SPACE if all frame slots
+ * hold frames that are not durable yet. The frame is then rejected as a whole:
+ * U3VWriteBehind_PushBlock and U3VWriteBehind_EndFrame return
+ * U3V_WB_RESULT_NO_SPACE until the next U3VWriteBehind_BeginFrame.
+ */
+T_U3VWriteBehindResult U3VWriteBehind_BeginFrame(uint32_t frameId);
+
+/**
+ * U3V write-behind push payload block.
+ *
+ * Copies a received image payload block to the write-behind buffers, to be
+ * called from the payload event callback (U3V_CAM_DRV_IMG_PAYLOAD_DATA). Full
+ * buffers are handed to U3VWriteBehind_Tasks for writing.
+ * @param pData payload block
+ * @param size payload block size in bytes
+ * @return T_U3VWriteBehindResult U3V_WB_RESULT_NO_SPACE if the block does not
+ * fit in the free buffers, the block is then rejected as a whole, or if the
+ * frame has been rejected by U3VWriteBehind_BeginFrame.
+ */
+T_U3VWriteBehindResult U3VWriteBehind_PushBlock(const void *pData, size_t size);
+
+/**
+ * U3V write-behind end frame.
+ *
+ * Closes the open frame, to be called on the image trailer block. The last
+ * buffer of the frame is padded to the device block size and handed for
+ * writing.
+ * @return T_U3VWriteBehindResult U3V_WB_RESULT_NO_SPACE if the frame has been
+ * rejected by U3VWriteBehind_BeginFrame.
+ */
+T_U3VWriteBehindResult U3VWriteBehind_EndFrame(void);
+
+/**
+ * U3V write-behind can accept check.
+ *
+ * Backpressure check for the payload path: the application shall request the
+ * next payload block (U3VCamDriver_RequestNewImagePayloadBlock) only when a
+ * block of U3V_PAYLD_BLOCK_MAX_SIZE can be accepted, so that the USB transfer
+ * is delayed instead of data being dropped.
+ * @param size size of the next payload block in bytes
+ * @return true if a block of this size fits in the free buffers
+ */
+bool U3VWriteBehind_CanAccept(size_t size);
+
+/**
+ * U3V write-behind tasks.
+ *
+ * Writes the buffers that are ready to the block device, one large aligned
+ * write per buffer, and updates the durable frames. Shall be called from the
+ * storage task, not from the payload callback. A failed write is retried on
+ * the next call.
+ */
+void U3VWriteBehind_Tasks(void);
+
+/**
+ * U3V write-behind frame durability check.
+ *
+ * @param frameId
+ * @return true if the frame has been closed and completely written, and the
+ * ring has not wrapped over its blocks yet. A frame with rejected blocks is
+ * never durable.
+ * @note Only the last U3V_WRITE_BEHIND_FRAMES_NUMBER frames are tracked.
+ */
+bool U3VWriteBehind_IsFrameDurable(uint32_t frameId);
+
+/**
+ * U3V write-behind get frame range.
+ *
+ * Returns where a durable frame is stored on the device, so that it can be
+ * read back from the ring.
+ * @param frameId
+ * @param pLba first LBA of the frame
+ * @param pBlockCount number of blocks of the frame, including the padding of
+ * its last block
+ * @return T_U3VWriteBehindResult U3V_WB_RESULT_FAILURE if the frame is not
+ * durable (see U3VWriteBehind_IsFrameDurable).
+ * @note The range wraps to firstLba when it crosses the end of the ring.
+ */
+T_U3VWriteBehindResult U3VWriteBehind_GetFrameRange(uint32_t frameId, uint32_t *pLba, uint32_t *pBlockCount);
+
+/**
+ * U3V write-behind get statistics.
+ *
+ * @param pStats
+ */
+void U3VWriteBehind_GetStats(T_U3VWriteBehindStats *pStats);
+
+
+#ifdef __cplusplus
+}
+#endif //__cplusplus
+
@@ -1,5 +1,9 @@
 
 #include "U3VCam_App.h"
+#include "U3VCam_BufPool.h"
+
+#include "FreeRTOS.h"
+#include "task.h"
 
 
 
@@ -19,6 +23,18 @@ static inline uint32_t U3VApp_ImgPresetAppReqToRegMapping(T_U3VCamDriverImagePre
 
 static inline T_U3VCamDriverImagePreset U3VApp_ImgPresetRegToAppReqMapping(uint32_t presetRegVal);
 
+static inline void U3VApp_ImgPresetCacheClear(void);
+
+static bool U3VApp_ImgPresetCacheFill(T_U3VCamDriverImagePreset preset);
+
+static T_U3VAppState U3VApp_ImgPresetSwitchNextState(const T_U3VAppImagePresetCache *pPresetCache);
+
+static void U3VApp_ProfileStateTransition(T_U3VAppState prevState, T_U3VAppState nextState);
+
+static void U3VApp_RecoveryStart(T_U3VAppFaultType fault, bool frameLost);
+
+static void U3VApp_RecoveryStateTransition(T_U3VAppState prevState, T_U3VAppState nextState);
+
 static T_U3VHostEventResponse U3VApp_HostEventHandlerCbk(T_U3VHostHandle u3vObjHandle, T_U3VHostEvent event, void *pEventData, uintptr_t context);
 
 
@@ -51,6 +67,7 @@ void U3VCamDriver_Initialize(void)
     u3vAppData.camTemperature               = 0.F;
     u3vAppData.imgPresetLoad.regVal         = UINT32_C(-1); /* set value to invalid */
     u3vAppData.imgPresetLoad.reqstdPreset   = U3V_CAM_DRV_IMG_PRESET_USER_SET_0; /* apply user set 0 at startup */
+    u3vAppData.imgPresetLoad.switchPending  = false;
     u3vAppData.pixelFormat                  = UINT32_C(0);
     u3vAppData.payloadSize                  = UINT32_C(0);
     u3vAppData.acquisitionMode              = UINT32_C(0);
@@ -61,6 +78,11 @@ void U3VCamDriver_Initialize(void)
     u3vAppData.appImgEvtCbk                 = NULL;
     u3vAppData.appImgDataBfr                = NULL;
 
+    U3VApp_ImgPresetCacheClear();
+    memset(&u3vAppData.trigger, 0, sizeof(u3vAppData.trigger));
+    memset(&u3vAppData.profiler, 0, sizeof(u3vAppData.profiler));
+    memset(&u3vAppData.recovery, 0, sizeof(u3vAppData.recovery));
+
     u3vDriver_InitStatus = drvSts;
 }
 
@@ -68,6 +90,11 @@ void U3VCamDriver_Initialize(void)
 void U3VCamDriver_Tasks(void)
 {
     T_U3VHostResult result1, result2;
+    T_U3VAppImagePresetCache *pPresetCache;
+    uint32_t presetRegVal;
+    bool triggerArmReq;
+    bool swResetIssued = false;
+    const T_U3VAppState stateOnEntry = u3vAppData.state;
 
     if (u3vAppData.camSwResetRequested)
     {
@@ -78,6 +105,7 @@ void U3VCamDriver_Tasks(void)
             {
                 u3vAppData.camSwResetRequested = false;
                 u3vAppData.deviceWasDetached = true;
+                swResetIssued = true;
             }
             else
             {
@@ -89,10 +117,16 @@ void U3VCamDriver_Tasks(void)
 
     if (u3vAppData.deviceWasDetached)
     {
+        if (!swResetIssued && (u3vAppData.state > U3V_APP_STATE_WAIT_FOR_DEVICE_ATTACH) && (u3vAppData.state != U3V_APP_STATE_ERROR))
+        {
+            /* detached while connected, the bring-up on the next attach completes the recovery */
+            U3VApp_RecoveryStart(U3V_APP_FAULT_DETACH, (u3vAppData.state == U3V_APP_STATE_WAIT_TO_ACQUIRE_IMAGE));
+        }
         u3vAppData.state                = U3V_APP_STATE_WAIT_FOR_DEVICE_ATTACH;
         u3vAppData.deviceWasDetached    = false;
         u3vAppData.camTemperature       = 0.F;
         u3vAppData.imgPresetLoad.regVal = UINT32_C(-1); /* set value to invalid */
+        u3vAppData.imgPresetLoad.switchPending = false; /* requested preset is applied on next connection setup */
         u3vAppData.pixelFormat          = UINT32_C(0);
         u3vAppData.payloadSize          = UINT32_C(0);
         u3vAppData.acquisitionMode      = UINT32_C(0);
@@ -100,7 +134,13 @@ void U3VCamDriver_Tasks(void)
         // U3VAppData.imgAcqRequested      = false;  //TODO: decide if this stays (case reset on error with requested true?)
         u3vAppData.appImgTransfState    = U3V_SI_IMG_TRANSF_STATE_IDLE;
         u3vAppData.appImgBlockCounter   = UINT32_C(0);
+        u3vAppData.trigger.isArmed      = false; /* re-armed on next connection setup if still requested */
+        u3vAppData.trigger.disarmRequested = false;
+        u3vAppData.trigger.isTriggered  = false;
+        u3vAppData.recovery.streamFault = false;
+        u3vAppData.recovery.haltClearRequested = false;
 
+        U3VApp_ImgPresetCacheClear();
         U3VHost_CtrlIf_InterfaceDestroy(u3vAppData.u3vHostHandle);
     }
 
@@ -225,10 +265,17 @@ void U3VCamDriver_Tasks(void)
                         u3vAppData.state = U3V_APP_STATE_ERROR;
                     }
                 }
-                else
+                else if (U3VApp_ImgPresetCacheFill(u3vAppData.imgPresetLoad.reqstdPreset))
                 {
+                    /* the preset loaded at connection setup is cached, a switch back to it skips the unchanged steps */
+                    u3vAppData.imgPresetLoad.switchPending = false;
                     u3vAppData.state = U3V_APP_STATE_SETUP_PIXEL_FORMAT;
                 }
+                else
+                {
+                    reportError(U3V_DRV_ERR_SET_IMG_PRESET_FAIL);
+                    u3vAppData.state = U3V_APP_STATE_ERROR;
+                }
             }
             else
             {
@@ -313,7 +360,41 @@ void U3VCamDriver_Tasks(void)
             break;
 
         case U3V_APP_STATE_READY_TO_START_IMG_ACQUISITION:
-            if (u3vAppData.imgAcqRequested)
+            if (u3vAppData.imgPresetLoad.switchPending)
+            {
+                /* apply a preset requested on runtime before the next image acquisition */
+                u3vAppData.state = U3V_APP_STATE_SWITCH_IMG_PRESET;
+            }
+            else if (u3vAppData.trigger.armRequested != u3vAppData.trigger.isArmed)
+            {
+                /* a disarm request is served by the trigger mode setup */
+                u3vAppData.trigger.disarmRequested = false;
+                u3vAppData.state = U3V_APP_STATE_SETUP_TRIGGER_MODE;
+            }
+            else if (u3vAppData.trigger.isArmed)
+            {
+                /* pre-arm: stream enabled, acquisition started and first transfer queued, the trigger starts the frame */
+                result1 = U3VHost_StreamIfControl(u3vAppData.u3vHostHandle, true);
+                result2 = U3VHost_WriteMemRegIntegerValue(u3vAppData.u3vHostHandle, U3V_MEM_REG_INT_ACQ_START, U3V_ACQUISITION_START_CMD);
+                if ((result1 == U3V_HOST_RESULT_SUCCESS) && (result2 == U3V_HOST_RESULT_SUCCESS))
+                {
+                    U3VBufPool_PrepareForDeviceWrite(u3vAppData.appImgDataBfr, U3V_PAYLD_BLOCK_MAX_SIZE);
+                    result1 = U3VHost_StartImgPayldTransfer(u3vAppData.u3vHostHandle, u3vAppData.appImgDataBfr, U3V_PAYLD_BLOCK_MAX_SIZE);
+                }
+                if ((result1 == U3V_HOST_RESULT_SUCCESS) && (result2 == U3V_HOST_RESULT_SUCCESS))
+                {
+                    u3vAppData.imgAcqRequested = true;
+                    u3vAppData.imgAcqReqNewBlock = false;
+                    u3vAppData.appImgTransfState = U3V_SI_IMG_TRANSF_STATE_START;
+                    u3vAppData.state = U3V_APP_STATE_WAIT_TO_ACQUIRE_IMAGE;
+                }
+                else
+                {
+                    reportError(U3V_DRV_ERR_ARM_TRIGGER_FAIL);
+                    u3vAppData.state = U3V_APP_STATE_ERROR;
+                }
+            }
+            else if (u3vAppData.imgAcqRequested)
             {
                 result1 = U3VHost_StreamIfControl(u3vAppData.u3vHostHandle, true);
                 result2 = U3VHost_WriteMemRegIntegerValue(u3vAppData.u3vHostHandle, U3V_MEM_REG_INT_ACQ_START, U3V_ACQUISITION_START_CMD);
@@ -331,7 +412,24 @@ void U3VCamDriver_Tasks(void)
             break;
 
         case U3V_APP_STATE_WAIT_TO_ACQUIRE_IMAGE:
-            if ((u3vAppData.appImgTransfState == U3V_SI_IMG_TRANSF_STATE_START) ||
+            if (u3vAppData.recovery.streamFault)
+            {
+                /* image payload transfer failed, the current frame is lost */
+                U3VApp_RecoveryStart(((u3vAppData.recovery.streamFaultResult == U3V_HOST_RESULT_REQUEST_STALLED) ? 
+                                      U3V_APP_FAULT_STREAM_STALL : U3V_APP_FAULT_STREAM_TRANSFER), true);
+                u3vAppData.state = U3V_APP_STATE_RECOVER_STREAM_IF;
+            }
+            else if ((u3vAppData.trigger.disarmRequested) &&
+                     (u3vAppData.trigger.isArmed) &&
+                     (u3vAppData.appImgTransfState == U3V_SI_IMG_TRANSF_STATE_START))
+            {
+                /* no frame in transfer yet, stop the armed acquisition, trigger mode is disabled when ready again */
+                u3vAppData.trigger.disarmRequested = false;
+                u3vAppData.imgAcqRequested = false;
+                u3vAppData.imgAcqReqNewBlock = false;
+                u3vAppData.state = U3V_APP_STATE_STOP_IMAGE_ACQ;
+            }
+            else if ((u3vAppData.appImgTransfState == U3V_SI_IMG_TRANSF_STATE_START) ||
                 (u3vAppData.appImgTransfState == U3V_SI_IMG_TRANSF_STATE_LEADER_COMPLETE) ||
                 (u3vAppData.appImgTransfState == U3V_SI_IMG_TRANSF_STATE_PAYLOAD_BLOCKS_COMPLETE))
             {
@@ -340,6 +438,7 @@ void U3VCamDriver_Tasks(void)
                     u3vAppData.imgAcqReqNewBlock = false;
                     /* size of transfer request for Leader and Trailer packes is much smaller, but there is no issue
                      * with the following size argument being greater, those packes will arrive with their own size */
+                    U3VBufPool_PrepareForDeviceWrite(u3vAppData.appImgDataBfr, U3V_PAYLD_BLOCK_MAX_SIZE);
                     result1 = U3VHost_StartImgPayldTransfer(u3vAppData.u3vHostHandle, u3vAppData.appImgDataBfr, U3V_PAYLD_BLOCK_MAX_SIZE);
                     if (result1 != U3V_HOST_RESULT_SUCCESS)
                     {
@@ -350,6 +449,12 @@ void U3VCamDriver_Tasks(void)
             }
             else if (u3vAppData.appImgTransfState == U3V_SI_IMG_TRANSF_STATE_TRAILER_COMPLETE)
             {
+                if (u3vAppData.recovery.frameBytes < u3vAppData.payloadSize)
+                {
+                    /* short image, nothing to recover on the stream, the frame is dropped */
+                    U3VApp_RecoveryStart(U3V_APP_FAULT_PAYLOAD_TRUNCATED, true);
+                    u3vAppData.recovery.stats.fault[U3V_APP_FAULT_PAYLOAD_TRUNCATED].recoveries++;
+                }
                 u3vAppData.imgAcqRequested = false;
                 u3vAppData.imgAcqReqNewBlock = false;
                 u3vAppData.state = U3V_APP_STATE_STOP_IMAGE_ACQ;
@@ -367,6 +472,7 @@ void U3VCamDriver_Tasks(void)
             if ((result1 == U3V_HOST_RESULT_SUCCESS) && (result2 == U3V_HOST_RESULT_SUCCESS))
             {
                 u3vAppData.appImgTransfState = U3V_SI_IMG_TRANSF_STATE_IDLE;
+                u3vAppData.recovery.streamFault = false;
                 u3vAppData.state = U3V_APP_STATE_GET_CAM_TEMPERATURE;
                 /* read camera temperature and get ready for new img acq req (idle) */
             }
@@ -377,12 +483,132 @@ void U3VCamDriver_Tasks(void)
             }
             break;
 
+        case U3V_APP_STATE_SWITCH_IMG_PRESET:
+            presetRegVal = U3VApp_ImgPresetAppReqToRegMapping(u3vAppData.imgPresetLoad.reqstdPreset);
+            result1 = U3VHost_WriteMemRegIntegerValue(u3vAppData.u3vHostHandle, U3V_MEM_REG_INT_IMG_PRESET_SELECT, presetRegVal);
+            result2 = U3VHost_WriteMemRegIntegerValue(u3vAppData.u3vHostHandle, U3V_MEM_REG_INT_IMG_PRESET_LOAD, U3V_SET_IMG_PRESET_LOAD_CMD(presetRegVal));
+            if ((result1 == U3V_HOST_RESULT_SUCCESS) && (result2 == U3V_HOST_RESULT_SUCCESS))
+            {
+                u3vAppData.imgPresetLoad.regVal = presetRegVal;
+                u3vAppData.imgPresetLoad.switchPending = false;
+                pPresetCache = &u3vAppData.imgPresetLoad.cache[U3VApp_ImgPresetRegToAppReqMapping(presetRegVal)];
+                /* on the first switch to this preset in the current session, read back what the preset loaded */
+                if (pPresetCache->isValid || U3VApp_ImgPresetCacheFill(U3VApp_ImgPresetRegToAppReqMapping(presetRegVal)))
+                {
+                    /* skip every setup step whose register values were not changed by the preset */
+                    u3vAppData.state = U3VApp_ImgPresetSwitchNextState(pPresetCache);
+                }
+                else
+                {
+                    reportError(U3V_DRV_ERR_SET_IMG_PRESET_FAIL);
+                    u3vAppData.state = U3V_APP_STATE_ERROR;
+                }
+            }
+            else
+            {
+                reportError(U3V_DRV_ERR_SET_IMG_PRESET_FAIL);
+                u3vAppData.state = U3V_APP_STATE_ERROR;
+            }
+            break;
+
+        case U3V_APP_STATE_SETUP_TRIGGER_MODE:
+            triggerArmReq = u3vAppData.trigger.armRequested;
+            result1 = U3VHost_WriteMemRegIntegerValue(u3vAppData.u3vHostHandle, 
+                                                      U3V_MEM_REG_INT_TRIGGER_MODE, 
+                                                      U3V_TRIGGER_MODE_CMD((triggerArmReq ? 1U : 0U), 
+                                                                           ((u3vAppData.trigger.source == U3V_CAM_DRV_TRIGGER_SRC_LINE0) ? U3V_CAM_TRIGGER_SOURCE_LINE0 : U3V_CAM_TRIGGER_SOURCE_SOFTWARE)));
+            if (result1 == U3V_HOST_RESULT_SUCCESS)
+            {
+                u3vAppData.trigger.isArmed = triggerArmReq;
+                u3vAppData.state = U3V_APP_STATE_READY_TO_START_IMG_ACQUISITION;
+            }
+            else
+            {
+                reportError(U3V_DRV_ERR_SETUP_TRIGGER_FAIL);
+                u3vAppData.state = U3V_APP_STATE_ERROR;
+            }
+            break;
+
+        case U3V_APP_STATE_RECOVER_STREAM_IF:
+            if ((u3vAppData.recovery.streamFaultResult == U3V_HOST_RESULT_REQUEST_STALLED) && !u3vAppData.recovery.haltClearRequested)
+            {
+                u3vAppData.recovery.haltClearDone = false;
+                result1 = U3VHost_StreamIfClearHalt(u3vAppData.u3vHostHandle);
+                if (result1 == U3V_HOST_RESULT_SUCCESS)
+                {
+                    u3vAppData.recovery.haltClearRequested = true;
+                    u3vAppData.recovery.haltClearReqMs = U3V_GET_TIMESTAMP_MS();
+                }
+                else
+                {
+                    reportError(U3V_DRV_ERR_RECOVER_STREAM_IF_FAIL);
+                    u3vAppData.state = U3V_APP_STATE_ERROR;
+                }
+            }
+            else if (u3vAppData.recovery.haltClearRequested && !u3vAppData.recovery.haltClearDone)
+            {
+                if ((U3V_GET_TIMESTAMP_MS() - u3vAppData.recovery.haltClearReqMs) > U3V_APP_RECOVERY_HALT_CLEAR_TIMEOUT_MS)
+                {
+                    reportError(U3V_DRV_ERR_RECOVER_STREAM_IF_FAIL);
+                    u3vAppData.state = U3V_APP_STATE_ERROR;
+                }
+            }
+            else
+            {
+                /* re-arm: stop the stream of the lost frame, acquisition restarts from ready state if still requested */
+                result1 = U3VHost_WriteMemRegIntegerValue(u3vAppData.u3vHostHandle, U3V_MEM_REG_INT_ACQ_STOP, U3V_ACQUISITION_STOP_CMD);
+                result2 = U3VHost_StreamIfControl(u3vAppData.u3vHostHandle, false);
+                if ((result1 == U3V_HOST_RESULT_SUCCESS) && (result2 == U3V_HOST_RESULT_SUCCESS))
+                {
+                    u3vAppData.recovery.streamFault = false;
+                    u3vAppData.recovery.haltClearRequested = false;
+                    u3vAppData.appImgTransfState = U3V_SI_IMG_TRANSF_STATE_IDLE;
+                    u3vAppData.imgAcqReqNewBlock = true;
+                    u3vAppData.state = U3V_APP_STATE_READY_TO_START_IMG_ACQUISITION;
+                }
+                else
+                {
+                    reportError(U3V_DRV_ERR_RECOVER_STREAM_IF_FAIL);
+                    u3vAppData.state = U3V_APP_STATE_ERROR;
+                }
+            }
+            break;
+
         case U3V_APP_STATE_ERROR:
         default:
-            /* An error has occurred */
-            //TODO: error handling...? request power reset?
+            /* An error has occurred, recover within the retries limit */
+            if (u3vAppData.recovery.retries < U3V_APP_RECOVERY_MAX_RETRIES)
+            {
+                u3vAppData.recovery.retries++;
+                if (u3vAppData.recovery.failedState > U3V_APP_STATE_SETUP_U3V_CONTROL_IF)
+                {
+                    /* warm reconnect: camera software reset, the bring-up restarts on the new attach */
+                    u3vAppData.camSwResetRequested = true;
+                }
+                else
+                {
+                    /* Control IF not established yet, repeat the failed step */
+                    if (u3vAppData.recovery.failedState == U3V_APP_STATE_SETUP_U3V_CONTROL_IF)
+                    {
+                        U3VHost_CtrlIf_InterfaceDestroy(u3vAppData.u3vHostHandle);
+                    }
+                    u3vAppData.state = u3vAppData.recovery.failedState;
+                }
+            }
+            else if (!u3vAppData.recovery.retriesExhausted)
+            {
+                u3vAppData.recovery.retriesExhausted = true;
+                u3vAppData.camSwResetRequested = false;
+                reportError(U3V_DRV_ERR_RECOVERY_RETRIES_EXHAUSTED);
+            }
             break;
     }
+
+    if (u3vAppData.state != stateOnEntry)
+    {
+        U3VApp_ProfileStateTransition(stateOnEntry, u3vAppData.state);
+        U3VApp_RecoveryStateTransition(stateOnEntry, u3vAppData.state);
+    }
 }
 
 T_U3VCamDriverStatus U3VCamDriver_SetErrorCallback(T_U3VCamDriverErrorCallback callback) {
@@ -402,6 +628,48 @@ T_U3VCamDriverStatus U3VCamDriver_SetErrorCallback(T_U3VCamDriverErrorCallback c
     return drvSts;
 }
 
+T_U3VCamDriverStatus U3VCamDriver_GetBringUpProfile(T_U3VAppBringUpProfile *pProfile)
+{
+    T_U3VCamDriverStatus drvSts = (U3VApp_DrvInitStatus() == U3V_DRV_INITIALIZATION_OK) ? U3V_CAM_DRV_OK : U3V_CAM_DRV_NOT_INITD;
+
+    if (drvSts != U3V_CAM_DRV_OK)
+    {
+        return drvSts;
+    }
+
+    if (pProfile != NULL)
+    {
+        *pProfile = u3vAppData.profiler.lastProfile;
+    }
+    else
+    {
+        drvSts = U3V_CAM_DRV_ERROR;
+    }
+
+    return drvSts;
+}
+
+T_U3VCamDriverStatus U3VCamDriver_GetRecoveryStats(T_U3VAppRecoveryStats *pStats)
+{
+    T_U3VCamDriverStatus drvSts = (U3VApp_DrvInitStatus() == U3V_DRV_INITIALIZATION_OK) ? U3V_CAM_DRV_OK : U3V_CAM_DRV_NOT_INITD;
+
+    if (drvSts != U3V_CAM_DRV_OK)
+    {
+        return drvSts;
+    }
+
+    if (pStats != NULL)
+    {
+        *pStats = u3vAppData.recovery.stats;
+    }
+    else
+    {
+        drvSts = U3V_CAM_DRV_ERROR;
+    }
+
+    return drvSts;
+}
+
 T_U3VCamDriverStatus U3VCamDriver_SetImagePayldTransfParams(T_U3VCamDriverPayloadEventCallback callback, void *imgDataBfr)
 {
     T_U3VCamDriverStatus drvSts = U3V_CAM_DRV_OK;
@@ -412,7 +680,7 @@ T_U3VCamDriverStatus U3VCamDriver_SetImagePayldTransfParams(T_U3VCamDriverPayloa
         return drvSts;
     }
 
-    if ((callback != NULL) && (imgDataBfr != NULL) && (!u3vAppData.imgAcqRequested))
+    if ((callback != NULL) && (imgDataBfr != NULL) && U3V_BUF_IS_DCACHE_ALIGNED(imgDataBfr) && (!u3vAppData.imgAcqRequested))
     {
         u3vAppData.appImgEvtCbk = callback;
         u3vAppData.appImgDataBfr = imgDataBfr;
@@ -482,7 +750,7 @@ T_U3VCamDriverCamState U3VCamDriver_GetCamState(void)
             camSt = U3V_CAM_DRV_CAM_DISCONNECTED;
             break;
 
-        /* fallthrough 9 cases for "CONNECTED" state */
+        /* fallthrough 11 cases for "CONNECTED" state */
         case U3V_APP_STATE_OPEN_DEVICE:
         case U3V_APP_STATE_SETUP_U3V_CONTROL_IF:
         case U3V_APP_STATE_READ_DEVICE_TEXT_DESCR:
@@ -492,6 +760,8 @@ T_U3VCamDriverCamState U3VCamDriver_GetCamState(void)
         case U3V_APP_STATE_SETUP_ACQUISITION_MODE:
         case U3V_APP_STATE_SETUP_U3V_STREAM_IF:
         case U3V_APP_STATE_GET_CAM_TEMPERATURE:
+        case U3V_APP_STATE_SWITCH_IMG_PRESET:
+        case U3V_APP_STATE_SETUP_TRIGGER_MODE:
             camSt = U3V_CAM_DRV_CAM_CONNECTED;
             break;
 
@@ -500,9 +770,10 @@ T_U3VCamDriverCamState U3VCamDriver_GetCamState(void)
             camSt = U3V_CAM_DRV_CAM_READY_TO_ACQ_IMG;
             break;
 
-        /* fallthrough 2 cases for "IN IMAGE TRANSFER" state */
+        /* fallthrough 3 cases for "IN IMAGE TRANSFER" state */
         case U3V_APP_STATE_WAIT_TO_ACQUIRE_IMAGE:
         case U3V_APP_STATE_STOP_IMAGE_ACQ:
+        case U3V_APP_STATE_RECOVER_STREAM_IF:
             camSt = U3V_CAM_DRV_CAM_IN_IMG_TRANSF;
             break;
 
@@ -615,7 +886,15 @@ T_U3VCamDriverStatus U3VCamDriver_RequestImagePreset(T_U3VCamDriverImagePreset p
         return drvSts;
     }
 
+    if ((presetRequest < U3V_CAM_DRV_IMG_PRESET_DEFAULT) || (presetRequest > U3V_CAM_DRV_IMG_PRESET_USER_SET_1))
+    {
+        return U3V_CAM_DRV_ERROR;
+    }
+
     u3vAppData.imgPresetLoad.reqstdPreset = presetRequest;
+    /* only switch when the requested preset differs from the one loaded to the camera, a request back to the loaded
+     * preset cancels a switch still pending */
+    u3vAppData.imgPresetLoad.switchPending = (presetRequest != U3VApp_ImgPresetRegToAppReqMapping(u3vAppData.imgPresetLoad.regVal));
 
     return drvSts;
 }
@@ -635,6 +914,126 @@ size_t U3VCamDriver_GetImagePayldMaxBlockSize(void)
 }
 
 
+T_U3VCamDriverStatus U3VCamDriver_ArmTrigger(T_U3VCamDriverTriggerSource source)
+{
+    T_U3VCamDriverStatus drvSts = U3V_CAM_DRV_OK;
+
+    drvSts = (U3VApp_DrvInitStatus() == U3V_DRV_INITIALIZATION_OK) ? drvSts : U3V_CAM_DRV_NOT_INITD;
+
+    if (drvSts != U3V_CAM_DRV_OK)
+    {
+        return drvSts;
+    }
+
+    if ((U3V_CAM_CFG_TRIGGER_SUPPORTED) &&
+        ((source == U3V_CAM_DRV_TRIGGER_SRC_SOFTWARE) || (source == U3V_CAM_DRV_TRIGGER_SRC_LINE0)) &&
+        (u3vAppData.appImgDataBfr != NULL) && (u3vAppData.appImgEvtCbk != NULL) &&
+        (!u3vAppData.trigger.isArmed || (u3vAppData.trigger.source == source)))
+    {
+        u3vAppData.trigger.source = source;
+        u3vAppData.trigger.armRequested = true;
+    }
+    else
+    {
+        /* to change the source of an armed trigger, disarm first */
+        drvSts = U3V_CAM_DRV_ERROR;
+    }
+
+    return drvSts;
+}
+
+
+T_U3VCamDriverStatus U3VCamDriver_DisarmTrigger(void)
+{
+    T_U3VCamDriverStatus drvSts = U3V_CAM_DRV_OK;
+
+    drvSts = (U3VApp_DrvInitStatus() == U3V_DRV_INITIALIZATION_OK) ? drvSts : U3V_CAM_DRV_NOT_INITD;
+
+    if (drvSts != U3V_CAM_DRV_OK)
+    {
+        return drvSts;
+    }
+
+    /* the acquisition state is owned by U3VCamDriver_Tasks, which stops a pending armed acquisition */
+    u3vAppData.trigger.armRequested = false;
+    u3vAppData.trigger.disarmRequested = true;
+
+    return drvSts;
+}
+
+
+T_U3VCamDriverStatus U3VCamDriver_SoftwareTrigger(void)
+{
+    T_U3VCamDriverStatus drvSts = U3V_CAM_DRV_OK;
+    T_U3VHostResult result;
+
+    drvSts = (U3VApp_DrvInitStatus() == U3V_DRV_INITIALIZATION_OK) ? drvSts : U3V_CAM_DRV_NOT_INITD;
+
+    if (drvSts != U3V_CAM_DRV_OK)
+    {
+        return drvSts;
+    }
+
+    if ((u3vAppData.trigger.isArmed) &&
+        (u3vAppData.trigger.source == U3V_CAM_DRV_TRIGGER_SRC_SOFTWARE) &&
+        (u3vAppData.state == U3V_APP_STATE_WAIT_TO_ACQUIRE_IMAGE) &&
+        (u3vAppData.appImgTransfState == U3V_SI_IMG_TRANSF_STATE_START))
+    {
+        u3vAppData.trigger.triggerTimeUs = U3V_GET_TIMESTAMP_US();
+        u3vAppData.trigger.isTriggered = true;
+        result = U3VHost_WriteMemRegIntegerValue(u3vAppData.u3vHostHandle, U3V_MEM_REG_INT_TRIGGER_SOFTWARE, U3V_TRIGGER_SOFTWARE_CMD);
+        if (result != U3V_HOST_RESULT_SUCCESS)
+        {
+            u3vAppData.trigger.isTriggered = false;
+            drvSts = U3V_CAM_DRV_ERROR;
+        }
+    }
+    else
+    {
+        drvSts = U3V_CAM_DRV_ERROR;
+    }
+
+    return drvSts;
+}
+
+
+void U3VCamDriver_NotifyHwTrigger(void)
+{
+    if ((u3vAppData.trigger.isArmed) &&
+        (u3vAppData.trigger.source == U3V_CAM_DRV_TRIGGER_SRC_LINE0) &&
+        (u3vAppData.state == U3V_APP_STATE_WAIT_TO_ACQUIRE_IMAGE) &&
+        (u3vAppData.appImgTransfState == U3V_SI_IMG_TRANSF_STATE_START))
+    {
+        u3vAppData.trigger.triggerTimeUs = U3V_GET_TIMESTAMP_US();
+        u3vAppData.trigger.isTriggered = true;
+    }
+}
+
+
+T_U3VCamDriverStatus U3VCamDriver_GetTriggerLatency(uint32_t *latencyUs)
+{
+    T_U3VCamDriverStatus drvSts = U3V_CAM_DRV_OK;
+
+    drvSts = (U3VApp_DrvInitStatus() == U3V_DRV_INITIALIZATION_OK) ? drvSts : U3V_CAM_DRV_NOT_INITD;
+
+    if (drvSts != U3V_CAM_DRV_OK)
+    {
+        return drvSts;
+    }
+
+    if ((latencyUs != NULL) && (u3vAppData.trigger.latencyIsValid))
+    {
+        *latencyUs = u3vAppData.trigger.lastLatencyUs;
+    }
+    else
+    {
+        drvSts = U3V_CAM_DRV_ERROR;
+    }
+
+    return drvSts;
+}
+
+
 /*******************************************************************************
 * Local function definitions
 *******************************************************************************/
@@ -782,6 +1181,198 @@ static inline T_U3VCamDriverImagePreset U3VApp_ImgPresetRegToAppReqMapping(uint3
 }
 
 
+/**
+ * U3V App image config. preset cache clear.
+ * 
+ * This function invalidates the register values cached per image preset, so
+ * that the next switch to any preset reads them back from the camera. It shall
+ * be called whenever the connected camera may have changed.
+ */
+static inline void U3VApp_ImgPresetCacheClear(void)
+{
+    for (uint32_t i = 0U; i < (sizeof(u3vAppData.imgPresetLoad.cache) / sizeof(u3vAppData.imgPresetLoad.cache[0])); i++)
+    {
+        u3vAppData.imgPresetLoad.cache[i].isValid = false;
+    }
+}
+
+
+/**
+ * U3V App image config. preset cache fill.
+ * 
+ * This function reads back the register values of the image preset just 
+ * loaded to the camera, before any configuration step changes them, and caches
+ * them for the preset.
+ * @param preset image preset loaded to the camera
+ * @return true if the values were read and cached
+ */
+static bool U3VApp_ImgPresetCacheFill(T_U3VCamDriverImagePreset preset)
+{
+    T_U3VAppImagePresetCache *pPresetCache = &u3vAppData.imgPresetLoad.cache[preset];
+    T_U3VHostResult result1, result2;
+
+    result1 = U3VHost_ReadMemRegIntegerValue(u3vAppData.u3vHostHandle, U3V_MEM_REG_INT_PIXEL_FORMAT, &pPresetCache->pixelFormat);
+    result1 |= U3VHost_ReadMemRegIntegerValue(u3vAppData.u3vHostHandle, U3V_MEM_REG_INT_ACQ_MODE, &pPresetCache->acquisitionMode);
+    result2 = U3VHost_ReadMemRegIntegerValue(u3vAppData.u3vHostHandle, U3V_MEM_REG_INT_PAYLOAD_SIZE, &pPresetCache->payloadSize);
+    pPresetCache->isValid = ((result1 == U3V_HOST_RESULT_SUCCESS) && (result2 == U3V_HOST_RESULT_SUCCESS));
+
+    return pPresetCache->isValid;
+}
+
+
+/**
+ * U3V App image config. preset switch next state.
+ * 
+ * This function compares the register values loaded by an image preset with 
+ * the current configuration and returns the first setup state that must be 
+ * repeated. Pixel format or acquisition mode mismatches need the full setup 
+ * path, a payload size mismatch only needs the stream interface (SIRM) setup, 
+ * otherwise the camera is ready without any further reconfiguration.
+ * @param pPresetCache register values loaded by the switched preset
+ * @return T_U3VAppState
+ */
+static T_U3VAppState U3VApp_ImgPresetSwitchNextState(const T_U3VAppImagePresetCache *pPresetCache)
+{
+    T_U3VAppState nextState;
+
+    if ((pPresetCache->pixelFormat != U3V_CAM_CFG_PIXEL_FORMAT_SEL) ||
+        (pPresetCache->acquisitionMode != U3V_CAM_CFG_ACQ_MODE_SEL))
+    {
+        nextState = U3V_APP_STATE_SETUP_PIXEL_FORMAT;
+    }
+    else if (pPresetCache->payloadSize != u3vAppData.payloadSize)
+    {
+        nextState = U3V_APP_STATE_SETUP_U3V_STREAM_IF;
+    }
+    else
+    {
+        nextState = U3V_APP_STATE_READY_TO_START_IMG_ACQUISITION;
+    }
+
+    return nextState;
+}
+
+
+/**
+ * U3V App bring-up profile state transition.
+ * 
+ * This function shall be called on every App state change. While a bring-up 
+ * is in progress (from device attach to ready for image acquisition), the time
+ * and Control Interface traffic of the state left are accumulated to the 
+ * bring-up profile. When the bring-up completes, its total time is checked 
+ * against the cold start or warm reconnect budget.
+ * @param prevState state left
+ * @param nextState state entered
+ */
+static void U3VApp_ProfileStateTransition(T_U3VAppState prevState, T_U3VAppState nextState)
+{
+    T_U3VAppProfiler *pProfiler = &u3vAppData.profiler;
+    T_U3VAppStateProfile *pStateProfile;
+    T_U3VHostCtrlIfStats ctrlIfStats;
+    uint32_t budgetMs;
+    const uint32_t timeNowMs = U3V_GET_TIMESTAMP_MS();
+
+    U3VHost_GetCtrlIfStats(&ctrlIfStats);
+
+    if (pProfiler->isActive)
+    {
+        pStateProfile = &pProfiler->lastProfile.states[prevState];
+        pStateProfile->visits++;
+        pStateProfile->durationMs += timeNowMs - pProfiler->stateEntryMs;
+        pStateProfile->ctrlIfTransactions += ctrlIfStats.transactions - pProfiler->stateEntryStats.transactions;
+        pStateProfile->ctrlIfBytes += ctrlIfStats.bytesMoved - pProfiler->stateEntryStats.bytesMoved;
+    }
+
+    if (nextState == U3V_APP_STATE_OPEN_DEVICE)
+    {
+        /* device attached, start a new bring-up profile */
+        memset(&pProfiler->lastProfile, 0, sizeof(pProfiler->lastProfile));
+        pProfiler->lastProfile.isWarmReconnect = (pProfiler->bringUpCount > 0U);
+        pProfiler->startMs = timeNowMs;
+        pProfiler->isActive = true;
+    }
+    else if (pProfiler->isActive && (nextState == U3V_APP_STATE_READY_TO_START_IMG_ACQUISITION))
+    {
+        pProfiler->isActive = false;
+        pProfiler->bringUpCount++;
+        pProfiler->lastProfile.totalDurationMs = timeNowMs - pProfiler->startMs;
+        pProfiler->lastProfile.isComplete = true;
+        budgetMs = (pProfiler->lastProfile.isWarmReconnect) ? U3V_BRINGUP_WARM_RECONNECT_BUDGET_MS : U3V_BRINGUP_COLD_START_BUDGET_MS;
+        if ((budgetMs > 0U) && (pProfiler->lastProfile.totalDurationMs > budgetMs))
+        {
+            reportError(U3V_DRV_ERR_BRINGUP_BUDGET_EXCEEDED);
+        }
+    }
+    else if (pProfiler->isActive && ((nextState == U3V_APP_STATE_WAIT_FOR_DEVICE_ATTACH) || (nextState == U3V_APP_STATE_ERROR)))
+    {
+        /* bring-up aborted by detach or failure, keep the partial profile */
+        pProfiler->isActive = false;
+    }
+
+    pProfiler->stateEntryMs = timeNowMs;
+    pProfiler->stateEntryStats = ctrlIfStats;
+}
+
+
+/**
+ * U3V App recovery start.
+ * 
+ * Records a detected fault and starts the recovery time measurement, unless a
+ * recovery is already in progress (the time is then accounted to the fault
+ * that started it).
+ * @param fault 
+ * @param frameLost true if the fault lost the image frame in transfer
+ */
+static void U3VApp_RecoveryStart(T_U3VAppFaultType fault, bool frameLost)
+{
+    T_U3VAppRecovery *pRecovery = &u3vAppData.recovery;
+
+    pRecovery->stats.fault[fault].faults++;
+    pRecovery->stats.fault[fault].framesLost += (frameLost) ? 1U : 0U;
+
+    if (!pRecovery->isActive && (fault != U3V_APP_FAULT_PAYLOAD_TRUNCATED))
+    {
+        pRecovery->isActive = true;
+        pRecovery->activeFault = fault;
+        pRecovery->startMs = U3V_GET_TIMESTAMP_MS();
+    }
+}
+
+
+/**
+ * U3V App recovery state transition.
+ * 
+ * This function shall be called on every App state change. Entering the error
+ * state records a failed step fault, reaching the ready for image acquisition 
+ * state completes an active recovery.
+ * @param prevState state left
+ * @param nextState state entered
+ */
+static void U3VApp_RecoveryStateTransition(T_U3VAppState prevState, T_U3VAppState nextState)
+{
+    T_U3VAppRecovery *pRecovery = &u3vAppData.recovery;
+    T_U3VAppFaultStats *pFaultStats;
+    uint32_t recoveryMs;
+
+    if (nextState == U3V_APP_STATE_ERROR)
+    {
+        pRecovery->failedState = prevState;
+        U3VApp_RecoveryStart(U3V_APP_FAULT_STEP_FAIL, (prevState == U3V_APP_STATE_WAIT_TO_ACQUIRE_IMAGE));
+    }
+    else if (pRecovery->isActive && (nextState == U3V_APP_STATE_READY_TO_START_IMG_ACQUISITION))
+    {
+        recoveryMs = U3V_GET_TIMESTAMP_MS() - pRecovery->startMs;
+        pFaultStats = &pRecovery->stats.fault[pRecovery->activeFault];
+        pFaultStats->recoveries++;
+        pFaultStats->totalRecoveryMs += recoveryMs;
+        pFaultStats->maxRecoveryMs = (recoveryMs > pFaultStats->maxRecoveryMs) ? recoveryMs : pFaultStats->maxRecoveryMs;
+        pRecovery->isActive = false;
+        pRecovery->retries = 0U;
+        pRecovery->retriesExhausted = false;
+    }
+}
+
+
 /**
  * U3V App  U3V Host event handler callback.
  * 
@@ -807,25 +1398,42 @@ static T_U3VHostEventResponse U3VApp_HostEventHandlerCbk(T_U3VHostHandle u3vObjH
     switch (event)
     {
         case U3V_HOST_EVENT_IMG_PLD_RECEIVED:
+            if (readCompleteEventData->result != U3V_HOST_RESULT_SUCCESS)
+            {
+                /* failed transfer, no valid data, handled by the App stream recovery */
+                pUsbU3VAppData->recovery.streamFaultResult = readCompleteEventData->result;
+                pUsbU3VAppData->recovery.streamFault = true;
+                break;
+            }
+            U3VBufPool_CompleteDeviceWrite(pUsbU3VAppData->appImgDataBfr, readCompleteEventData->length);
             pckLeaderOrTrailer = (T_U3VSiGenericPacket*)pUsbU3VAppData->appImgDataBfr;
             pUsbU3VAppData->appImgBlockCounter++;
             if (pckLeaderOrTrailer->magicKey == (uint32_t)U3V_LEADER_MGK_PREFIX)
             {
                 /* Img Leader packet received */
+                if (pUsbU3VAppData->trigger.isTriggered)
+                {
+                    pUsbU3VAppData->trigger.lastLatencyUs = U3V_GET_TIMESTAMP_US() - pUsbU3VAppData->trigger.triggerTimeUs;
+                    pUsbU3VAppData->trigger.latencyIsValid = true;
+                    pUsbU3VAppData->trigger.isTriggered = false;
+                }
                 pUsbU3VAppData->appImgTransfState = U3V_SI_IMG_TRANSF_STATE_LEADER_COMPLETE;
                 appPldTransfEvent = U3V_CAM_DRV_IMG_LEADER_DATA;
                 pUsbU3VAppData->appImgBlockCounter = UINT32_C(0);
+                pUsbU3VAppData->recovery.frameBytes = UINT32_C(0);
             }
             else if (pckLeaderOrTrailer->magicKey == (uint32_t)U3V_TRAILER_MGK_PREFIX)
             {
-                /* Img Trailer packet received, end of transfer */
+                /* Img Trailer packet received, end of transfer, a short image is flagged to the app as incomplete */
                 pUsbU3VAppData->appImgTransfState = U3V_SI_IMG_TRANSF_STATE_TRAILER_COMPLETE;
-                appPldTransfEvent = U3V_CAM_DRV_IMG_TRAILER_DATA;
+                appPldTransfEvent = (pUsbU3VAppData->recovery.frameBytes < pUsbU3VAppData->payloadSize) ?
+                                    U3V_CAM_DRV_IMG_TRAILER_DATA_INCOMPLETE : U3V_CAM_DRV_IMG_TRAILER_DATA;
             }
             else
             {
                 /* Img Payload block with Image data */
                 appPldTransfEvent = U3V_CAM_DRV_IMG_PAYLOAD_DATA;
+                pUsbU3VAppData->recovery.frameBytes += (uint32_t)readCompleteEventData->length;
             }
             if (u3vAppData.appImgEvtCbk != NULL)
             {
@@ -836,6 +1444,13 @@ static T_U3VHostEventResponse U3VApp_HostEventHandlerCbk(T_U3VHostHandle u3vObjH
             }
             break;
 
+        case U3V_HOST_EVENT_STREAM_HALT_CLEARED:
+            if (readCompleteEventData->result == U3V_HOST_RESULT_SUCCESS)
+            {
+                pUsbU3VAppData->recovery.haltClearDone = true;
+            }
+            break;
+
         /* not used cases, fallthrough */
         case U3V_HOST_EVENT_WRITE_COMPLETE:
         case U3V_HOST_EVENT_READ_COMPLETE:
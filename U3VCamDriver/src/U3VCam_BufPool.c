@@ -0,0 +1,155 @@
+
+#include "U3VCam_BufPool.h"
+
+#include "device.h"
+
+
+
+/*******************************************************************************
+* Local function declarations
+*******************************************************************************/
+
+static inline int32_t U3VBufPool_GetBlockIndex(const void *pBuffer);
+
+static inline size_t U3VBufPool_DCacheLinesSize(size_t size);
+
+
+/*******************************************************************************
+* Constant & Variable declarations
+*******************************************************************************/
+
+U3V_STATIC_ASSERT(((U3V_DCACHE_LINE_SIZE & (U3V_DCACHE_LINE_SIZE - 1U)) == 0U), "U3V_DCACHE_LINE_SIZE must be a power of 2");
+U3V_STATIC_ASSERT((U3V_BUF_POOL_BLOCKS_NUMBER > 0U), "U3V_BUF_POOL_BLOCKS_NUMBER must not be 0");
+U3V_STATIC_ASSERT(((U3V_PAYLD_BLOCK_MAX_SIZE % U3V_DCACHE_LINE_SIZE) == 0U), "U3V_PAYLD_BLOCK_MAX_SIZE must be a multiple of U3V_DCACHE_LINE_SIZE");
+
+static uint8_t u3vBufPool_Blocks[U3V_BUF_POOL_BLOCKS_NUMBER][U3V_BUF_POOL_BLOCK_SIZE] __attribute__((aligned(U3V_DCACHE_LINE_SIZE))) U3V_BUF_POOL_SECTION_ATTR;
+
+static bool u3vBufPool_BlockInUse[U3V_BUF_POOL_BLOCKS_NUMBER];
+
+
+/*******************************************************************************
+* Function definitions
+*******************************************************************************/
+
+void *U3VBufPool_Alloc(void)
+{
+    void *pBuffer = NULL;
+
+    for (uint32_t idx = 0U; idx < U3V_BUF_POOL_BLOCKS_NUMBER; idx++)
+    {
+        if (!u3vBufPool_BlockInUse[idx])
+        {
+            u3vBufPool_BlockInUse[idx] = true;
+            pBuffer = u3vBufPool_Blocks[idx];
+            break;
+        }
+    }
+
+    return pBuffer;
+}
+
+
+void U3VBufPool_Free(void *pBuffer)
+{
+    int32_t idx = U3VBufPool_GetBlockIndex(pBuffer);
+
+    if (idx >= 0)
+    {
+        u3vBufPool_BlockInUse[idx] = false;
+    }
+}
+
+
+uint32_t U3VBufPool_GetFreeBlocksNumber(void)
+{
+    uint32_t freeBlocks = 0U;
+
+    for (uint32_t idx = 0U; idx < U3V_BUF_POOL_BLOCKS_NUMBER; idx++)
+    {
+        freeBlocks += (u3vBufPool_BlockInUse[idx]) ? 0U : 1U;
+    }
+
+    return freeBlocks;
+}
+
+
+bool U3VBufPool_IsCacheMaintenanceNeeded(const void *pBuffer)
+{
+    bool maintNeeded = true;
+
+#if (U3V_DTCM_SIZE > 0U)
+    uintptr_t address = (uintptr_t)pBuffer;
+
+    if ((address >= U3V_DTCM_BASE_ADDR) && ((address - U3V_DTCM_BASE_ADDR) < U3V_DTCM_SIZE))
+    {
+        /* TCM is not cached */
+        maintNeeded = false;
+    }
+    else
+#endif
+    if (U3V_BUF_POOL_NONCACHEABLE && (U3VBufPool_GetBlockIndex(pBuffer) >= 0))
+    {
+        maintNeeded = false;
+    }
+
+    return maintNeeded;
+}
+
+
+void U3VBufPool_PrepareForDeviceWrite(void *pBuffer, size_t size)
+{
+    if ((pBuffer != NULL) && (size > 0U) && U3VBufPool_IsCacheMaintenanceNeeded(pBuffer))
+    {
+        U3V_DCACHE_INVALIDATE_BY_ADDR(pBuffer, U3VBufPool_DCacheLinesSize(size));
+    }
+}
+
+
+void U3VBufPool_CompleteDeviceWrite(void *pBuffer, size_t size)
+{
+    if ((pBuffer != NULL) && (size > 0U) && U3VBufPool_IsCacheMaintenanceNeeded(pBuffer))
+    {
+        U3V_DCACHE_INVALIDATE_BY_ADDR(pBuffer, U3VBufPool_DCacheLinesSize(size));
+    }
+}
+
+
+/*******************************************************************************
+* Local function definitions
+*******************************************************************************/
+
+/**
+ * U3V buffer pool get block index.
+ *
+ * @param pBuffer
+ * @return int32_t Index of the pool block starting at pBuffer, or -1 if the
+ * pointer is not the start of a pool block.
+ */
+static inline int32_t U3VBufPool_GetBlockIndex(const void *pBuffer)
+{
+    int32_t blockIdx = -1;
+
+    for (uint32_t idx = 0U; idx < U3V_BUF_POOL_BLOCKS_NUMBER; idx++)
+    {
+        if (pBuffer == (const void *)u3vBufPool_Blocks[idx])
+        {
+            blockIdx = (int32_t)idx;
+            break;
+        }
+    }
+
+    return blockIdx;
+}
+
+
+/**
+ * U3V buffer size rounded up to whole data cache lines.
+ *
+ * @param size
+ * @return size_t
+ */
+static inline size_t U3VBufPool_DCacheLinesSize(size_t size)
+{
+    return (size + U3V_DCACHE_LINE_SIZE - 1U) & ~(U3V_DCACHE_LINE_SIZE - 1U);
+}
+
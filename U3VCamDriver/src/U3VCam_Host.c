@@ -74,6 +74,10 @@ static inline uint32_t U3VHost_GCDu32(uint32_t n1, uint32_t n2);
 
 static inline uint32_t U3VHost_LCMu32(uint32_t n1, uint32_t n2);
 
+#if (U3V_HOST_FAULT_INJECTION_ENABLE == true)
+static bool U3VHost_FaultInjectionApply(T_U3VHostInstanceObj *u3vInstance, T_U3VHostEvent u3vEvent, T_U3VHostEventReadCompleteData *pTransfData);
+#endif
+
 
 /*******************************************************************************
 * Constant & Variable declarations
@@ -83,6 +87,8 @@ static T_U3VHostInstanceObj gUSBHostU3VObj[U3V_HOST_INSTANCES_NUMBER];
 
 static T_U3VHostAttachListenerObj gUSBHostU3VAttachListener[U3V_HOST_ATTACH_LISTENERS_NUMBER];
 
+static T_U3VHostCtrlIfStats gUSBHostU3VCtrlIfStats;
+
 USB_HOST_CLIENT_DRIVER gUSBHostU3VClientDriver =
 {
     .initialize             = U3VHost_Initialize,
@@ -320,6 +326,8 @@ T_U3VHostResult U3VHost_ReadMemRegIntegerValue(T_U3VHostHandle u3vObjHandle, T_U
             case U3V_MEM_REG_INT_ACQ_START:
             case U3V_MEM_REG_INT_ACQ_STOP:
             case U3V_MEM_REG_INT_DEVICE_RESET:
+            case U3V_MEM_REG_INT_TRIGGER_MODE:
+            case U3V_MEM_REG_INT_TRIGGER_SOFTWARE:
             default:
                 u3vResult = U3V_HOST_RESULT_INVALID_PARAMETER;
                 break;
@@ -393,6 +401,18 @@ T_U3VHostResult U3VHost_WriteMemRegIntegerValue(T_U3VHostHandle u3vObjHandle, T_
                 regValue = U3V_SET_PIXEL_FORMAT_CONV(regVal);
                 break;
 
+            case U3V_MEM_REG_INT_TRIGGER_MODE:
+                regAddr = U3V_CAM_CFG_REG_BASE_ADR + U3V_CAM_CFG_TRIGGER_MODE_REG_ADR;
+                regValue = U3V_SET_TRIGGER_MODE_CONV(regVal);
+                u3vResult = (U3V_CAM_CFG_TRIGGER_SUPPORTED) ? u3vResult : U3V_HOST_RESULT_INVALID_PARAMETER;
+                break;
+
+            case U3V_MEM_REG_INT_TRIGGER_SOFTWARE:
+                regAddr = U3V_CAM_CFG_REG_BASE_ADR + U3V_CAM_CFG_TRIGGER_SOFTWARE_REG_ADR;
+                regValue = U3V_SET_TRIGGER_SOFTWARE_CONV(regVal);
+                u3vResult = (U3V_CAM_CFG_TRIGGER_SUPPORTED) ? u3vResult : U3V_HOST_RESULT_INVALID_PARAMETER;
+                break;
+
             /* N/A, fallthrough */
             case U3V_MEM_REG_INT_PAYLOAD_SIZE:
             default:
@@ -764,6 +784,73 @@ T_U3VHostResult U3VHost_StartImgPayldTransfer(T_U3VHostHandle u3vObjHandle, void
 }
 
 
+T_U3VHostResult U3VHost_StreamIfClearHalt(T_U3VHostHandle u3vObjHandle)
+{
+    USB_HOST_RESULT hostResult;
+    T_U3VHostResult u3vResult = U3V_HOST_RESULT_SUCCESS;
+    T_U3VHostInstanceObj *u3vInstance = (T_U3VHostInstanceObj *)u3vObjHandle;
+    USB_HOST_REQUEST_HANDLE requestHandle;
+
+    u3vResult = (u3vInstance == NULL) ? U3V_HOST_RESULT_DEVICE_UNKNOWN : u3vResult;
+
+    if (u3vResult != U3V_HOST_RESULT_SUCCESS)
+    {
+        return u3vResult;
+    }
+
+    u3vResult = (u3vInstance->streamIfHandle.bulkInPipeHandle == USB_HOST_PIPE_HANDLE_INVALID) ? U3V_HOST_RESULT_DEVICE_UNKNOWN : u3vResult;
+
+    if (u3vResult != U3V_HOST_RESULT_SUCCESS)
+    {
+        return u3vResult;
+    }
+
+    hostResult = USB_HOST_DevicePipeHaltClear(u3vInstance->streamIfHandle.ifHandle,
+                                              &requestHandle,
+                                              u3vInstance->streamIfHandle.bulkInEpAddr,
+                                              (uintptr_t)U3V_HOST_EVENT_STREAM_HALT_CLEARED);
+
+    u3vResult = U3VHost_HostToU3VResultsMap(hostResult);
+
+    return u3vResult;
+}
+
+
+void U3VHost_GetCtrlIfStats(T_U3VHostCtrlIfStats *pStats)
+{
+    if (pStats != NULL)
+    {
+        /* the counters are updated by the transfer complete callback */
+        taskENTER_CRITICAL();
+        *pStats = gUSBHostU3VCtrlIfStats;
+        taskEXIT_CRITICAL();
+    }
+}
+
+
+#if (U3V_HOST_FAULT_INJECTION_ENABLE == true)
+T_U3VHostResult U3VHost_InjectFault(T_U3VHostHandle u3vObjHandle, T_U3VHostFault fault, uint32_t skipEvents)
+{
+    T_U3VHostResult u3vResult = U3V_HOST_RESULT_SUCCESS;
+    T_U3VHostInstanceObj *u3vInstance = (T_U3VHostInstanceObj *)u3vObjHandle;
+
+    u3vResult = (u3vInstance == NULL)                ? U3V_HOST_RESULT_DEVICE_UNKNOWN    : u3vResult;
+    u3vResult = (fault > U3V_HOST_FAULT_DETACH)      ? U3V_HOST_RESULT_INVALID_PARAMETER : u3vResult;
+
+    if (u3vResult != U3V_HOST_RESULT_SUCCESS)
+    {
+        return u3vResult;
+    }
+
+    u3vInstance->injFault = U3V_HOST_FAULT_NONE;
+    u3vInstance->injFaultSkipEvents = skipEvents;
+    u3vInstance->injFault = fault;
+
+    return u3vResult;
+}
+#endif
+
+
 T_U3VHostResult U3VHost_CtrlIf_InterfaceCreate(T_U3VHostHandle u3vObjHandle)
 {
     T_U3VHostResult u3vResult = U3V_HOST_RESULT_SUCCESS;
@@ -921,7 +1008,13 @@ static void U3VHost_Initialize(void * data)
         u3vInstance->streamIfHandle.ifHandle = USB_HOST_DEVICE_OBJ_HANDLE_INVALID;
         u3vInstance->streamIfHandle.bulkInPipeHandle = USB_HOST_PIPE_HANDLE_INVALID;
         u3vInstance->streamIfHandle.bulkOutPipeHandle = USB_HOST_PIPE_HANDLE_INVALID;  /* N/A */
+        u3vInstance->streamIfHandle.bulkInEpAddr = 0U;
 
+#if (U3V_HOST_FAULT_INJECTION_ENABLE == true)
+        u3vInstance->injFault = U3V_HOST_FAULT_NONE;
+        u3vInstance->injFaultSkipEvents = UINT32_C(0);
+        u3vInstance->injDetachPending = false;
+#endif
     }
 }
 
@@ -1105,6 +1198,7 @@ static void U3VHost_InterfaceAssign(USB_HOST_DEVICE_INTERFACE_HANDLE *interfaces
                         {
                             u3vInstance->streamIfHandle.bulkInPipeHandle = USB_HOST_DevicePipeOpen(u3vInstance->streamIfHandle.ifHandle,
                                                                                                    endpointDescriptor->bEndpointAddress);
+                            u3vInstance->streamIfHandle.bulkInEpAddr = endpointDescriptor->bEndpointAddress;
                         }
                         else
                         {
@@ -1219,6 +1313,7 @@ static USB_HOST_DEVICE_INTERFACE_EVENT_RESPONSE U3VHost_InterfaceEventHandler(US
     const uint32_t index = U3VHost_InterfaceHandleToInstance(interfaceHandle);
     const T_U3VHostEvent u3vEvent = (T_U3VHostEvent)(context);
     USB_HOST_DEVICE_INTERFACE_EVENT_TRANSFER_COMPLETE_DATA *dataTransferEvent;
+    USB_HOST_DEVICE_INTERFACE_EVENT_PIPE_HALT_CLEAR_COMPLETE_DATA *haltClearEvent;
     T_U3VHostEventWriteCompleteData u3vTransferCompleteData;
  
     u3vInstance = &gUSBHostU3VObj[index];
@@ -1231,6 +1326,14 @@ static USB_HOST_DEVICE_INTERFACE_EVENT_RESPONSE U3VHost_InterfaceEventHandler(US
             u3vTransferCompleteData.result = U3VHost_HostToU3VResultsMap(dataTransferEvent->result);
             u3vTransferCompleteData.length = dataTransferEvent->length;
 
+#if (U3V_HOST_FAULT_INJECTION_ENABLE == true)
+            if (!U3VHost_FaultInjectionApply(u3vInstance, u3vEvent, &u3vTransferCompleteData))
+            {
+                /* event dropped by injected fault */
+                break;
+            }
+#endif
+
             /* update Control IF transf status indicators */
             if (u3vInstance->controlIfObj.transfReqCompleteCbk != NULL)
             {
@@ -1243,9 +1346,20 @@ static USB_HOST_DEVICE_INTERFACE_EVENT_RESPONSE U3VHost_InterfaceEventHandler(US
             }
             break;
 
+        case USB_HOST_DEVICE_INTERFACE_EVENT_PIPE_HALT_CLEAR_COMPLETE:
+            haltClearEvent = (USB_HOST_DEVICE_INTERFACE_EVENT_PIPE_HALT_CLEAR_COMPLETE_DATA *)(eventData);
+            u3vTransferCompleteData.transferHandle = U3V_HOST_TRANSFER_HANDLE_INVALID;
+            u3vTransferCompleteData.result = U3VHost_HostToU3VResultsMap(haltClearEvent->result);
+            u3vTransferCompleteData.length = 0U;
+
+            if (u3vInstance->eventHandler != NULL)
+            {
+                u3vInstance->eventHandler((T_U3VHostHandle)u3vInstance, u3vEvent, &u3vTransferCompleteData, u3vInstance->context);
+            }
+            break;
+
         /* not used cases, fallthrough */
         case USB_HOST_DEVICE_INTERFACE_EVENT_SET_INTERFACE_COMPLETE:
-        case USB_HOST_DEVICE_INTERFACE_EVENT_PIPE_HALT_CLEAR_COMPLETE:
         default:
             break;
     }
@@ -1260,11 +1374,42 @@ static USB_HOST_DEVICE_INTERFACE_EVENT_RESPONSE U3VHost_InterfaceEventHandler(US
  * Local function used as a routine to handle interface related tasks. Used as a
  * callback by the USB Host layer.
  * @param interfaceHandle
- * @note Not applicable, used as a placeholder for gUSBHostU3VClientDriver.
+ * @note Only used to apply an injected detach (U3V_HOST_FAULT_DETACH) out of the
+ * pipe callback, a placeholder for gUSBHostU3VClientDriver otherwise.
  */
 static void U3VHost_InterfaceTasks(USB_HOST_DEVICE_INTERFACE_HANDLE interfaceHandle)
 {
-    /* N/A */
+#if (U3V_HOST_FAULT_INJECTION_ENABLE == true)
+    T_U3VHostInstanceObj *u3vInstance;
+    const uint32_t index = U3VHost_InterfaceHandleToInstance(interfaceHandle);
+    USB_HOST_DEVICE_INTERFACE_HANDLE ifHandles[3];
+
+    if ((index < UINT32_MAX) && gUSBHostU3VObj[index].injDetachPending)
+    {
+        /* injected detach: the instance is released as on a real detach (pipes closed, detach listener called),
+         * then its interfaces are handed back to the USB Host layer, which assigns them again to this client
+         * driver as on a re-attach (U3VHost_InterfaceAssign, attach listeners called) */
+        u3vInstance = &gUSBHostU3VObj[index];
+        u3vInstance->injDetachPending = false;
+        ifHandles[0] = u3vInstance->controlIfHandle.ifHandle;
+        ifHandles[1] = u3vInstance->eventIfHandle.ifHandle;
+        ifHandles[2] = u3vInstance->streamIfHandle.ifHandle;
+
+        U3VHost_InterfaceRelease(interfaceHandle);
+
+        u3vInstance->controlIfHandle.ifHandle = USB_HOST_DEVICE_OBJ_HANDLE_INVALID;
+        u3vInstance->eventIfHandle.ifHandle = USB_HOST_DEVICE_OBJ_HANDLE_INVALID;
+        u3vInstance->streamIfHandle.ifHandle = USB_HOST_DEVICE_OBJ_HANDLE_INVALID;
+
+        for (uint32_t iterator = UINT32_C(0); iterator < (sizeof(ifHandles) / sizeof(ifHandles[0])); iterator++)
+        {
+            if (ifHandles[iterator] != USB_HOST_DEVICE_OBJ_HANDLE_INVALID)
+            {
+                USB_HOST_DeviceInterfaceRelease(ifHandles[iterator]);
+            }
+        }
+    }
+#endif
 }
 
 
@@ -2042,11 +2187,14 @@ static void U3VHost_CtrlIfTransferReqCompleteCbk(T_U3VHostHandle u3vObjHandle, T
             case U3V_HOST_EVENT_READ_COMPLETE:
                 readCompleteEventData = (T_U3VHostEventReadCompleteData *)transfData;
                 ctrlIfInstance->readReqSts = *readCompleteEventData;
+                gUSBHostU3VCtrlIfStats.bytesMoved += (uint32_t)readCompleteEventData->length;
                 break;
 
             case U3V_HOST_EVENT_WRITE_COMPLETE:
                 writeCompleteEventData = (T_U3VHostEventWriteCompleteData *)transfData;
                 ctrlIfInstance->writeReqSts = *writeCompleteEventData;
+                gUSBHostU3VCtrlIfStats.transactions++;
+                gUSBHostU3VCtrlIfStats.bytesMoved += (uint32_t)writeCompleteEventData->length;
                 break;
 
             default:
@@ -2115,3 +2263,79 @@ static inline uint32_t U3VHost_LCMu32(uint32_t n1, uint32_t n2)
     return res;
 }
 
+
+#if (U3V_HOST_FAULT_INJECTION_ENABLE == true)
+/**
+ * U3V Host fault injection apply.
+ * 
+ * Local function that applies the armed injected fault (if any) on a transfer
+ * complete event, before it is delivered to the Control IF and the application.
+ * @param u3vInstance 
+ * @param u3vEvent 
+ * @param pTransfData transfer data, modified by the fault
+ * @return true if the event shall be delivered, false if it is dropped
+ */
+static bool U3VHost_FaultInjectionApply(T_U3VHostInstanceObj *u3vInstance, T_U3VHostEvent u3vEvent, T_U3VHostEventReadCompleteData *pTransfData)
+{
+    bool deliverEvent = true;
+    bool faultMatch;
+
+    switch (u3vInstance->injFault)
+    {
+        case U3V_HOST_FAULT_DROP_ACK:
+            faultMatch = (u3vEvent == U3V_HOST_EVENT_READ_COMPLETE);
+            break;
+
+        case U3V_HOST_FAULT_TRUNCATE_PAYLOAD:
+        case U3V_HOST_FAULT_STALL_PIPE:
+        case U3V_HOST_FAULT_DETACH:
+            faultMatch = (u3vEvent == U3V_HOST_EVENT_IMG_PLD_RECEIVED);
+            break;
+
+        case U3V_HOST_FAULT_NONE:
+        default:
+            faultMatch = false;
+            break;
+    }
+
+    if (faultMatch && (u3vInstance->injFaultSkipEvents > 0U))
+    {
+        u3vInstance->injFaultSkipEvents--;
+        faultMatch = false;
+    }
+
+    if (faultMatch)
+    {
+        switch (u3vInstance->injFault)
+        {
+            case U3V_HOST_FAULT_DROP_ACK:
+                deliverEvent = false;
+                break;
+
+            case U3V_HOST_FAULT_TRUNCATE_PAYLOAD:
+                pTransfData->length /= 2U;
+                break;
+
+            case U3V_HOST_FAULT_STALL_PIPE:
+                pTransfData->result = U3V_HOST_RESULT_REQUEST_STALLED;
+                pTransfData->length = 0U;
+                break;
+
+            case U3V_HOST_FAULT_DETACH:
+                /* the block is lost with the device, the pipes are closed and the interfaces re-assigned by the
+                 * host task (U3VHost_InterfaceTasks), not from this pipe callback */
+                deliverEvent = false;
+                u3vInstance->injDetachPending = true;
+                break;
+
+            case U3V_HOST_FAULT_NONE:
+            default:
+                break;
+        }
+        u3vInstance->injFault = U3V_HOST_FAULT_NONE;
+    }
+
+    return deliverEvent;
+}
+#endif
+
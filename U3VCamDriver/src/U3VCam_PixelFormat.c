@@ -0,0 +1,359 @@
+
+#include "U3VCam_PixelFormat.h"
+
+#include <string.h>
+
+
+
+/*******************************************************************************
+* Local function declarations
+*******************************************************************************/
+
+static inline void U3VPixFmt_Unpack12pPair(const uint8_t *src, uint16_t *dst);
+
+static inline void U3VPixFmt_RGB8ToYUVCell(const uint8_t *px00, const uint8_t *px01, const uint8_t *px10, const uint8_t *px11,
+                                           uint8_t *y00, uint8_t *y01, uint8_t *y10, uint8_t *y11, uint8_t *u, uint8_t *v);
+
+static inline uint8_t U3VPixFmt_RGB8ToLuma(const uint8_t *px);
+
+
+/*******************************************************************************
+* Constant & Variable declarations
+*******************************************************************************/
+
+/* word-parallel unpacking loads packed data as little-endian 32-bit words */
+#if defined(__BYTE_ORDER__) && (__BYTE_ORDER__ != __ORDER_LITTLE_ENDIAN__)
+    #error "U3VCam_PixelFormat requires a little-endian target"
+#endif
+
+
+/*******************************************************************************
+* Function definitions
+*******************************************************************************/
+
+size_t U3VPixFmt_Unpack12pTo16Block(T_U3VPixFmtUnpackCtx *pCtx, const uint8_t *src, size_t srcSize, uint16_t *dst)
+{
+    uint16_t *dstStart = dst;
+    uint8_t pair[3];
+    uint32_t w0, w1, w2;
+
+    if ((pCtx == NULL) || (src == NULL) || (dst == NULL))
+    {
+        return 0U;
+    }
+
+    /* complete the pixel pair split by the end of the previous block */
+    if (pCtx->carryLen > 0U)
+    {
+        while ((pCtx->carryLen < 2U) && (srcSize > 0U) && (srcSize < (size_t)(3U - pCtx->carryLen)))
+        {
+            pCtx->carry[pCtx->carryLen++] = *src++;
+            srcSize--;
+        }
+        if (srcSize >= (size_t)(3U - pCtx->carryLen))
+        {
+            memcpy(pair, pCtx->carry, pCtx->carryLen);
+            memcpy(&pair[pCtx->carryLen], src, 3U - pCtx->carryLen);
+            src += 3U - pCtx->carryLen;
+            srcSize -= 3U - pCtx->carryLen;
+            pCtx->carryLen = 0U;
+            U3VPixFmt_Unpack12pPair(pair, dst);
+            dst += 2;
+        }
+    }
+
+    /* bulk: 12 bytes = 8 pixels, bit offset of pixel i is (12 * i) */
+    while (srcSize >= 12U)
+    {
+        memcpy(&w0, &src[0], sizeof(w0));
+        memcpy(&w1, &src[4], sizeof(w1));
+        memcpy(&w2, &src[8], sizeof(w2));
+        dst[0] = (uint16_t)(w0 & 0xFFFU);
+        dst[1] = (uint16_t)((w0 >> 12) & 0xFFFU);
+        dst[2] = (uint16_t)((w0 >> 24) | ((w1 & 0x00FU) << 8));
+        dst[3] = (uint16_t)((w1 >> 4) & 0xFFFU);
+        dst[4] = (uint16_t)((w1 >> 16) & 0xFFFU);
+        dst[5] = (uint16_t)((w1 >> 28) | ((w2 & 0x0FFU) << 4));
+        dst[6] = (uint16_t)((w2 >> 8) & 0xFFFU);
+        dst[7] = (uint16_t)(w2 >> 20);
+        src += 12;
+        srcSize -= 12U;
+        dst += 8;
+    }
+
+    while (srcSize >= 3U)
+    {
+        U3VPixFmt_Unpack12pPair(src, dst);
+        src += 3;
+        srcSize -= 3U;
+        dst += 2;
+    }
+
+    /* keep the incomplete pixel pair for the next block */
+    if (srcSize > 0U)
+    {
+        memcpy(&pCtx->carry[pCtx->carryLen], src, srcSize);
+        pCtx->carryLen += (uint8_t)srcSize;
+    }
+
+    return (size_t)(dst - dstStart);
+}
+
+
+void U3VPixFmt_Unpack12pTo8(const uint8_t *src, size_t nPixels, uint8_t *dst)
+{
+    for (size_t i = 0U; i < (nPixels / 2U); i++)
+    {
+        /* keep bits [11:4] of each pixel */
+        dst[0] = (uint8_t)((src[0] >> 4) | (src[1] << 4));
+        dst[1] = src[2];
+        src += 3;
+        dst += 2;
+    }
+}
+
+
+void U3VPixFmt_BayerRG8ToRGB8NearestRowPair(const uint8_t *srcRow0, const uint8_t *srcRow1, size_t width, uint8_t *dstRow0, uint8_t *dstRow1)
+{
+    uint8_t r, g, b;
+
+    for (size_t x = 0U; x < width; x += 2U)
+    {
+        r = srcRow0[x];
+        g = (uint8_t)(((uint32_t)srcRow0[x + 1U] + srcRow1[x] + 1U) >> 1);
+        b = srcRow1[x + 1U];
+        dstRow0[0] = r; dstRow0[1] = g; dstRow0[2] = b;
+        dstRow0[3] = r; dstRow0[4] = g; dstRow0[5] = b;
+        dstRow1[0] = r; dstRow1[1] = g; dstRow1[2] = b;
+        dstRow1[3] = r; dstRow1[4] = g; dstRow1[5] = b;
+        dstRow0 += 6;
+        dstRow1 += 6;
+    }
+}
+
+
+void U3VPixFmt_BayerRG8ToRGB8BilinearLine(const uint8_t *srcPrev, const uint8_t *srcCurr, const uint8_t *srcNext, size_t width, bool evenRow, uint8_t *dst)
+{
+    const uint8_t *p = srcPrev;
+    const uint8_t *c = srcCurr;
+    const uint8_t *n = srcNext;
+    uint32_t cross, diag;
+    size_t xl, xr;
+
+    /* pixels are processed in pairs (even x, odd x), only the outer neighbour of each pair may need mirroring */
+    for (size_t x = 0U; x < width; x += 2U)
+    {
+        xl = (x > 0U) ? (x - 1U) : (x + 1U);
+        xr = ((x + 2U) < width) ? (x + 2U) : x;
+
+        /* even x: R site on even rows, G site on odd rows */
+        cross = (uint32_t)c[xl] + c[x + 1U] + p[x] + n[x];
+        diag  = (uint32_t)p[xl] + p[x + 1U] + n[xl] + n[x + 1U];
+        if (evenRow)
+        {
+            dst[0] = c[x];
+            dst[1] = (uint8_t)((cross + 2U) >> 2);
+            dst[2] = (uint8_t)((diag + 2U) >> 2);
+        }
+        else
+        {
+            dst[0] = (uint8_t)(((uint32_t)p[x] + n[x] + 1U) >> 1);
+            dst[1] = c[x];
+            dst[2] = (uint8_t)(((uint32_t)c[xl] + c[x + 1U] + 1U) >> 1);
+        }
+
+        /* odd x: G site on even rows, B site on odd rows */
+        cross = (uint32_t)c[x] + c[xr] + p[x + 1U] + n[x + 1U];
+        diag  = (uint32_t)p[x] + p[xr] + n[x] + n[xr];
+        if (evenRow)
+        {
+            dst[3] = (uint8_t)(((uint32_t)c[x] + c[xr] + 1U) >> 1);
+            dst[4] = c[x + 1U];
+            dst[5] = (uint8_t)(((uint32_t)p[x + 1U] + n[x + 1U] + 1U) >> 1);
+        }
+        else
+        {
+            dst[3] = (uint8_t)((diag + 2U) >> 2);
+            dst[4] = (uint8_t)((cross + 2U) >> 2);
+            dst[5] = c[x + 1U];
+        }
+
+        dst += 6;
+    }
+}
+
+
+void U3VPixFmt_RGB8ToYUV420RowPair(const uint8_t *srcRow0, const uint8_t *srcRow1, size_t width, uint8_t *dstY0, uint8_t *dstY1, uint8_t *dstU, uint8_t *dstV)
+{
+    for (size_t x = 0U; x < width; x += 2U)
+    {
+        U3VPixFmt_RGB8ToYUVCell(&srcRow0[0], &srcRow0[3], &srcRow1[0], &srcRow1[3],
+                                &dstY0[0], &dstY0[1], &dstY1[0], &dstY1[1], dstU, dstV);
+        srcRow0 += 6;
+        srcRow1 += 6;
+        dstY0 += 2;
+        dstY1 += 2;
+        dstU++;
+        dstV++;
+    }
+}
+
+
+bool U3VPixFmt_BayerRG8ToRGB8Frame(const uint8_t *src, size_t width, size_t height, bool bilinear, uint8_t *dst)
+{
+    const size_t dstStride = width * 3U;
+    size_t yPrev, yNext;
+
+    if ((src == NULL) || (dst == NULL) || (width < 2U) || (height < 2U) || ((width & 1U) != 0U) || ((height & 1U) != 0U))
+    {
+        return false;
+    }
+
+    if (bilinear)
+    {
+        for (size_t y = 0U; y < height; y++)
+        {
+            /* mirror the top and bottom border rows */
+            yPrev = (y > 0U) ? (y - 1U) : 1U;
+            yNext = ((y + 1U) < height) ? (y + 1U) : (height - 2U);
+            U3VPixFmt_BayerRG8ToRGB8BilinearLine(&src[yPrev * width], &src[y * width], &src[yNext * width],
+                                                 width, ((y & 1U) == 0U), &dst[y * dstStride]);
+        }
+    }
+    else
+    {
+        for (size_t y = 0U; y < height; y += 2U)
+        {
+            U3VPixFmt_BayerRG8ToRGB8NearestRowPair(&src[y * width], &src[(y + 1U) * width],
+                                                   width, &dst[y * dstStride], &dst[(y + 1U) * dstStride]);
+        }
+    }
+
+    return true;
+}
+
+
+bool U3VPixFmt_BayerRG12pToRGB8Frame(const uint8_t *src, size_t width, size_t height, bool bilinear, uint8_t *scratch, uint8_t *dst)
+{
+    const size_t srcStride = (width * 3U) / 2U;
+    const size_t dstStride = width * 3U;
+    size_t yPrev, yNext;
+
+    if ((src == NULL) || (dst == NULL) || (scratch == NULL) ||
+        (width < 2U) || (height < 2U) || ((width & 1U) != 0U) || ((height & 1U) != 0U))
+    {
+        return false;
+    }
+
+    if (bilinear)
+    {
+        /* scratch holds 3 unpacked rows, row y is kept in slot (y % 3) */
+        U3VPixFmt_Unpack12pTo8(&src[0], width, &scratch[0]);
+        U3VPixFmt_Unpack12pTo8(&src[srcStride], width, &scratch[width]);
+        for (size_t y = 0U; y < height; y++)
+        {
+            if ((y + 1U) < height)
+            {
+                U3VPixFmt_Unpack12pTo8(&src[(y + 1U) * srcStride], width, &scratch[((y + 1U) % 3U) * width]);
+            }
+            yPrev = (y > 0U) ? (y - 1U) : 1U;
+            yNext = ((y + 1U) < height) ? (y + 1U) : (height - 2U);
+            U3VPixFmt_BayerRG8ToRGB8BilinearLine(&scratch[(yPrev % 3U) * width], &scratch[(y % 3U) * width], &scratch[(yNext % 3U) * width],
+                                                 width, ((y & 1U) == 0U), &dst[y * dstStride]);
+        }
+    }
+    else
+    {
+        for (size_t y = 0U; y < height; y += 2U)
+        {
+            U3VPixFmt_Unpack12pTo8(&src[y * srcStride], width, &scratch[0]);
+            U3VPixFmt_Unpack12pTo8(&src[(y + 1U) * srcStride], width, &scratch[width]);
+            U3VPixFmt_BayerRG8ToRGB8NearestRowPair(&scratch[0], &scratch[width],
+                                                   width, &dst[y * dstStride], &dst[(y + 1U) * dstStride]);
+        }
+    }
+
+    return true;
+}
+
+
+bool U3VPixFmt_RGB8ToYUV420Frame(const uint8_t *src, size_t width, size_t height, uint8_t *dst)
+{
+    const size_t srcStride = width * 3U;
+    uint8_t *dstY;
+    uint8_t *dstU;
+    uint8_t *dstV;
+
+    if ((src == NULL) || (dst == NULL) || ((width & 1U) != 0U) || ((height & 1U) != 0U))
+    {
+        return false;
+    }
+
+    dstY = dst;
+    dstU = &dst[width * height];
+    dstV = &dst[(width * height) + ((width / 2U) * (height / 2U))];
+
+    for (size_t y = 0U; y < height; y += 2U)
+    {
+        U3VPixFmt_RGB8ToYUV420RowPair(&src[y * srcStride], &src[(y + 1U) * srcStride], width,
+                                      &dstY[y * width], &dstY[(y + 1U) * width],
+                                      &dstU[(y / 2U) * (width / 2U)], &dstV[(y / 2U) * (width / 2U)]);
+    }
+
+    return true;
+}
+
+
+/*******************************************************************************
+* Local function definitions
+*******************************************************************************/
+
+/**
+ * U3V pixel format 12-bit packed pixel pair unpack.
+ *
+ * @param src 3 packed bytes
+ * @param dst 2 unpacked pixels
+ */
+static inline void U3VPixFmt_Unpack12pPair(const uint8_t *src, uint16_t *dst)
+{
+    dst[0] = (uint16_t)(src[0] | ((uint16_t)(src[1] & 0x0FU) << 8));
+    dst[1] = (uint16_t)((src[1] >> 4) | ((uint16_t)src[2] << 4));
+}
+
+
+/**
+ * U3V pixel format RGB8 to luma (BT.601, limited range).
+ *
+ * @param px RGB8 pixel
+ * @return uint8_t
+ */
+static inline uint8_t U3VPixFmt_RGB8ToLuma(const uint8_t *px)
+{
+    return (uint8_t)((((66 * (int32_t)px[0]) + (129 * (int32_t)px[1]) + (25 * (int32_t)px[2]) + 128) >> 8) + 16);
+}
+
+
+/**
+ * U3V pixel format RGB8 2x2 cell to YUV420.
+ *
+ * Computes the luma of the 4 pixels of a cell and the chroma of their average
+ * colour (BT.601, limited range).
+ */
+static inline void U3VPixFmt_RGB8ToYUVCell(const uint8_t *px00, const uint8_t *px01, const uint8_t *px10, const uint8_t *px11,
+                                           uint8_t *y00, uint8_t *y01, uint8_t *y10, uint8_t *y11, uint8_t *u, uint8_t *v)
+{
+    int32_t r, g, b;
+
+    *y00 = U3VPixFmt_RGB8ToLuma(px00);
+    *y01 = U3VPixFmt_RGB8ToLuma(px01);
+    *y10 = U3VPixFmt_RGB8ToLuma(px10);
+    *y11 = U3VPixFmt_RGB8ToLuma(px11);
+
+    r = ((int32_t)px00[0] + px01[0] + px10[0] + px11[0] + 2) >> 2;
+    g = ((int32_t)px00[1] + px01[1] + px10[1] + px11[1] + 2) >> 2;
+    b = ((int32_t)px00[2] + px01[2] + px10[2] + px11[2] + 2) >> 2;
+
+    *u = (uint8_t)((((-38 * r) - (74 * g) + (112 * b) + 128) >> 8) + 128);
+    *v = (uint8_t)((((112 * r) - (94 * g) - (18 * b) + 128) >> 8) + 128);
+}
+
@@ -0,0 +1,479 @@
+
+#include <string.h>
+#include "U3VCam_WriteBehind.h"
+
+#include "device.h"
+
+
+
+/*******************************************************************************
+* Local type definitions
+*******************************************************************************/
+
+typedef enum
+{
+    U3V_WB_BUF_FREE,        /* available to the payload callback */
+    U3V_WB_BUF_READY        /* filled, waiting to be written */
+} T_U3VWbBufferState;
+
+typedef enum
+{
+    U3V_WB_FRAME_FREE,
+    U3V_WB_FRAME_OPEN,
+    U3V_WB_FRAME_CLOSED,
+    U3V_WB_FRAME_DURABLE,
+    U3V_WB_FRAME_INCOMPLETE     /* closed with rejected blocks, never durable */
+} T_U3VWbFrameState;
+
+typedef struct
+{
+    volatile T_U3VWbFrameState  state;
+    uint32_t                    frameId;
+    uint32_t                    startBlock;
+    uint32_t                    endBlock;
+    bool                        blocksRejected;
+} T_U3VWbFrame;
+
+
+/*******************************************************************************
+* Local function declarations
+*******************************************************************************/
+
+static void U3VWriteBehind_SealBuffer(void);
+
+static bool U3VWriteBehind_WriteBuffer(const uint8_t *pBuffer, uint32_t blockCount);
+
+static inline bool U3VWriteBehind_IsBlockWritten(uint32_t block);
+
+static inline bool U3VWriteBehind_IsFrameOverwritten(const T_U3VWbFrame *pFrame);
+
+static bool U3VWriteBehind_IsDurable(const T_U3VWbFrame *pFrame);
+
+static T_U3VWbFrame *U3VWriteBehind_FindFrame(uint32_t frameId);
+
+
+/*******************************************************************************
+* Constant & Variable declarations
+*******************************************************************************/
+
+U3V_STATIC_ASSERT((U3V_WRITE_BEHIND_BUFFERS_NUMBER > 1U), "U3V_WRITE_BEHIND_BUFFERS_NUMBER must be at least 2");
+U3V_STATIC_ASSERT((U3V_WRITE_BEHIND_FRAMES_NUMBER > 0U), "U3V_WRITE_BEHIND_FRAMES_NUMBER must not be 0");
+U3V_STATIC_ASSERT(((U3V_WRITE_BEHIND_BUFFER_SIZE % U3V_DCACHE_LINE_SIZE) == 0U), "U3V_WRITE_BEHIND_BUFFER_SIZE must be a multiple of U3V_DCACHE_LINE_SIZE");
+U3V_STATIC_ASSERT((U3V_WRITE_BEHIND_BUFFER_SIZE >= U3V_PAYLD_BLOCK_MAX_SIZE), "U3V_WRITE_BEHIND_BUFFER_SIZE must hold a payload block");
+
+static uint8_t u3vWb_Buffers[U3V_WRITE_BEHIND_BUFFERS_NUMBER][U3V_WRITE_BEHIND_BUFFER_SIZE] __attribute__((aligned(U3V_DCACHE_LINE_SIZE)));
+
+static volatile T_U3VWbBufferState u3vWb_BufferState[U3V_WRITE_BEHIND_BUFFERS_NUMBER];
+
+static uint32_t u3vWb_BufferFill[U3V_WRITE_BEHIND_BUFFERS_NUMBER];
+
+/* Producer (payload callback) side */
+static uint32_t u3vWb_FillIdx;
+
+static uint32_t u3vWb_SealedBlocks;
+
+static uint32_t u3vWb_FrameIdx;
+
+static bool u3vWb_FrameOpen;
+
+static bool u3vWb_FrameRejected;
+
+/* Consumer (storage task) side */
+static uint32_t u3vWb_FlushIdx;
+
+static volatile uint32_t u3vWb_WrittenBlocks;
+
+static T_U3VWbFrame u3vWb_Frames[U3V_WRITE_BEHIND_FRAMES_NUMBER];
+
+static T_U3VWriteBehindBlockDevice u3vWb_Device;
+
+static T_U3VWriteBehindStats u3vWb_Stats;
+
+
+/*******************************************************************************
+* Function definitions
+*******************************************************************************/
+
+T_U3VWriteBehindResult U3VWriteBehind_Initialize(const T_U3VWriteBehindBlockDevice *pBlockDevice)
+{
+    if ((pBlockDevice == NULL) || (pBlockDevice->write == NULL) || (pBlockDevice->blockSize == 0U) ||
+        ((U3V_WRITE_BEHIND_BUFFER_SIZE % pBlockDevice->blockSize) != 0U) ||
+        (pBlockDevice->lbaCount < (U3V_WRITE_BEHIND_BUFFER_SIZE / pBlockDevice->blockSize)))
+    {
+        return U3V_WB_RESULT_INVALID_PARAMETER;
+    }
+
+    u3vWb_Device = *pBlockDevice;
+
+    for (uint32_t idx = 0U; idx < U3V_WRITE_BEHIND_BUFFERS_NUMBER; idx++)
+    {
+        u3vWb_BufferState[idx] = U3V_WB_BUF_FREE;
+        u3vWb_BufferFill[idx] = 0U;
+    }
+    for (uint32_t idx = 0U; idx < U3V_WRITE_BEHIND_FRAMES_NUMBER; idx++)
+    {
+        u3vWb_Frames[idx].state = U3V_WB_FRAME_FREE;
+    }
+
+    u3vWb_FillIdx = 0U;
+    u3vWb_FlushIdx = 0U;
+    u3vWb_SealedBlocks = 0U;
+    u3vWb_WrittenBlocks = 0U;
+    u3vWb_FrameIdx = 0U;
+    u3vWb_FrameOpen = false;
+    u3vWb_FrameRejected = false;
+    memset(&u3vWb_Stats, 0, sizeof(u3vWb_Stats));
+
+    return U3V_WB_RESULT_SUCCESS;
+}
+
+
+T_U3VWriteBehindResult U3VWriteBehind_BeginFrame(uint32_t frameId)
+{
+    T_U3VWbFrame *pFrame;
+    uint32_t frameIdx;
+
+    if (u3vWb_FrameOpen)
+    {
+        /* previous frame was not completed (missing trailer), stop tracking it,
+         * its data is still written */
+        u3vWb_Frames[u3vWb_FrameIdx].state = U3V_WB_FRAME_FREE;
+        u3vWb_FrameOpen = false;
+        U3VWriteBehind_SealBuffer();
+    }
+
+    frameIdx = (u3vWb_FrameIdx + 1U) % U3V_WRITE_BEHIND_FRAMES_NUMBER;
+    pFrame = &u3vWb_Frames[frameIdx];
+
+    if (pFrame->state == U3V_WB_FRAME_CLOSED)
+    {
+        /* oldest tracked frame is not durable yet, the whole frame is rejected,
+         * its blocks are refused up to the end of the frame */
+        u3vWb_FrameRejected = true;
+        u3vWb_Stats.framesRejected++;
+        return U3V_WB_RESULT_NO_SPACE;
+    }
+
+    u3vWb_FrameRejected = false;
+    u3vWb_FrameIdx = frameIdx;
+    pFrame->frameId = frameId;
+    pFrame->startBlock = u3vWb_SealedBlocks;
+    pFrame->endBlock = u3vWb_SealedBlocks;
+    pFrame->blocksRejected = false;
+    pFrame->state = U3V_WB_FRAME_OPEN;
+    u3vWb_FrameOpen = true;
+
+    return U3V_WB_RESULT_SUCCESS;
+}
+
+
+T_U3VWriteBehindResult U3VWriteBehind_PushBlock(const void *pData, size_t size)
+{
+    const uint8_t *pSrc = (const uint8_t *)pData;
+    size_t chunkSize;
+
+    if (pData == NULL)
+    {
+        return U3V_WB_RESULT_INVALID_PARAMETER;
+    }
+    if (u3vWb_FrameRejected)
+    {
+        /* block of a frame rejected by U3VWriteBehind_BeginFrame */
+        u3vWb_Stats.blocksRejected++;
+        return U3V_WB_RESULT_NO_SPACE;
+    }
+    if (!u3vWb_FrameOpen)
+    {
+        return U3V_WB_RESULT_INVALID_PARAMETER;
+    }
+    if (!U3VWriteBehind_CanAccept(size))
+    {
+        /* the frame misses this block, it will never be durable */
+        u3vWb_Frames[u3vWb_FrameIdx].blocksRejected = true;
+        u3vWb_Stats.blocksRejected++;
+        return U3V_WB_RESULT_NO_SPACE;
+    }
+
+    /* size fits in uint32_t, it has been checked against the free buffers */
+    u3vWb_Stats.bytesAccepted += (uint32_t)size;
+
+    while (size > 0U)
+    {
+        chunkSize = U3V_WRITE_BEHIND_BUFFER_SIZE - u3vWb_BufferFill[u3vWb_FillIdx];
+        chunkSize = (size < chunkSize) ? size : chunkSize;
+
+        memcpy(&u3vWb_Buffers[u3vWb_FillIdx][u3vWb_BufferFill[u3vWb_FillIdx]], pSrc, chunkSize);
+        u3vWb_BufferFill[u3vWb_FillIdx] += (uint32_t)chunkSize;
+        pSrc += chunkSize;
+        size -= chunkSize;
+
+        if (u3vWb_BufferFill[u3vWb_FillIdx] == U3V_WRITE_BEHIND_BUFFER_SIZE)
+        {
+            U3VWriteBehind_SealBuffer();
+        }
+    }
+
+    return U3V_WB_RESULT_SUCCESS;
+}
+
+
+T_U3VWriteBehindResult U3VWriteBehind_EndFrame(void)
+{
+    T_U3VWbFrame *pFrame = &u3vWb_Frames[u3vWb_FrameIdx];
+
+    if (u3vWb_FrameRejected)
+    {
+        /* end of a frame rejected by U3VWriteBehind_BeginFrame */
+        u3vWb_FrameRejected = false;
+        return U3V_WB_RESULT_NO_SPACE;
+    }
+    if (!u3vWb_FrameOpen)
+    {
+        return U3V_WB_RESULT_INVALID_PARAMETER;
+    }
+
+    U3VWriteBehind_SealBuffer();
+
+    pFrame->endBlock = u3vWb_SealedBlocks;
+    if (pFrame->blocksRejected)
+    {
+        pFrame->state = U3V_WB_FRAME_INCOMPLETE;
+        u3vWb_Stats.framesIncomplete++;
+    }
+    else
+    {
+        pFrame->state = U3V_WB_FRAME_CLOSED;
+    }
+    u3vWb_FrameOpen = false;
+
+    return U3V_WB_RESULT_SUCCESS;
+}
+
+
+bool U3VWriteBehind_CanAccept(size_t size)
+{
+    size_t freeSize = 0U;
+    uint32_t idx = u3vWb_FillIdx;
+
+    /* space is counted on the consecutive free buffers from the one being
+     * filled, as buffers are filled and written in order */
+    for (uint32_t cnt = 0U; cnt < U3V_WRITE_BEHIND_BUFFERS_NUMBER; cnt++)
+    {
+        if (u3vWb_BufferState[idx] != U3V_WB_BUF_FREE)
+        {
+            break;
+        }
+        freeSize += U3V_WRITE_BEHIND_BUFFER_SIZE - u3vWb_BufferFill[idx];
+        if (freeSize >= size)
+        {
+            break;
+        }
+        idx = (idx + 1U) % U3V_WRITE_BEHIND_BUFFERS_NUMBER;
+    }
+
+    return (freeSize >= size);
+}
+
+
+void U3VWriteBehind_Tasks(void)
+{
+    uint32_t blockCount;
+
+    if (u3vWb_Device.write == NULL)
+    {
+        return;
+    }
+
+    while (u3vWb_BufferState[u3vWb_FlushIdx] == U3V_WB_BUF_READY)
+    {
+        blockCount = u3vWb_BufferFill[u3vWb_FlushIdx] / u3vWb_Device.blockSize;
+
+        if (!U3VWriteBehind_WriteBuffer(u3vWb_Buffers[u3vWb_FlushIdx], blockCount))
+        {
+            u3vWb_Stats.writeErrors++;
+            break;
+        }
+
+        u3vWb_WrittenBlocks += blockCount;
+        u3vWb_Stats.blocksWritten += blockCount;
+        u3vWb_BufferFill[u3vWb_FlushIdx] = 0U;
+        u3vWb_BufferState[u3vWb_FlushIdx] = U3V_WB_BUF_FREE;
+        u3vWb_FlushIdx = (u3vWb_FlushIdx + 1U) % U3V_WRITE_BEHIND_BUFFERS_NUMBER;
+    }
+
+    for (uint32_t idx = 0U; idx < U3V_WRITE_BEHIND_FRAMES_NUMBER; idx++)
+    {
+        if ((u3vWb_Frames[idx].state == U3V_WB_FRAME_CLOSED) && U3VWriteBehind_IsBlockWritten(u3vWb_Frames[idx].endBlock))
+        {
+            u3vWb_Frames[idx].state = U3V_WB_FRAME_DURABLE;
+            u3vWb_Stats.framesDurable++;
+        }
+        if ((u3vWb_Frames[idx].state == U3V_WB_FRAME_DURABLE) && U3VWriteBehind_IsFrameOverwritten(&u3vWb_Frames[idx]))
+        {
+            /* the ring has wrapped over the frame blocks */
+            u3vWb_Frames[idx].state = U3V_WB_FRAME_FREE;
+            u3vWb_Stats.framesOverwritten++;
+        }
+    }
+}
+
+
+bool U3VWriteBehind_IsFrameDurable(uint32_t frameId)
+{
+    const T_U3VWbFrame *pFrame = U3VWriteBehind_FindFrame(frameId);
+
+    return ((pFrame != NULL) && U3VWriteBehind_IsDurable(pFrame));
+}
+
+
+T_U3VWriteBehindResult U3VWriteBehind_GetFrameRange(uint32_t frameId, uint32_t *pLba, uint32_t *pBlockCount)
+{
+    const T_U3VWbFrame *pFrame = U3VWriteBehind_FindFrame(frameId);
+
+    if ((pLba == NULL) || (pBlockCount == NULL))
+    {
+        return U3V_WB_RESULT_INVALID_PARAMETER;
+    }
+    if ((pFrame == NULL) || !U3VWriteBehind_IsDurable(pFrame))
+    {
+        return U3V_WB_RESULT_FAILURE;
+    }
+
+    *pLba = u3vWb_Device.firstLba + (pFrame->startBlock % u3vWb_Device.lbaCount);
+    *pBlockCount = pFrame->endBlock - pFrame->startBlock;
+
+    return U3V_WB_RESULT_SUCCESS;
+}
+
+
+void U3VWriteBehind_GetStats(T_U3VWriteBehindStats *pStats)
+{
+    if (pStats != NULL)
+    {
+        *pStats = u3vWb_Stats;
+    }
+}
+
+
+/*******************************************************************************
+* Local function definitions
+*******************************************************************************/
+
+/**
+ * U3V write-behind seal buffer.
+ *
+ * Pads the buffer being filled to the device block size and hands it to the
+ * storage task, filling continues on the next buffer. Empty buffers are not
+ * sealed.
+ */
+static void U3VWriteBehind_SealBuffer(void)
+{
+    uint32_t fill = u3vWb_BufferFill[u3vWb_FillIdx];
+    uint32_t padSize = (u3vWb_Device.blockSize - (fill % u3vWb_Device.blockSize)) % u3vWb_Device.blockSize;
+
+    if ((fill == 0U) || (u3vWb_BufferState[u3vWb_FillIdx] != U3V_WB_BUF_FREE))
+    {
+        /* nothing to seal, or all buffers are waiting to be written */
+        return;
+    }
+
+    memset(&u3vWb_Buffers[u3vWb_FillIdx][fill], 0, padSize);
+    fill += padSize;
+    u3vWb_BufferFill[u3vWb_FillIdx] = fill;
+    u3vWb_SealedBlocks += fill / u3vWb_Device.blockSize;
+    u3vWb_BufferState[u3vWb_FillIdx] = U3V_WB_BUF_READY;
+    u3vWb_FillIdx = (u3vWb_FillIdx + 1U) % U3V_WRITE_BEHIND_BUFFERS_NUMBER;
+}
+
+
+/**
+ * U3V write-behind write buffer.
+ *
+ * Writes a sealed buffer to the device ring, split in two writes when it
+ * crosses the end of the ring.
+ * @param pBuffer
+ * @param blockCount
+ * @return true on success
+ */
+static bool U3VWriteBehind_WriteBuffer(const uint8_t *pBuffer, uint32_t blockCount)
+{
+    uint32_t ringOffset = u3vWb_WrittenBlocks % u3vWb_Device.lbaCount;
+    uint32_t firstCount = u3vWb_Device.lbaCount - ringOffset;
+    bool success;
+
+    firstCount = (blockCount < firstCount) ? blockCount : firstCount;
+
+    /* the device driver may write the buffer with DMA */
+    U3V_DCACHE_CLEAN_BY_ADDR(pBuffer, (size_t)blockCount * u3vWb_Device.blockSize);
+
+    success = u3vWb_Device.write(u3vWb_Device.context, u3vWb_Device.firstLba + ringOffset, pBuffer, firstCount);
+    if (success && (firstCount < blockCount))
+    {
+        success = u3vWb_Device.write(u3vWb_Device.context, u3vWb_Device.firstLba,
+                                     &pBuffer[firstCount * u3vWb_Device.blockSize], blockCount - firstCount);
+    }
+
+    return success;
+}
+
+
+/**
+ * U3V write-behind block written check.
+ *
+ * @param block producer block position
+ * @return true if all blocks before this position have been written
+ * @note Positions are compared modulo 2^32.
+ */
+static inline bool U3VWriteBehind_IsBlockWritten(uint32_t block)
+{
+    return ((int32_t)(u3vWb_WrittenBlocks - block) >= 0);
+}
+
+
+/**
+ * U3V write-behind frame overwritten check.
+ *
+ * @param pFrame
+ * @return true if the ring has wrapped over the first block of the frame
+ * @note Positions are compared modulo 2^32.
+ */
+static inline bool U3VWriteBehind_IsFrameOverwritten(const T_U3VWbFrame *pFrame)
+{
+    return ((u3vWb_WrittenBlocks - pFrame->startBlock) > u3vWb_Device.lbaCount);
+}
+
+
+/**
+ * U3V write-behind frame durable check.
+ *
+ * @param pFrame
+ * @return true if the frame is complete, written and not overwritten yet
+ */
+static bool U3VWriteBehind_IsDurable(const T_U3VWbFrame *pFrame)
+{
+    return (((pFrame->state == U3V_WB_FRAME_CLOSED) || (pFrame->state == U3V_WB_FRAME_DURABLE)) &&
+            U3VWriteBehind_IsBlockWritten(pFrame->endBlock) && !U3VWriteBehind_IsFrameOverwritten(pFrame));
+}
+
+
+/**
+ * U3V write-behind find frame.
+ *
+ * @param frameId
+ * @return the tracked frame with this identifier, NULL if it is not tracked
+ */
+static T_U3VWbFrame *U3VWriteBehind_FindFrame(uint32_t frameId)
+{
+    T_U3VWbFrame *pFrame = NULL;
+
+    for (uint32_t idx = 0U; idx < U3V_WRITE_BEHIND_FRAMES_NUMBER; idx++)
+    {
+        if ((u3vWb_Frames[idx].state != U3V_WB_FRAME_FREE) && (u3vWb_Frames[idx].frameId == frameId))
+        {
+            pFrame = &u3vWb_Frames[idx];
+            break;
+        }
+    }
+
+    return pFrame;
+}